@@ -1,441 +1,441 @@
-BulbasaurBitmasks:  INCLUDE "gfx/pokemon/bulbasaur/bitmask.asm"
-IvysaurBitmasks:    INCLUDE "gfx/pokemon/ivysaur/bitmask.asm"
-VenusaurBitmasks:   INCLUDE "gfx/pokemon/venusaur/bitmask.asm"
-CharmanderBitmasks: INCLUDE "gfx/pokemon/charmander/bitmask.asm"
-CharmeleonBitmasks: INCLUDE "gfx/pokemon/charmeleon/bitmask.asm"
-CharizardBitmasks:  INCLUDE "gfx/pokemon/charizard/bitmask.asm"
-SquirtleBitmasks:   INCLUDE "gfx/pokemon/squirtle/bitmask.asm"
-WartortleBitmasks:  INCLUDE "gfx/pokemon/wartortle/bitmask.asm"
-BlastoiseBitmasks:  INCLUDE "gfx/pokemon/blastoise/bitmask.asm"
-CaterpieBitmasks:   INCLUDE "gfx/pokemon/caterpie/bitmask.asm"
-MetapodBitmasks:    INCLUDE "gfx/pokemon/metapod/bitmask.asm"
-ButterfreeBitmasks: INCLUDE "gfx/pokemon/butterfree/bitmask.asm"
-WeedleBitmasks:     INCLUDE "gfx/pokemon/weedle/bitmask.asm"
-KakunaBitmasks:     INCLUDE "gfx/pokemon/kakuna/bitmask.asm"
-BeedrillBitmasks:   INCLUDE "gfx/pokemon/beedrill/bitmask.asm"
-PidgeyBitmasks:     INCLUDE "gfx/pokemon/pidgey/bitmask.asm"
-PidgeottoBitmasks:  INCLUDE "gfx/pokemon/pidgeotto/bitmask.asm"
-PidgeotBitmasks:    INCLUDE "gfx/pokemon/pidgeot/bitmask.asm"
-SpearowBitmasks:    INCLUDE "gfx/pokemon/spearow/bitmask.asm"
-FearowBitmasks:     INCLUDE "gfx/pokemon/fearow/bitmask.asm"
-EkansBitmasks:      INCLUDE "gfx/pokemon/ekans/bitmask.asm"
-NidoranFBitmasks:   INCLUDE "gfx/pokemon/nidoran_f/bitmask.asm"
-NidorinaBitmasks:   INCLUDE "gfx/pokemon/nidorina/bitmask.asm"
-NidoqueenBitmasks:  INCLUDE "gfx/pokemon/nidoqueen/bitmask.asm"
-NidoranMBitmasks:   INCLUDE "gfx/pokemon/nidoran_m/bitmask.asm"
-NidorinoBitmasks:   INCLUDE "gfx/pokemon/nidorino/bitmask.asm"
-NidokingBitmasks:   INCLUDE "gfx/pokemon/nidoking/bitmask.asm"
-ClefairyBitmasks:   INCLUDE "gfx/pokemon/clefairy/bitmask.asm"
-ClefableBitmasks:   INCLUDE "gfx/pokemon/clefable/bitmask.asm"
-JigglypuffBitmasks: INCLUDE "gfx/pokemon/jigglypuff/bitmask.asm"
-WigglytuffBitmasks: INCLUDE "gfx/pokemon/wigglytuff/bitmask.asm"
-ZubatBitmasks:      INCLUDE "gfx/pokemon/zubat/bitmask.asm"
-GolbatBitmasks:     INCLUDE "gfx/pokemon/golbat/bitmask.asm"
-OddishBitmasks:     INCLUDE "gfx/pokemon/oddish/bitmask.asm"
-GloomBitmasks:      INCLUDE "gfx/pokemon/gloom/bitmask.asm"
-VileplumeBitmasks:  INCLUDE "gfx/pokemon/vileplume/bitmask.asm"
-ParasBitmasks:      INCLUDE "gfx/pokemon/paras/bitmask.asm"
-ParasectBitmasks:   INCLUDE "gfx/pokemon/parasect/bitmask.asm"
-VenonatBitmasks:    INCLUDE "gfx/pokemon/venonat/bitmask.asm"
-VenomothBitmasks:   INCLUDE "gfx/pokemon/venomoth/bitmask.asm"
-PsyduckBitmasks:    INCLUDE "gfx/pokemon/psyduck/bitmask.asm"
-GolduckBitmasks:    INCLUDE "gfx/pokemon/golduck/bitmask.asm"
-MankeyBitmasks:     INCLUDE "gfx/pokemon/mankey/bitmask.asm"
-PrimeapeBitmasks:   INCLUDE "gfx/pokemon/primeape/bitmask.asm"
-PoliwagBitmasks:    INCLUDE "gfx/pokemon/poliwag/bitmask.asm"
-PoliwhirlBitmasks:  INCLUDE "gfx/pokemon/poliwhirl/bitmask.asm"
-PoliwrathBitmasks:  INCLUDE "gfx/pokemon/poliwrath/bitmask.asm"
-AbraBitmasks:       INCLUDE "gfx/pokemon/abra/bitmask.asm"
-KadabraBitmasks:    INCLUDE "gfx/pokemon/kadabra/bitmask.asm"
-AlakazamBitmasks:   INCLUDE "gfx/pokemon/alakazam/bitmask.asm"
-MachopBitmasks:     INCLUDE "gfx/pokemon/machop/bitmask.asm"
-MachokeBitmasks:    INCLUDE "gfx/pokemon/machoke/bitmask.asm"
-MachampBitmasks:    INCLUDE "gfx/pokemon/machamp/bitmask.asm"
-BellsproutBitmasks: INCLUDE "gfx/pokemon/bellsprout/bitmask.asm"
-WeepinbellBitmasks: INCLUDE "gfx/pokemon/weepinbell/bitmask.asm"
-VictreebelBitmasks: INCLUDE "gfx/pokemon/victreebel/bitmask.asm"
-TentacoolBitmasks:  INCLUDE "gfx/pokemon/tentacool/bitmask.asm"
-TentacruelBitmasks: INCLUDE "gfx/pokemon/tentacruel/bitmask.asm"
-MagnemiteBitmasks:  INCLUDE "gfx/pokemon/magnemite/bitmask.asm"
-MagnetonBitmasks:   INCLUDE "gfx/pokemon/magneton/bitmask.asm"
-DoduoBitmasks:      INCLUDE "gfx/pokemon/doduo/bitmask.asm"
-DodrioBitmasks:     INCLUDE "gfx/pokemon/dodrio/bitmask.asm"
-SeelBitmasks:       INCLUDE "gfx/pokemon/seel/bitmask.asm"
-DewgongBitmasks:    INCLUDE "gfx/pokemon/dewgong/bitmask.asm"
-ShellderBitmasks:   INCLUDE "gfx/pokemon/shellder/bitmask.asm"
-CloysterBitmasks:   INCLUDE "gfx/pokemon/cloyster/bitmask.asm"
-GastlyBitmasks:     INCLUDE "gfx/pokemon/gastly/bitmask.asm"
-HaunterBitmasks:    INCLUDE "gfx/pokemon/haunter/bitmask.asm"
-GengarBitmasks:     INCLUDE "gfx/pokemon/gengar/bitmask.asm"
-OnixBitmasks:       INCLUDE "gfx/pokemon/onix/bitmask.asm"
-DrowzeeBitmasks:    INCLUDE "gfx/pokemon/drowzee/bitmask.asm"
-HypnoBitmasks:      INCLUDE "gfx/pokemon/hypno/bitmask.asm"
-KrabbyBitmasks:     INCLUDE "gfx/pokemon/krabby/bitmask.asm"
-KinglerBitmasks:    INCLUDE "gfx/pokemon/kingler/bitmask.asm"
-ExeggcuteBitmasks:  INCLUDE "gfx/pokemon/exeggcute/bitmask.asm"
-CuboneBitmasks:     INCLUDE "gfx/pokemon/cubone/bitmask.asm"
-HitmonleeBitmasks:  INCLUDE "gfx/pokemon/hitmonlee/bitmask.asm"
-HitmonchanBitmasks: INCLUDE "gfx/pokemon/hitmonchan/bitmask.asm"
-LickitungBitmasks:  INCLUDE "gfx/pokemon/lickitung/bitmask.asm"
-KoffingBitmasks:    INCLUDE "gfx/pokemon/koffing/bitmask.asm"
-RhyhornBitmasks:    INCLUDE "gfx/pokemon/rhyhorn/bitmask.asm"
-RhydonBitmasks:     INCLUDE "gfx/pokemon/rhydon/bitmask.asm"
-ChanseyBitmasks:    INCLUDE "gfx/pokemon/chansey/bitmask.asm"
-TangelaBitmasks:    INCLUDE "gfx/pokemon/tangela/bitmask.asm"
-KangaskhanBitmasks: INCLUDE "gfx/pokemon/kangaskhan/bitmask.asm"
-HorseaBitmasks:     INCLUDE "gfx/pokemon/horsea/bitmask.asm"
-SeadraBitmasks:     INCLUDE "gfx/pokemon/seadra/bitmask.asm"
-GoldeenBitmasks:    INCLUDE "gfx/pokemon/goldeen/bitmask.asm"
-SeakingBitmasks:    INCLUDE "gfx/pokemon/seaking/bitmask.asm"
-StaryuBitmasks:     INCLUDE "gfx/pokemon/staryu/bitmask.asm"
-StarmieBitmasks:    INCLUDE "gfx/pokemon/starmie/bitmask.asm"
-ScytherBitmasks:    INCLUDE "gfx/pokemon/scyther/bitmask.asm"
-JynxBitmasks:       INCLUDE "gfx/pokemon/jynx/bitmask.asm"
-ElectabuzzBitmasks: INCLUDE "gfx/pokemon/electabuzz/bitmask.asm"
-MagmarBitmasks:     INCLUDE "gfx/pokemon/magmar/bitmask.asm"
-PinsirBitmasks:     INCLUDE "gfx/pokemon/pinsir/bitmask.asm"
-LaprasBitmasks:     INCLUDE "gfx/pokemon/lapras/bitmask.asm"
-DittoBitmasks:      INCLUDE "gfx/pokemon/ditto/bitmask.asm"
-EeveeBitmasks:      INCLUDE "gfx/pokemon/eevee/bitmask.asm"
-VaporeonBitmasks:   INCLUDE "gfx/pokemon/vaporeon/bitmask.asm"
-JolteonBitmasks:    INCLUDE "gfx/pokemon/jolteon/bitmask.asm"
-FlareonBitmasks:    INCLUDE "gfx/pokemon/flareon/bitmask.asm"
-PorygonBitmasks:    INCLUDE "gfx/pokemon/porygon/bitmask.asm"
-OmanyteBitmasks:    INCLUDE "gfx/pokemon/omanyte/bitmask.asm"
-OmastarBitmasks:    INCLUDE "gfx/pokemon/omastar/bitmask.asm"
-KabutoBitmasks:     INCLUDE "gfx/pokemon/kabuto/bitmask.asm"
-KabutopsBitmasks:   INCLUDE "gfx/pokemon/kabutops/bitmask.asm"
-AerodactylBitmasks: INCLUDE "gfx/pokemon/aerodactyl/bitmask.asm"
-SnorlaxBitmasks:    INCLUDE "gfx/pokemon/snorlax/bitmask.asm"
-DratiniBitmasks:    INCLUDE "gfx/pokemon/dratini/bitmask.asm"
-DragonairBitmasks:  INCLUDE "gfx/pokemon/dragonair/bitmask.asm"
-DragoniteBitmasks:  INCLUDE "gfx/pokemon/dragonite/bitmask.asm"
-MewBitmasks:        INCLUDE "gfx/pokemon/mew/bitmask.asm"
-ChikoritaBitmasks:  INCLUDE "gfx/pokemon/chikorita/bitmask.asm"
-BayleefBitmasks:    INCLUDE "gfx/pokemon/bayleef/bitmask.asm"
-MeganiumBitmasks:   INCLUDE "gfx/pokemon/meganium/bitmask.asm"
-CyndaquilBitmasks:  INCLUDE "gfx/pokemon/cyndaquil/bitmask.asm"
-QuilavaBitmasks:    INCLUDE "gfx/pokemon/quilava/bitmask.asm"
-TotodileBitmasks:   INCLUDE "gfx/pokemon/totodile/bitmask.asm"
-CroconawBitmasks:   INCLUDE "gfx/pokemon/croconaw/bitmask.asm"
-FeraligatrBitmasks: INCLUDE "gfx/pokemon/feraligatr/bitmask.asm"
-SentretBitmasks:    INCLUDE "gfx/pokemon/sentret/bitmask.asm"
-FurretBitmasks:     INCLUDE "gfx/pokemon/furret/bitmask.asm"
-HoothootBitmasks:   INCLUDE "gfx/pokemon/hoothoot/bitmask.asm"
-NoctowlBitmasks:    INCLUDE "gfx/pokemon/noctowl/bitmask.asm"
-LedybaBitmasks:     INCLUDE "gfx/pokemon/ledyba/bitmask.asm"
-LedianBitmasks:     INCLUDE "gfx/pokemon/ledian/bitmask.asm"
-SpinarakBitmasks:   INCLUDE "gfx/pokemon/spinarak/bitmask.asm"
-AriadosBitmasks:    INCLUDE "gfx/pokemon/ariados/bitmask.asm"
-CrobatBitmasks:     INCLUDE "gfx/pokemon/crobat/bitmask.asm"
-ChinchouBitmasks:   INCLUDE "gfx/pokemon/chinchou/bitmask.asm"
-LanturnBitmasks:    INCLUDE "gfx/pokemon/lanturn/bitmask.asm"
-CleffaBitmasks:     INCLUDE "gfx/pokemon/cleffa/bitmask.asm"
-IgglybuffBitmasks:  INCLUDE "gfx/pokemon/igglybuff/bitmask.asm"
-TogepiBitmasks:     INCLUDE "gfx/pokemon/togepi/bitmask.asm"
-TogeticBitmasks:    INCLUDE "gfx/pokemon/togetic/bitmask.asm"
-NatuBitmasks:       INCLUDE "gfx/pokemon/natu/bitmask.asm"
-XatuBitmasks:       INCLUDE "gfx/pokemon/xatu/bitmask.asm"
-MareepBitmasks:     INCLUDE "gfx/pokemon/mareep/bitmask.asm"
-FlaaffyBitmasks:    INCLUDE "gfx/pokemon/flaaffy/bitmask.asm"
-AmpharosBitmasks:   INCLUDE "gfx/pokemon/ampharos/bitmask.asm"
-BellossomBitmasks:  INCLUDE "gfx/pokemon/bellossom/bitmask.asm"
-SudowoodoBitmasks:  INCLUDE "gfx/pokemon/sudowoodo/bitmask.asm"
-MarillBitmasks:     INCLUDE "gfx/pokemon/marill/bitmask.asm"
-AzumarillBitmasks:  INCLUDE "gfx/pokemon/azumarill/bitmask.asm"
-PolitoedBitmasks:   INCLUDE "gfx/pokemon/politoed/bitmask.asm"
-HoppipBitmasks:     INCLUDE "gfx/pokemon/hoppip/bitmask.asm"
-SkiploomBitmasks:   INCLUDE "gfx/pokemon/skiploom/bitmask.asm"
-JumpluffBitmasks:   INCLUDE "gfx/pokemon/jumpluff/bitmask.asm"
-AipomBitmasks:      INCLUDE "gfx/pokemon/aipom/bitmask.asm"
-SunkernBitmasks:    INCLUDE "gfx/pokemon/sunkern/bitmask.asm"
-SunfloraBitmasks:   INCLUDE "gfx/pokemon/sunflora/bitmask.asm"
-YanmaBitmasks:      INCLUDE "gfx/pokemon/yanma/bitmask.asm"
-QuagsireBitmasks:   INCLUDE "gfx/pokemon/quagsire/bitmask.asm"
-EspeonBitmasks:     INCLUDE "gfx/pokemon/espeon/bitmask.asm"
-UmbreonBitmasks:    INCLUDE "gfx/pokemon/umbreon/bitmask.asm"
-MurkrowBitmasks:    INCLUDE "gfx/pokemon/murkrow/bitmask.asm"
-MisdreavusBitmasks: INCLUDE "gfx/pokemon/misdreavus/bitmask.asm"
-WobbuffetBitmasks:  INCLUDE "gfx/pokemon/wobbuffet/bitmask.asm"
-GirafarigBitmasks:  INCLUDE "gfx/pokemon/girafarig/bitmask.asm"
-PinecoBitmasks:     INCLUDE "gfx/pokemon/pineco/bitmask.asm"
-ForretressBitmasks: INCLUDE "gfx/pokemon/forretress/bitmask.asm"
-DunsparceBitmasks:  INCLUDE "gfx/pokemon/dunsparce/bitmask.asm"
-GligarBitmasks:     INCLUDE "gfx/pokemon/gligar/bitmask.asm"
-SteelixBitmasks:    INCLUDE "gfx/pokemon/steelix/bitmask.asm"
-SnubbullBitmasks:   INCLUDE "gfx/pokemon/snubbull/bitmask.asm"
-GranbullBitmasks:   INCLUDE "gfx/pokemon/granbull/bitmask.asm"
-ScizorBitmasks:     INCLUDE "gfx/pokemon/scizor/bitmask.asm"
-ShuckleBitmasks:    INCLUDE "gfx/pokemon/shuckle/bitmask.asm"
-HeracrossBitmasks:  INCLUDE "gfx/pokemon/heracross/bitmask.asm"
-TeddiursaBitmasks:  INCLUDE "gfx/pokemon/teddiursa/bitmask.asm"
-UrsaringBitmasks:   INCLUDE "gfx/pokemon/ursaring/bitmask.asm"
-SlugmaBitmasks:     INCLUDE "gfx/pokemon/slugma/bitmask.asm"
-MagcargoBitmasks:   INCLUDE "gfx/pokemon/magcargo/bitmask.asm"
-SwinubBitmasks:     INCLUDE "gfx/pokemon/swinub/bitmask.asm"
-PiloswineBitmasks:  INCLUDE "gfx/pokemon/piloswine/bitmask.asm"
-RemoraidBitmasks:   INCLUDE "gfx/pokemon/remoraid/bitmask.asm"
-OctilleryBitmasks:  INCLUDE "gfx/pokemon/octillery/bitmask.asm"
-DelibirdBitmasks:   INCLUDE "gfx/pokemon/delibird/bitmask.asm"
-MantineBitmasks:    INCLUDE "gfx/pokemon/mantine/bitmask.asm"
-SkarmoryBitmasks:   INCLUDE "gfx/pokemon/skarmory/bitmask.asm"
-HoundourBitmasks:   INCLUDE "gfx/pokemon/houndour/bitmask.asm"
-HoundoomBitmasks:   INCLUDE "gfx/pokemon/houndoom/bitmask.asm"
-KingdraBitmasks:    INCLUDE "gfx/pokemon/kingdra/bitmask.asm"
-PhanpyBitmasks:     INCLUDE "gfx/pokemon/phanpy/bitmask.asm"
-DonphanBitmasks:    INCLUDE "gfx/pokemon/donphan/bitmask.asm"
-Porygon2Bitmasks:   INCLUDE "gfx/pokemon/porygon2/bitmask.asm"
-StantlerBitmasks:   INCLUDE "gfx/pokemon/stantler/bitmask.asm"
-SmeargleBitmasks:   INCLUDE "gfx/pokemon/smeargle/bitmask.asm"
-TyrogueBitmasks:    INCLUDE "gfx/pokemon/tyrogue/bitmask.asm"
-HitmontopBitmasks:  INCLUDE "gfx/pokemon/hitmontop/bitmask.asm"
-SmoochumBitmasks:   INCLUDE "gfx/pokemon/smoochum/bitmask.asm"
-ElekidBitmasks:     INCLUDE "gfx/pokemon/elekid/bitmask.asm"
-MagbyBitmasks:      INCLUDE "gfx/pokemon/magby/bitmask.asm"
-MiltankBitmasks:    INCLUDE "gfx/pokemon/miltank/bitmask.asm"
-BlisseyBitmasks:    INCLUDE "gfx/pokemon/blissey/bitmask.asm"
-RaikouBitmasks:     INCLUDE "gfx/pokemon/raikou/bitmask.asm"
-EnteiBitmasks:      INCLUDE "gfx/pokemon/entei/bitmask.asm"
-SuicuneBitmasks:    INCLUDE "gfx/pokemon/suicune/bitmask.asm"
-LarvitarBitmasks:   INCLUDE "gfx/pokemon/larvitar/bitmask.asm"
-PupitarBitmasks:    INCLUDE "gfx/pokemon/pupitar/bitmask.asm"
-TyranitarBitmasks:  INCLUDE "gfx/pokemon/tyranitar/bitmask.asm"
-LugiaBitmasks:      INCLUDE "gfx/pokemon/lugia/bitmask.asm"
-HoOhBitmasks:       INCLUDE "gfx/pokemon/ho_oh/bitmask.asm"
-CelebiBitmasks:     INCLUDE "gfx/pokemon/celebi/bitmask.asm"
-AzurillBitmasks:    INCLUDE "gfx/pokemon/azurill/bitmask.asm"
-WynautBitmasks:     INCLUDE "gfx/pokemon/wynaut/bitmask.asm"
-AmbipomBitmasks:    INCLUDE "gfx/pokemon/ambipom/bitmask.asm"
-MismagiusBitmasks:  INCLUDE "gfx/pokemon/mismagius/bitmask.asm"
-HonchkrowBitmasks:  INCLUDE "gfx/pokemon/honchkrow/bitmask.asm"
-BonslyBitmasks:     INCLUDE "gfx/pokemon/bonsly/bitmask.asm"
-MimeJrBitmasks:     INCLUDE "gfx/pokemon/mime_jr_/bitmask.asm"
-HappinyBitmasks:    INCLUDE "gfx/pokemon/happiny/bitmask.asm"
-MunchlaxBitmasks:   INCLUDE "gfx/pokemon/munchlax/bitmask.asm"
-MantykeBitmasks:    INCLUDE "gfx/pokemon/mantyke/bitmask.asm"
-WeavileBitmasks:    INCLUDE "gfx/pokemon/weavile/bitmask.asm"
-MagnezoneBitmasks:  INCLUDE "gfx/pokemon/magnezone/bitmask.asm"
-LickilickyBitmasks: INCLUDE "gfx/pokemon/lickilicky/bitmask.asm"
-RhyperiorBitmasks:  INCLUDE "gfx/pokemon/rhyperior/bitmask.asm"
-TangrowthBitmasks:  INCLUDE "gfx/pokemon/tangrowth/bitmask.asm"
-ElectivireBitmasks: INCLUDE "gfx/pokemon/electivire/bitmask.asm"
-MagmortarBitmasks:  INCLUDE "gfx/pokemon/magmortar/bitmask.asm"
-TogekissBitmasks:   INCLUDE "gfx/pokemon/togekiss/bitmask.asm"
-YanmegaBitmasks:    INCLUDE "gfx/pokemon/yanmega/bitmask.asm"
-LeafeonBitmasks:    INCLUDE "gfx/pokemon/leafeon/bitmask.asm"
-GlaceonBitmasks:    INCLUDE "gfx/pokemon/glaceon/bitmask.asm"
-GliscorBitmasks:    INCLUDE "gfx/pokemon/gliscor/bitmask.asm"
-MamoswineBitmasks:  INCLUDE "gfx/pokemon/mamoswine/bitmask.asm"
-PorygonZBitmasks:   INCLUDE "gfx/pokemon/porygon_z/bitmask.asm"
-SylveonBitmasks:    INCLUDE "gfx/pokemon/sylveon/bitmask.asm"
-PerrserkerBitmasks: INCLUDE "gfx/pokemon/perrserker/bitmask.asm"
-CursolaBitmasks:    INCLUDE "gfx/pokemon/cursola/bitmask.asm"
-SirfetchDBitmasks:  INCLUDE "gfx/pokemon/sirfetch_d/bitmask.asm"
-MrRimeBitmasks:     INCLUDE "gfx/pokemon/mr__rime/bitmask.asm"
-WyrdeerBitmasks:    INCLUDE "gfx/pokemon/wyrdeer/bitmask.asm"
-KleavorBitmasks:    INCLUDE "gfx/pokemon/kleavor/bitmask.asm"
-SneaslerBitmasks:   INCLUDE "gfx/pokemon/sneasler/bitmask.asm"
-OverqwilBitmasks:   INCLUDE "gfx/pokemon/overqwil/bitmask.asm"
-FarigirafBitmasks:  INCLUDE "gfx/pokemon/farigiraf/bitmask.asm"
-ClodsireBitmasks:   INCLUDE "gfx/pokemon/clodsire/bitmask.asm"
-AnnihilapeBitmasks: INCLUDE "gfx/pokemon/annihilape/bitmask.asm"
-
-EggBitmasks:        INCLUDE "gfx/pokemon/egg/bitmask.asm"
-
-UnownABitmasks: INCLUDE "gfx/pokemon/unown_a/bitmask.asm"
-UnownBBitmasks: INCLUDE "gfx/pokemon/unown_b/bitmask.asm"
-UnownCBitmasks: INCLUDE "gfx/pokemon/unown_c/bitmask.asm"
-UnownDBitmasks: INCLUDE "gfx/pokemon/unown_d/bitmask.asm"
-UnownEBitmasks: INCLUDE "gfx/pokemon/unown_e/bitmask.asm"
-UnownFBitmasks: INCLUDE "gfx/pokemon/unown_f/bitmask.asm"
-UnownGBitmasks: INCLUDE "gfx/pokemon/unown_g/bitmask.asm"
-UnownHBitmasks: INCLUDE "gfx/pokemon/unown_h/bitmask.asm"
-UnownIBitmasks: INCLUDE "gfx/pokemon/unown_i/bitmask.asm"
-UnownJBitmasks: INCLUDE "gfx/pokemon/unown_j/bitmask.asm"
-UnownKBitmasks: INCLUDE "gfx/pokemon/unown_k/bitmask.asm"
-UnownLBitmasks: INCLUDE "gfx/pokemon/unown_l/bitmask.asm"
-UnownMBitmasks: INCLUDE "gfx/pokemon/unown_m/bitmask.asm"
-UnownNBitmasks: INCLUDE "gfx/pokemon/unown_n/bitmask.asm"
-UnownOBitmasks: INCLUDE "gfx/pokemon/unown_o/bitmask.asm"
-UnownPBitmasks: INCLUDE "gfx/pokemon/unown_p/bitmask.asm"
-UnownQBitmasks: INCLUDE "gfx/pokemon/unown_q/bitmask.asm"
-UnownRBitmasks: INCLUDE "gfx/pokemon/unown_r/bitmask.asm"
-UnownSBitmasks: INCLUDE "gfx/pokemon/unown_s/bitmask.asm"
-UnownTBitmasks: INCLUDE "gfx/pokemon/unown_t/bitmask.asm"
-UnownUBitmasks: INCLUDE "gfx/pokemon/unown_u/bitmask.asm"
-UnownVBitmasks: INCLUDE "gfx/pokemon/unown_v/bitmask.asm"
-UnownWBitmasks: INCLUDE "gfx/pokemon/unown_w/bitmask.asm"
-UnownXBitmasks: INCLUDE "gfx/pokemon/unown_x/bitmask.asm"
-UnownYBitmasks: INCLUDE "gfx/pokemon/unown_y/bitmask.asm"
-UnownZBitmasks: INCLUDE "gfx/pokemon/unown_z/bitmask.asm"
-UnownExclamationBitmasks: INCLUDE "gfx/pokemon/unown_exclamation/bitmask.asm"
-UnownQuestionBitmasks:    INCLUDE "gfx/pokemon/unown_question/bitmask.asm"
-
-PichuPlainBitmasks: INCLUDE "gfx/pokemon/pichu_plain/bitmask.asm"
-PichuSpikyBitmasks: INCLUDE "gfx/pokemon/pichu_spiky/bitmask.asm"
-
-PikachuPlainBitmasks:  INCLUDE "gfx/pokemon/pikachu_plain/bitmask.asm"
-PikachuFlyBitmasks:    INCLUDE "gfx/pokemon/pikachu_fly/bitmask.asm"
-PikachuSurfBitmasks:   INCLUDE "gfx/pokemon/pikachu_surf/bitmask.asm"
-PikachuPikaBitmasks:   INCLUDE "gfx/pokemon/pikachu_pika/bitmask.asm"
-PikachuChuchuBitmasks: INCLUDE "gfx/pokemon/pikachu_chuchu/bitmask.asm"
-PikachuSparkBitmasks:  INCLUDE "gfx/pokemon/pikachu_spark/bitmask.asm"
-
-ArbokJohtoBitmasks:  INCLUDE "gfx/pokemon/arbok_johto/bitmask.asm"
-ArbokKantoBitmasks:  INCLUDE "gfx/pokemon/arbok_kanto/bitmask.asm"
-ArbokKogaBitmasks:   INCLUDE "gfx/pokemon/arbok_koga/bitmask.asm"
-ArbokAgathaBitmasks: INCLUDE "gfx/pokemon/arbok_agatha/bitmask.asm"
-ArbokArianaBitmasks: INCLUDE "gfx/pokemon/arbok_ariana/bitmask.asm"
-
-MagikarpPlainBitmasks:     INCLUDE "gfx/pokemon/magikarp_plain/bitmask.asm"
-MagikarpSkellyBitmasks:    INCLUDE "gfx/pokemon/magikarp_skelly/bitmask.asm"
-MagikarpCalico1Bitmasks:   INCLUDE "gfx/pokemon/magikarp_calico1/bitmask.asm"
-MagikarpCalico2Bitmasks:   INCLUDE "gfx/pokemon/magikarp_calico2/bitmask.asm"
-MagikarpCalico3Bitmasks:   INCLUDE "gfx/pokemon/magikarp_calico3/bitmask.asm"
-MagikarpTwoToneBitmasks:   INCLUDE "gfx/pokemon/magikarp_twotone/bitmask.asm"
-MagikarpOrcaBitmasks:      INCLUDE "gfx/pokemon/magikarp_orca/bitmask.asm"
-MagikarpDapplesBitmasks:   INCLUDE "gfx/pokemon/magikarp_dapples/bitmask.asm"
-MagikarpTigerBitmasks:     INCLUDE "gfx/pokemon/magikarp_tiger/bitmask.asm"
-MagikarpZebraBitmasks:     INCLUDE "gfx/pokemon/magikarp_zebra/bitmask.asm"
-MagikarpStripeBitmasks:    INCLUDE "gfx/pokemon/magikarp_stripe/bitmask.asm"
-MagikarpBubblesBitmasks:   INCLUDE "gfx/pokemon/magikarp_bubbles/bitmask.asm"
-MagikarpDiamondsBitmasks:  INCLUDE "gfx/pokemon/magikarp_diamonds/bitmask.asm"
-MagikarpPatchesBitmasks:   INCLUDE "gfx/pokemon/magikarp_patches/bitmask.asm"
-MagikarpForehead1Bitmasks: INCLUDE "gfx/pokemon/magikarp_forehead1/bitmask.asm"
-MagikarpMask1Bitmasks:     INCLUDE "gfx/pokemon/magikarp_mask1/bitmask.asm"
-MagikarpForehead2Bitmasks: INCLUDE "gfx/pokemon/magikarp_forehead2/bitmask.asm"
-MagikarpMask2Bitmasks:     INCLUDE "gfx/pokemon/magikarp_mask2/bitmask.asm"
-MagikarpSaucyBitmasks:     INCLUDE "gfx/pokemon/magikarp_saucy/bitmask.asm"
-MagikarpRaindropBitmasks:  INCLUDE "gfx/pokemon/magikarp_raindrop/bitmask.asm"
-
-DudunsparceTwoSegmentBitmasks:   INCLUDE "gfx/pokemon/dudunsparce_two_segment/bitmask.asm"
-DudunsparceThreeSegmentBitmasks: INCLUDE "gfx/pokemon/dudunsparce_three_segment/bitmask.asm"
-
-GyaradosPlainBitmasks: INCLUDE "gfx/pokemon/gyarados_plain/bitmask.asm"
-GyaradosRedBitmasks:   INCLUDE "gfx/pokemon/gyarados_red/bitmask.asm"
-
-MewtwoPlainBitmasks:   INCLUDE "gfx/pokemon/mewtwo_plain/bitmask.asm"
-MewtwoArmoredBitmasks: INCLUDE "gfx/pokemon/mewtwo_armored/bitmask.asm"
-
-RattataPlainBitmasks:  INCLUDE "gfx/pokemon/rattata_plain/bitmask.asm"
-RattataAlolanBitmasks: INCLUDE "gfx/pokemon/rattata_alolan/bitmask.asm"
-
-RaticatePlainBitmasks:  INCLUDE "gfx/pokemon/raticate_plain/bitmask.asm"
-RaticateAlolanBitmasks: INCLUDE "gfx/pokemon/raticate_alolan/bitmask.asm"
-
-RaichuPlainBitmasks:  INCLUDE "gfx/pokemon/raichu_plain/bitmask.asm"
-RaichuAlolanBitmasks: INCLUDE "gfx/pokemon/raichu_alolan/bitmask.asm"
-
-SandshrewPlainBitmasks:  INCLUDE "gfx/pokemon/sandshrew_plain/bitmask.asm"
-SandshrewAlolanBitmasks: INCLUDE "gfx/pokemon/sandshrew_alolan/bitmask.asm"
-
-SandslashPlainBitmasks:  INCLUDE "gfx/pokemon/sandslash_plain/bitmask.asm"
-SandslashAlolanBitmasks: INCLUDE "gfx/pokemon/sandslash_alolan/bitmask.asm"
-
-VulpixPlainBitmasks:  INCLUDE "gfx/pokemon/vulpix_plain/bitmask.asm"
-VulpixAlolanBitmasks: INCLUDE "gfx/pokemon/vulpix_alolan/bitmask.asm"
-
-NinetalesPlainBitmasks:  INCLUDE "gfx/pokemon/ninetales_plain/bitmask.asm"
-NinetalesAlolanBitmasks: INCLUDE "gfx/pokemon/ninetales_alolan/bitmask.asm"
-
-DiglettPlainBitmasks:  INCLUDE "gfx/pokemon/diglett_plain/bitmask.asm"
-DiglettAlolanBitmasks: INCLUDE "gfx/pokemon/diglett_alolan/bitmask.asm"
-
-DugtrioPlainBitmasks:  INCLUDE "gfx/pokemon/dugtrio_plain/bitmask.asm"
-DugtrioAlolanBitmasks: INCLUDE "gfx/pokemon/dugtrio_alolan/bitmask.asm"
-
-MeowthPlainBitmasks:    INCLUDE "gfx/pokemon/meowth_plain/bitmask.asm"
-MeowthAlolanBitmasks:   INCLUDE "gfx/pokemon/meowth_alolan/bitmask.asm"
-MeowthGalarianBitmasks: INCLUDE "gfx/pokemon/meowth_galarian/bitmask.asm"
-
-PersianPlainBitmasks:  INCLUDE "gfx/pokemon/persian_plain/bitmask.asm"
-PersianAlolanBitmasks: INCLUDE "gfx/pokemon/persian_alolan/bitmask.asm"
+BulbasaurBitmasks:  INCBIN "gfx/pokemon/bulbasaur/bitmask.bin"
+IvysaurBitmasks:    INCBIN "gfx/pokemon/ivysaur/bitmask.bin"
+VenusaurBitmasks:   INCBIN "gfx/pokemon/venusaur/bitmask.bin"
+CharmanderBitmasks: INCBIN "gfx/pokemon/charmander/bitmask.bin"
+CharmeleonBitmasks: INCBIN "gfx/pokemon/charmeleon/bitmask.bin"
+CharizardBitmasks:  INCBIN "gfx/pokemon/charizard/bitmask.bin"
+SquirtleBitmasks:   INCBIN "gfx/pokemon/squirtle/bitmask.bin"
+WartortleBitmasks:  INCBIN "gfx/pokemon/wartortle/bitmask.bin"
+BlastoiseBitmasks:  INCBIN "gfx/pokemon/blastoise/bitmask.bin"
+CaterpieBitmasks:   INCBIN "gfx/pokemon/caterpie/bitmask.bin"
+MetapodBitmasks:    INCBIN "gfx/pokemon/metapod/bitmask.bin"
+ButterfreeBitmasks: INCBIN "gfx/pokemon/butterfree/bitmask.bin"
+WeedleBitmasks:     INCBIN "gfx/pokemon/weedle/bitmask.bin"
+KakunaBitmasks:     INCBIN "gfx/pokemon/kakuna/bitmask.bin"
+BeedrillBitmasks:   INCBIN "gfx/pokemon/beedrill/bitmask.bin"
+PidgeyBitmasks:     INCBIN "gfx/pokemon/pidgey/bitmask.bin"
+PidgeottoBitmasks:  INCBIN "gfx/pokemon/pidgeotto/bitmask.bin"
+PidgeotBitmasks:    INCBIN "gfx/pokemon/pidgeot/bitmask.bin"
+SpearowBitmasks:    INCBIN "gfx/pokemon/spearow/bitmask.bin"
+FearowBitmasks:     INCBIN "gfx/pokemon/fearow/bitmask.bin"
+EkansBitmasks:      INCBIN "gfx/pokemon/ekans/bitmask.bin"
+NidoranFBitmasks:   INCBIN "gfx/pokemon/nidoran_f/bitmask.bin"
+NidorinaBitmasks:   INCBIN "gfx/pokemon/nidorina/bitmask.bin"
+NidoqueenBitmasks:  INCBIN "gfx/pokemon/nidoqueen/bitmask.bin"
+NidoranMBitmasks:   INCBIN "gfx/pokemon/nidoran_m/bitmask.bin"
+NidorinoBitmasks:   INCBIN "gfx/pokemon/nidorino/bitmask.bin"
+NidokingBitmasks:   INCBIN "gfx/pokemon/nidoking/bitmask.bin"
+ClefairyBitmasks:   INCBIN "gfx/pokemon/clefairy/bitmask.bin"
+ClefableBitmasks:   INCBIN "gfx/pokemon/clefable/bitmask.bin"
+JigglypuffBitmasks: INCBIN "gfx/pokemon/jigglypuff/bitmask.bin"
+WigglytuffBitmasks: INCBIN "gfx/pokemon/wigglytuff/bitmask.bin"
+ZubatBitmasks:      INCBIN "gfx/pokemon/zubat/bitmask.bin"
+GolbatBitmasks:     INCBIN "gfx/pokemon/golbat/bitmask.bin"
+OddishBitmasks:     INCBIN "gfx/pokemon/oddish/bitmask.bin"
+GloomBitmasks:      INCBIN "gfx/pokemon/gloom/bitmask.bin"
+VileplumeBitmasks:  INCBIN "gfx/pokemon/vileplume/bitmask.bin"
+ParasBitmasks:      INCBIN "gfx/pokemon/paras/bitmask.bin"
+ParasectBitmasks:   INCBIN "gfx/pokemon/parasect/bitmask.bin"
+VenonatBitmasks:    INCBIN "gfx/pokemon/venonat/bitmask.bin"
+VenomothBitmasks:   INCBIN "gfx/pokemon/venomoth/bitmask.bin"
+PsyduckBitmasks:    INCBIN "gfx/pokemon/psyduck/bitmask.bin"
+GolduckBitmasks:    INCBIN "gfx/pokemon/golduck/bitmask.bin"
+MankeyBitmasks:     INCBIN "gfx/pokemon/mankey/bitmask.bin"
+PrimeapeBitmasks:   INCBIN "gfx/pokemon/primeape/bitmask.bin"
+PoliwagBitmasks:    INCBIN "gfx/pokemon/poliwag/bitmask.bin"
+PoliwhirlBitmasks:  INCBIN "gfx/pokemon/poliwhirl/bitmask.bin"
+PoliwrathBitmasks:  INCBIN "gfx/pokemon/poliwrath/bitmask.bin"
+AbraBitmasks:       INCBIN "gfx/pokemon/abra/bitmask.bin"
+KadabraBitmasks:    INCBIN "gfx/pokemon/kadabra/bitmask.bin"
+AlakazamBitmasks:   INCBIN "gfx/pokemon/alakazam/bitmask.bin"
+MachopBitmasks:     INCBIN "gfx/pokemon/machop/bitmask.bin"
+MachokeBitmasks:    INCBIN "gfx/pokemon/machoke/bitmask.bin"
+MachampBitmasks:    INCBIN "gfx/pokemon/machamp/bitmask.bin"
+BellsproutBitmasks: INCBIN "gfx/pokemon/bellsprout/bitmask.bin"
+WeepinbellBitmasks: INCBIN "gfx/pokemon/weepinbell/bitmask.bin"
+VictreebelBitmasks: INCBIN "gfx/pokemon/victreebel/bitmask.bin"
+TentacoolBitmasks:  INCBIN "gfx/pokemon/tentacool/bitmask.bin"
+TentacruelBitmasks: INCBIN "gfx/pokemon/tentacruel/bitmask.bin"
+MagnemiteBitmasks:  INCBIN "gfx/pokemon/magnemite/bitmask.bin"
+MagnetonBitmasks:   INCBIN "gfx/pokemon/magneton/bitmask.bin"
+DoduoBitmasks:      INCBIN "gfx/pokemon/doduo/bitmask.bin"
+DodrioBitmasks:     INCBIN "gfx/pokemon/dodrio/bitmask.bin"
+SeelBitmasks:       INCBIN "gfx/pokemon/seel/bitmask.bin"
+DewgongBitmasks:    INCBIN "gfx/pokemon/dewgong/bitmask.bin"
+ShellderBitmasks:   INCBIN "gfx/pokemon/shellder/bitmask.bin"
+CloysterBitmasks:   INCBIN "gfx/pokemon/cloyster/bitmask.bin"
+GastlyBitmasks:     INCBIN "gfx/pokemon/gastly/bitmask.bin"
+HaunterBitmasks:    INCBIN "gfx/pokemon/haunter/bitmask.bin"
+GengarBitmasks:     INCBIN "gfx/pokemon/gengar/bitmask.bin"
+OnixBitmasks:       INCBIN "gfx/pokemon/onix/bitmask.bin"
+DrowzeeBitmasks:    INCBIN "gfx/pokemon/drowzee/bitmask.bin"
+HypnoBitmasks:      INCBIN "gfx/pokemon/hypno/bitmask.bin"
+KrabbyBitmasks:     INCBIN "gfx/pokemon/krabby/bitmask.bin"
+KinglerBitmasks:    INCBIN "gfx/pokemon/kingler/bitmask.bin"
+ExeggcuteBitmasks:  INCBIN "gfx/pokemon/exeggcute/bitmask.bin"
+CuboneBitmasks:     INCBIN "gfx/pokemon/cubone/bitmask.bin"
+HitmonleeBitmasks:  INCBIN "gfx/pokemon/hitmonlee/bitmask.bin"
+HitmonchanBitmasks: INCBIN "gfx/pokemon/hitmonchan/bitmask.bin"
+LickitungBitmasks:  INCBIN "gfx/pokemon/lickitung/bitmask.bin"
+KoffingBitmasks:    INCBIN "gfx/pokemon/koffing/bitmask.bin"
+RhyhornBitmasks:    INCBIN "gfx/pokemon/rhyhorn/bitmask.bin"
+RhydonBitmasks:     INCBIN "gfx/pokemon/rhydon/bitmask.bin"
+ChanseyBitmasks:    INCBIN "gfx/pokemon/chansey/bitmask.bin"
+TangelaBitmasks:    INCBIN "gfx/pokemon/tangela/bitmask.bin"
+KangaskhanBitmasks: INCBIN "gfx/pokemon/kangaskhan/bitmask.bin"
+HorseaBitmasks:     INCBIN "gfx/pokemon/horsea/bitmask.bin"
+SeadraBitmasks:     INCBIN "gfx/pokemon/seadra/bitmask.bin"
+GoldeenBitmasks:    INCBIN "gfx/pokemon/goldeen/bitmask.bin"
+SeakingBitmasks:    INCBIN "gfx/pokemon/seaking/bitmask.bin"
+StaryuBitmasks:     INCBIN "gfx/pokemon/staryu/bitmask.bin"
+StarmieBitmasks:    INCBIN "gfx/pokemon/starmie/bitmask.bin"
+ScytherBitmasks:    INCBIN "gfx/pokemon/scyther/bitmask.bin"
+JynxBitmasks:       INCBIN "gfx/pokemon/jynx/bitmask.bin"
+ElectabuzzBitmasks: INCBIN "gfx/pokemon/electabuzz/bitmask.bin"
+MagmarBitmasks:     INCBIN "gfx/pokemon/magmar/bitmask.bin"
+PinsirBitmasks:     INCBIN "gfx/pokemon/pinsir/bitmask.bin"
+LaprasBitmasks:     INCBIN "gfx/pokemon/lapras/bitmask.bin"
+DittoBitmasks:      INCBIN "gfx/pokemon/ditto/bitmask.bin"
+EeveeBitmasks:      INCBIN "gfx/pokemon/eevee/bitmask.bin"
+VaporeonBitmasks:   INCBIN "gfx/pokemon/vaporeon/bitmask.bin"
+JolteonBitmasks:    INCBIN "gfx/pokemon/jolteon/bitmask.bin"
+FlareonBitmasks:    INCBIN "gfx/pokemon/flareon/bitmask.bin"
+PorygonBitmasks:    INCBIN "gfx/pokemon/porygon/bitmask.bin"
+OmanyteBitmasks:    INCBIN "gfx/pokemon/omanyte/bitmask.bin"
+OmastarBitmasks:    INCBIN "gfx/pokemon/omastar/bitmask.bin"
+KabutoBitmasks:     INCBIN "gfx/pokemon/kabuto/bitmask.bin"
+KabutopsBitmasks:   INCBIN "gfx/pokemon/kabutops/bitmask.bin"
+AerodactylBitmasks: INCBIN "gfx/pokemon/aerodactyl/bitmask.bin"
+SnorlaxBitmasks:    INCBIN "gfx/pokemon/snorlax/bitmask.bin"
+DratiniBitmasks:    INCBIN "gfx/pokemon/dratini/bitmask.bin"
+DragonairBitmasks:  INCBIN "gfx/pokemon/dragonair/bitmask.bin"
+DragoniteBitmasks:  INCBIN "gfx/pokemon/dragonite/bitmask.bin"
+MewBitmasks:        INCBIN "gfx/pokemon/mew/bitmask.bin"
+ChikoritaBitmasks:  INCBIN "gfx/pokemon/chikorita/bitmask.bin"
+BayleefBitmasks:    INCBIN "gfx/pokemon/bayleef/bitmask.bin"
+MeganiumBitmasks:   INCBIN "gfx/pokemon/meganium/bitmask.bin"
+CyndaquilBitmasks:  INCBIN "gfx/pokemon/cyndaquil/bitmask.bin"
+QuilavaBitmasks:    INCBIN "gfx/pokemon/quilava/bitmask.bin"
+TotodileBitmasks:   INCBIN "gfx/pokemon/totodile/bitmask.bin"
+CroconawBitmasks:   INCBIN "gfx/pokemon/croconaw/bitmask.bin"
+FeraligatrBitmasks: INCBIN "gfx/pokemon/feraligatr/bitmask.bin"
+SentretBitmasks:    INCBIN "gfx/pokemon/sentret/bitmask.bin"
+FurretBitmasks:     INCBIN "gfx/pokemon/furret/bitmask.bin"
+HoothootBitmasks:   INCBIN "gfx/pokemon/hoothoot/bitmask.bin"
+NoctowlBitmasks:    INCBIN "gfx/pokemon/noctowl/bitmask.bin"
+LedybaBitmasks:     INCBIN "gfx/pokemon/ledyba/bitmask.bin"
+LedianBitmasks:     INCBIN "gfx/pokemon/ledian/bitmask.bin"
+SpinarakBitmasks:   INCBIN "gfx/pokemon/spinarak/bitmask.bin"
+AriadosBitmasks:    INCBIN "gfx/pokemon/ariados/bitmask.bin"
+CrobatBitmasks:     INCBIN "gfx/pokemon/crobat/bitmask.bin"
+ChinchouBitmasks:   INCBIN "gfx/pokemon/chinchou/bitmask.bin"
+LanturnBitmasks:    INCBIN "gfx/pokemon/lanturn/bitmask.bin"
+CleffaBitmasks:     INCBIN "gfx/pokemon/cleffa/bitmask.bin"
+IgglybuffBitmasks:  INCBIN "gfx/pokemon/igglybuff/bitmask.bin"
+TogepiBitmasks:     INCBIN "gfx/pokemon/togepi/bitmask.bin"
+TogeticBitmasks:    INCBIN "gfx/pokemon/togetic/bitmask.bin"
+NatuBitmasks:       INCBIN "gfx/pokemon/natu/bitmask.bin"
+XatuBitmasks:       INCBIN "gfx/pokemon/xatu/bitmask.bin"
+MareepBitmasks:     INCBIN "gfx/pokemon/mareep/bitmask.bin"
+FlaaffyBitmasks:    INCBIN "gfx/pokemon/flaaffy/bitmask.bin"
+AmpharosBitmasks:   INCBIN "gfx/pokemon/ampharos/bitmask.bin"
+BellossomBitmasks:  INCBIN "gfx/pokemon/bellossom/bitmask.bin"
+SudowoodoBitmasks:  INCBIN "gfx/pokemon/sudowoodo/bitmask.bin"
+MarillBitmasks:     INCBIN "gfx/pokemon/marill/bitmask.bin"
+AzumarillBitmasks:  INCBIN "gfx/pokemon/azumarill/bitmask.bin"
+PolitoedBitmasks:   INCBIN "gfx/pokemon/politoed/bitmask.bin"
+HoppipBitmasks:     INCBIN "gfx/pokemon/hoppip/bitmask.bin"
+SkiploomBitmasks:   INCBIN "gfx/pokemon/skiploom/bitmask.bin"
+JumpluffBitmasks:   INCBIN "gfx/pokemon/jumpluff/bitmask.bin"
+AipomBitmasks:      INCBIN "gfx/pokemon/aipom/bitmask.bin"
+SunkernBitmasks:    INCBIN "gfx/pokemon/sunkern/bitmask.bin"
+SunfloraBitmasks:   INCBIN "gfx/pokemon/sunflora/bitmask.bin"
+YanmaBitmasks:      INCBIN "gfx/pokemon/yanma/bitmask.bin"
+QuagsireBitmasks:   INCBIN "gfx/pokemon/quagsire/bitmask.bin"
+EspeonBitmasks:     INCBIN "gfx/pokemon/espeon/bitmask.bin"
+UmbreonBitmasks:    INCBIN "gfx/pokemon/umbreon/bitmask.bin"
+MurkrowBitmasks:    INCBIN "gfx/pokemon/murkrow/bitmask.bin"
+MisdreavusBitmasks: INCBIN "gfx/pokemon/misdreavus/bitmask.bin"
+WobbuffetBitmasks:  INCBIN "gfx/pokemon/wobbuffet/bitmask.bin"
+GirafarigBitmasks:  INCBIN "gfx/pokemon/girafarig/bitmask.bin"
+PinecoBitmasks:     INCBIN "gfx/pokemon/pineco/bitmask.bin"
+ForretressBitmasks: INCBIN "gfx/pokemon/forretress/bitmask.bin"
+DunsparceBitmasks:  INCBIN "gfx/pokemon/dunsparce/bitmask.bin"
+GligarBitmasks:     INCBIN "gfx/pokemon/gligar/bitmask.bin"
+SteelixBitmasks:    INCBIN "gfx/pokemon/steelix/bitmask.bin"
+SnubbullBitmasks:   INCBIN "gfx/pokemon/snubbull/bitmask.bin"
+GranbullBitmasks:   INCBIN "gfx/pokemon/granbull/bitmask.bin"
+ScizorBitmasks:     INCBIN "gfx/pokemon/scizor/bitmask.bin"
+ShuckleBitmasks:    INCBIN "gfx/pokemon/shuckle/bitmask.bin"
+HeracrossBitmasks:  INCBIN "gfx/pokemon/heracross/bitmask.bin"
+TeddiursaBitmasks:  INCBIN "gfx/pokemon/teddiursa/bitmask.bin"
+UrsaringBitmasks:   INCBIN "gfx/pokemon/ursaring/bitmask.bin"
+SlugmaBitmasks:     INCBIN "gfx/pokemon/slugma/bitmask.bin"
+MagcargoBitmasks:   INCBIN "gfx/pokemon/magcargo/bitmask.bin"
+SwinubBitmasks:     INCBIN "gfx/pokemon/swinub/bitmask.bin"
+PiloswineBitmasks:  INCBIN "gfx/pokemon/piloswine/bitmask.bin"
+RemoraidBitmasks:   INCBIN "gfx/pokemon/remoraid/bitmask.bin"
+OctilleryBitmasks:  INCBIN "gfx/pokemon/octillery/bitmask.bin"
+DelibirdBitmasks:   INCBIN "gfx/pokemon/delibird/bitmask.bin"
+MantineBitmasks:    INCBIN "gfx/pokemon/mantine/bitmask.bin"
+SkarmoryBitmasks:   INCBIN "gfx/pokemon/skarmory/bitmask.bin"
+HoundourBitmasks:   INCBIN "gfx/pokemon/houndour/bitmask.bin"
+HoundoomBitmasks:   INCBIN "gfx/pokemon/houndoom/bitmask.bin"
+KingdraBitmasks:    INCBIN "gfx/pokemon/kingdra/bitmask.bin"
+PhanpyBitmasks:     INCBIN "gfx/pokemon/phanpy/bitmask.bin"
+DonphanBitmasks:    INCBIN "gfx/pokemon/donphan/bitmask.bin"
+Porygon2Bitmasks:   INCBIN "gfx/pokemon/porygon2/bitmask.bin"
+StantlerBitmasks:   INCBIN "gfx/pokemon/stantler/bitmask.bin"
+SmeargleBitmasks:   INCBIN "gfx/pokemon/smeargle/bitmask.bin"
+TyrogueBitmasks:    INCBIN "gfx/pokemon/tyrogue/bitmask.bin"
+HitmontopBitmasks:  INCBIN "gfx/pokemon/hitmontop/bitmask.bin"
+SmoochumBitmasks:   INCBIN "gfx/pokemon/smoochum/bitmask.bin"
+ElekidBitmasks:     INCBIN "gfx/pokemon/elekid/bitmask.bin"
+MagbyBitmasks:      INCBIN "gfx/pokemon/magby/bitmask.bin"
+MiltankBitmasks:    INCBIN "gfx/pokemon/miltank/bitmask.bin"
+BlisseyBitmasks:    INCBIN "gfx/pokemon/blissey/bitmask.bin"
+RaikouBitmasks:     INCBIN "gfx/pokemon/raikou/bitmask.bin"
+EnteiBitmasks:      INCBIN "gfx/pokemon/entei/bitmask.bin"
+SuicuneBitmasks:    INCBIN "gfx/pokemon/suicune/bitmask.bin"
+LarvitarBitmasks:   INCBIN "gfx/pokemon/larvitar/bitmask.bin"
+PupitarBitmasks:    INCBIN "gfx/pokemon/pupitar/bitmask.bin"
+TyranitarBitmasks:  INCBIN "gfx/pokemon/tyranitar/bitmask.bin"
+LugiaBitmasks:      INCBIN "gfx/pokemon/lugia/bitmask.bin"
+HoOhBitmasks:       INCBIN "gfx/pokemon/ho_oh/bitmask.bin"
+CelebiBitmasks:     INCBIN "gfx/pokemon/celebi/bitmask.bin"
+AzurillBitmasks:    INCBIN "gfx/pokemon/azurill/bitmask.bin"
+WynautBitmasks:     INCBIN "gfx/pokemon/wynaut/bitmask.bin"
+AmbipomBitmasks:    INCBIN "gfx/pokemon/ambipom/bitmask.bin"
+MismagiusBitmasks:  INCBIN "gfx/pokemon/mismagius/bitmask.bin"
+HonchkrowBitmasks:  INCBIN "gfx/pokemon/honchkrow/bitmask.bin"
+BonslyBitmasks:     INCBIN "gfx/pokemon/bonsly/bitmask.bin"
+MimeJrBitmasks:     INCBIN "gfx/pokemon/mime_jr_/bitmask.bin"
+HappinyBitmasks:    INCBIN "gfx/pokemon/happiny/bitmask.bin"
+MunchlaxBitmasks:   INCBIN "gfx/pokemon/munchlax/bitmask.bin"
+MantykeBitmasks:    INCBIN "gfx/pokemon/mantyke/bitmask.bin"
+WeavileBitmasks:    INCBIN "gfx/pokemon/weavile/bitmask.bin"
+MagnezoneBitmasks:  INCBIN "gfx/pokemon/magnezone/bitmask.bin"
+LickilickyBitmasks: INCBIN "gfx/pokemon/lickilicky/bitmask.bin"
+RhyperiorBitmasks:  INCBIN "gfx/pokemon/rhyperior/bitmask.bin"
+TangrowthBitmasks:  INCBIN "gfx/pokemon/tangrowth/bitmask.bin"
+ElectivireBitmasks: INCBIN "gfx/pokemon/electivire/bitmask.bin"
+MagmortarBitmasks:  INCBIN "gfx/pokemon/magmortar/bitmask.bin"
+TogekissBitmasks:   INCBIN "gfx/pokemon/togekiss/bitmask.bin"
+YanmegaBitmasks:    INCBIN "gfx/pokemon/yanmega/bitmask.bin"
+LeafeonBitmasks:    INCBIN "gfx/pokemon/leafeon/bitmask.bin"
+GlaceonBitmasks:    INCBIN "gfx/pokemon/glaceon/bitmask.bin"
+GliscorBitmasks:    INCBIN "gfx/pokemon/gliscor/bitmask.bin"
+MamoswineBitmasks:  INCBIN "gfx/pokemon/mamoswine/bitmask.bin"
+PorygonZBitmasks:   INCBIN "gfx/pokemon/porygon_z/bitmask.bin"
+SylveonBitmasks:    INCBIN "gfx/pokemon/sylveon/bitmask.bin"
+PerrserkerBitmasks: INCBIN "gfx/pokemon/perrserker/bitmask.bin"
+CursolaBitmasks:    INCBIN "gfx/pokemon/cursola/bitmask.bin"
+SirfetchDBitmasks:  INCBIN "gfx/pokemon/sirfetch_d/bitmask.bin"
+MrRimeBitmasks:     INCBIN "gfx/pokemon/mr__rime/bitmask.bin"
+WyrdeerBitmasks:    INCBIN "gfx/pokemon/wyrdeer/bitmask.bin"
+KleavorBitmasks:    INCBIN "gfx/pokemon/kleavor/bitmask.bin"
+SneaslerBitmasks:   INCBIN "gfx/pokemon/sneasler/bitmask.bin"
+OverqwilBitmasks:   INCBIN "gfx/pokemon/overqwil/bitmask.bin"
+FarigirafBitmasks:  INCBIN "gfx/pokemon/farigiraf/bitmask.bin"
+ClodsireBitmasks:   INCBIN "gfx/pokemon/clodsire/bitmask.bin"
+AnnihilapeBitmasks: INCBIN "gfx/pokemon/annihilape/bitmask.bin"
+
+EggBitmasks:        INCBIN "gfx/pokemon/egg/bitmask.bin"
+
+UnownABitmasks: INCBIN "gfx/pokemon/unown_a/bitmask.bin"
+UnownBBitmasks: INCBIN "gfx/pokemon/unown_b/bitmask.bin"
+UnownCBitmasks: INCBIN "gfx/pokemon/unown_c/bitmask.bin"
+UnownDBitmasks: INCBIN "gfx/pokemon/unown_d/bitmask.bin"
+UnownEBitmasks: INCBIN "gfx/pokemon/unown_e/bitmask.bin"
+UnownFBitmasks: INCBIN "gfx/pokemon/unown_f/bitmask.bin"
+UnownGBitmasks: INCBIN "gfx/pokemon/unown_g/bitmask.bin"
+UnownHBitmasks: INCBIN "gfx/pokemon/unown_h/bitmask.bin"
+UnownIBitmasks: INCBIN "gfx/pokemon/unown_i/bitmask.bin"
+UnownJBitmasks: INCBIN "gfx/pokemon/unown_j/bitmask.bin"
+UnownKBitmasks: INCBIN "gfx/pokemon/unown_k/bitmask.bin"
+UnownLBitmasks: INCBIN "gfx/pokemon/unown_l/bitmask.bin"
+UnownMBitmasks: INCBIN "gfx/pokemon/unown_m/bitmask.bin"
+UnownNBitmasks: INCBIN "gfx/pokemon/unown_n/bitmask.bin"
+UnownOBitmasks: INCBIN "gfx/pokemon/unown_o/bitmask.bin"
+UnownPBitmasks: INCBIN "gfx/pokemon/unown_p/bitmask.bin"
+UnownQBitmasks: INCBIN "gfx/pokemon/unown_q/bitmask.bin"
+UnownRBitmasks: INCBIN "gfx/pokemon/unown_r/bitmask.bin"
+UnownSBitmasks: INCBIN "gfx/pokemon/unown_s/bitmask.bin"
+UnownTBitmasks: INCBIN "gfx/pokemon/unown_t/bitmask.bin"
+UnownUBitmasks: INCBIN "gfx/pokemon/unown_u/bitmask.bin"
+UnownVBitmasks: INCBIN "gfx/pokemon/unown_v/bitmask.bin"
+UnownWBitmasks: INCBIN "gfx/pokemon/unown_w/bitmask.bin"
+UnownXBitmasks: INCBIN "gfx/pokemon/unown_x/bitmask.bin"
+UnownYBitmasks: INCBIN "gfx/pokemon/unown_y/bitmask.bin"
+UnownZBitmasks: INCBIN "gfx/pokemon/unown_z/bitmask.bin"
+UnownExclamationBitmasks: INCBIN "gfx/pokemon/unown_exclamation/bitmask.bin"
+UnownQuestionBitmasks:    INCBIN "gfx/pokemon/unown_question/bitmask.bin"
+
+PichuPlainBitmasks: INCBIN "gfx/pokemon/pichu_plain/bitmask.bin"
+PichuSpikyBitmasks: INCBIN "gfx/pokemon/pichu_spiky/bitmask.bin"
+
+PikachuPlainBitmasks:  INCBIN "gfx/pokemon/pikachu_plain/bitmask.bin"
+PikachuFlyBitmasks:    INCBIN "gfx/pokemon/pikachu_fly/bitmask.bin"
+PikachuSurfBitmasks:   INCBIN "gfx/pokemon/pikachu_surf/bitmask.bin"
+PikachuPikaBitmasks:   INCBIN "gfx/pokemon/pikachu_pika/bitmask.bin"
+PikachuChuchuBitmasks: INCBIN "gfx/pokemon/pikachu_chuchu/bitmask.bin"
+PikachuSparkBitmasks:  INCBIN "gfx/pokemon/pikachu_spark/bitmask.bin"
+
+ArbokJohtoBitmasks:  INCBIN "gfx/pokemon/arbok_johto/bitmask.bin"
+ArbokKantoBitmasks:  INCBIN "gfx/pokemon/arbok_kanto/bitmask.bin"
+ArbokKogaBitmasks:   INCBIN "gfx/pokemon/arbok_koga/bitmask.bin"
+ArbokAgathaBitmasks: INCBIN "gfx/pokemon/arbok_agatha/bitmask.bin"
+ArbokArianaBitmasks: INCBIN "gfx/pokemon/arbok_ariana/bitmask.bin"
+
+MagikarpPlainBitmasks:     INCBIN "gfx/pokemon/magikarp_plain/bitmask.bin"
+MagikarpSkellyBitmasks:    INCBIN "gfx/pokemon/magikarp_skelly/bitmask.bin"
+MagikarpCalico1Bitmasks:   INCBIN "gfx/pokemon/magikarp_calico1/bitmask.bin"
+MagikarpCalico2Bitmasks:   INCBIN "gfx/pokemon/magikarp_calico2/bitmask.bin"
+MagikarpCalico3Bitmasks:   INCBIN "gfx/pokemon/magikarp_calico3/bitmask.bin"
+MagikarpTwoToneBitmasks:   INCBIN "gfx/pokemon/magikarp_twotone/bitmask.bin"
+MagikarpOrcaBitmasks:      INCBIN "gfx/pokemon/magikarp_orca/bitmask.bin"
+MagikarpDapplesBitmasks:   INCBIN "gfx/pokemon/magikarp_dapples/bitmask.bin"
+MagikarpTigerBitmasks:     INCBIN "gfx/pokemon/magikarp_tiger/bitmask.bin"
+MagikarpZebraBitmasks:     INCBIN "gfx/pokemon/magikarp_zebra/bitmask.bin"
+MagikarpStripeBitmasks:    INCBIN "gfx/pokemon/magikarp_stripe/bitmask.bin"
+MagikarpBubblesBitmasks:   INCBIN "gfx/pokemon/magikarp_bubbles/bitmask.bin"
+MagikarpDiamondsBitmasks:  INCBIN "gfx/pokemon/magikarp_diamonds/bitmask.bin"
+MagikarpPatchesBitmasks:   INCBIN "gfx/pokemon/magikarp_patches/bitmask.bin"
+MagikarpForehead1Bitmasks: INCBIN "gfx/pokemon/magikarp_forehead1/bitmask.bin"
+MagikarpMask1Bitmasks:     INCBIN "gfx/pokemon/magikarp_mask1/bitmask.bin"
+MagikarpForehead2Bitmasks: INCBIN "gfx/pokemon/magikarp_forehead2/bitmask.bin"
+MagikarpMask2Bitmasks:     INCBIN "gfx/pokemon/magikarp_mask2/bitmask.bin"
+MagikarpSaucyBitmasks:     INCBIN "gfx/pokemon/magikarp_saucy/bitmask.bin"
+MagikarpRaindropBitmasks:  INCBIN "gfx/pokemon/magikarp_raindrop/bitmask.bin"
+
+DudunsparceTwoSegmentBitmasks:   INCBIN "gfx/pokemon/dudunsparce_two_segment/bitmask.bin"
+DudunsparceThreeSegmentBitmasks: INCBIN "gfx/pokemon/dudunsparce_three_segment/bitmask.bin"
+
+GyaradosPlainBitmasks: INCBIN "gfx/pokemon/gyarados_plain/bitmask.bin"
+GyaradosRedBitmasks:   INCBIN "gfx/pokemon/gyarados_red/bitmask.bin"
+
+MewtwoPlainBitmasks:   INCBIN "gfx/pokemon/mewtwo_plain/bitmask.bin"
+MewtwoArmoredBitmasks: INCBIN "gfx/pokemon/mewtwo_armored/bitmask.bin"
+
+RattataPlainBitmasks:  INCBIN "gfx/pokemon/rattata_plain/bitmask.bin"
+RattataAlolanBitmasks: INCBIN "gfx/pokemon/rattata_alolan/bitmask.bin"
+
+RaticatePlainBitmasks:  INCBIN "gfx/pokemon/raticate_plain/bitmask.bin"
+RaticateAlolanBitmasks: INCBIN "gfx/pokemon/raticate_alolan/bitmask.bin"
+
+RaichuPlainBitmasks:  INCBIN "gfx/pokemon/raichu_plain/bitmask.bin"
+RaichuAlolanBitmasks: INCBIN "gfx/pokemon/raichu_alolan/bitmask.bin"
+
+SandshrewPlainBitmasks:  INCBIN "gfx/pokemon/sandshrew_plain/bitmask.bin"
+SandshrewAlolanBitmasks: INCBIN "gfx/pokemon/sandshrew_alolan/bitmask.bin"
+
+SandslashPlainBitmasks:  INCBIN "gfx/pokemon/sandslash_plain/bitmask.bin"
+SandslashAlolanBitmasks: INCBIN "gfx/pokemon/sandslash_alolan/bitmask.bin"
+
+VulpixPlainBitmasks:  INCBIN "gfx/pokemon/vulpix_plain/bitmask.bin"
+VulpixAlolanBitmasks: INCBIN "gfx/pokemon/vulpix_alolan/bitmask.bin"
+
+NinetalesPlainBitmasks:  INCBIN "gfx/pokemon/ninetales_plain/bitmask.bin"
+NinetalesAlolanBitmasks: INCBIN "gfx/pokemon/ninetales_alolan/bitmask.bin"
+
+DiglettPlainBitmasks:  INCBIN "gfx/pokemon/diglett_plain/bitmask.bin"
+DiglettAlolanBitmasks: INCBIN "gfx/pokemon/diglett_alolan/bitmask.bin"
+
+DugtrioPlainBitmasks:  INCBIN "gfx/pokemon/dugtrio_plain/bitmask.bin"
+DugtrioAlolanBitmasks: INCBIN "gfx/pokemon/dugtrio_alolan/bitmask.bin"
+
+MeowthPlainBitmasks:    INCBIN "gfx/pokemon/meowth_plain/bitmask.bin"
+MeowthAlolanBitmasks:   INCBIN "gfx/pokemon/meowth_alolan/bitmask.bin"
+MeowthGalarianBitmasks: INCBIN "gfx/pokemon/meowth_galarian/bitmask.bin"
+
+PersianPlainBitmasks:  INCBIN "gfx/pokemon/persian_plain/bitmask.bin"
+PersianAlolanBitmasks: INCBIN "gfx/pokemon/persian_alolan/bitmask.bin"
 
-GeodudePlainBitmasks:  INCLUDE "gfx/pokemon/geodude_plain/bitmask.asm"
-GeodudeAlolanBitmasks: INCLUDE "gfx/pokemon/geodude_alolan/bitmask.asm"
+GeodudePlainBitmasks:  INCBIN "gfx/pokemon/geodude_plain/bitmask.bin"
+GeodudeAlolanBitmasks: INCBIN "gfx/pokemon/geodude_alolan/bitmask.bin"
 
-GravelerPlainBitmasks:  INCLUDE "gfx/pokemon/graveler_plain/bitmask.asm"
-GravelerAlolanBitmasks: INCLUDE "gfx/pokemon/graveler_alolan/bitmask.asm"
+GravelerPlainBitmasks:  INCBIN "gfx/pokemon/graveler_plain/bitmask.bin"
+GravelerAlolanBitmasks: INCBIN "gfx/pokemon/graveler_alolan/bitmask.bin"
 
-GolemPlainBitmasks:  INCLUDE "gfx/pokemon/golem_plain/bitmask.asm"
-GolemAlolanBitmasks: INCLUDE "gfx/pokemon/golem_alolan/bitmask.asm"
+GolemPlainBitmasks:  INCBIN "gfx/pokemon/golem_plain/bitmask.bin"
+GolemAlolanBitmasks: INCBIN "gfx/pokemon/golem_alolan/bitmask.bin"
 
-GrimerPlainBitmasks:  INCLUDE "gfx/pokemon/grimer_plain/bitmask.asm"
-GrimerAlolanBitmasks: INCLUDE "gfx/pokemon/grimer_alolan/bitmask.asm"
+GrimerPlainBitmasks:  INCBIN "gfx/pokemon/grimer_plain/bitmask.bin"
+GrimerAlolanBitmasks: INCBIN "gfx/pokemon/grimer_alolan/bitmask.bin"
 
-MukPlainBitmasks:  INCLUDE "gfx/pokemon/muk_plain/bitmask.asm"
-MukAlolanBitmasks: INCLUDE "gfx/pokemon/muk_alolan/bitmask.asm"
+MukPlainBitmasks:  INCBIN "gfx/pokemon/muk_plain/bitmask.bin"
+MukAlolanBitmasks: INCBIN "gfx/pokemon/muk_alolan/bitmask.bin"
 
-ExeggutorPlainBitmasks:  INCLUDE "gfx/pokemon/exeggutor_plain/bitmask.asm"
-ExeggutorAlolanBitmasks: INCLUDE "gfx/pokemon/exeggutor_alolan/bitmask.asm"
+ExeggutorPlainBitmasks:  INCBIN "gfx/pokemon/exeggutor_plain/bitmask.bin"
+ExeggutorAlolanBitmasks: INCBIN "gfx/pokemon/exeggutor_alolan/bitmask.bin"
 
-MarowakPlainBitmasks:  INCLUDE "gfx/pokemon/marowak_plain/bitmask.asm"
-MarowakAlolanBitmasks: INCLUDE "gfx/pokemon/marowak_alolan/bitmask.asm"
+MarowakPlainBitmasks:  INCBIN "gfx/pokemon/marowak_plain/bitmask.bin"
+MarowakAlolanBitmasks: INCBIN "gfx/pokemon/marowak_alolan/bitmask.bin"
 
-PonytaPlainBitmasks:    INCLUDE "gfx/pokemon/ponyta_plain/bitmask.asm"
-PonytaGalarianBitmasks: INCLUDE "gfx/pokemon/ponyta_galarian/bitmask.asm"
+PonytaPlainBitmasks:    INCBIN "gfx/pokemon/ponyta_plain/bitmask.bin"
+PonytaGalarianBitmasks: INCBIN "gfx/pokemon/ponyta_galarian/bitmask.bin"
 
-RapidashPlainBitmasks:    INCLUDE "gfx/pokemon/rapidash_plain/bitmask.asm"
-RapidashGalarianBitmasks: INCLUDE "gfx/pokemon/rapidash_galarian/bitmask.asm"
+RapidashPlainBitmasks:    INCBIN "gfx/pokemon/rapidash_plain/bitmask.bin"
+RapidashGalarianBitmasks: INCBIN "gfx/pokemon/rapidash_galarian/bitmask.bin"
 
-SlowpokePlainBitmasks:   INCLUDE "gfx/pokemon/slowpoke_plain/bitmask.asm"
-SlowpokeGalarianBitmasks: INCLUDE "gfx/pokemon/slowpoke_galarian/bitmask.asm"
+SlowpokePlainBitmasks:   INCBIN "gfx/pokemon/slowpoke_plain/bitmask.bin"
+SlowpokeGalarianBitmasks: INCBIN "gfx/pokemon/slowpoke_galarian/bitmask.bin"
 
-SlowbroPlainBitmasks:    INCLUDE "gfx/pokemon/slowbro_plain/bitmask.asm"
-SlowbroGalarianBitmasks: INCLUDE "gfx/pokemon/slowbro_galarian/bitmask.asm"
+SlowbroPlainBitmasks:    INCBIN "gfx/pokemon/slowbro_plain/bitmask.bin"
+SlowbroGalarianBitmasks: INCBIN "gfx/pokemon/slowbro_galarian/bitmask.bin"
 
-FarfetchDPlainBitmasks:     INCLUDE "gfx/pokemon/farfetch_d_plain/bitmask.asm"
-FarfetchDGalarianBitmasks:  INCLUDE "gfx/pokemon/farfetch_d_galarian/bitmask.asm"
+FarfetchDPlainBitmasks:     INCBIN "gfx/pokemon/farfetch_d_plain/bitmask.bin"
+FarfetchDGalarianBitmasks:  INCBIN "gfx/pokemon/farfetch_d_galarian/bitmask.bin"
 
-WeezingPlainBitmasks:    INCLUDE "gfx/pokemon/weezing_plain/bitmask.asm"
-WeezingGalarianBitmasks: INCLUDE "gfx/pokemon/weezing_galarian/bitmask.asm"
+WeezingPlainBitmasks:    INCBIN "gfx/pokemon/weezing_plain/bitmask.bin"
+WeezingGalarianBitmasks: INCBIN "gfx/pokemon/weezing_galarian/bitmask.bin"
 
-MrMimePlainBitmasks:    INCLUDE "gfx/pokemon/mr__mime_plain/bitmask.asm"
-MrMimeGalarianBitmasks: INCLUDE "gfx/pokemon/mr__mime_galarian/bitmask.asm"
+MrMimePlainBitmasks:    INCBIN "gfx/pokemon/mr__mime_plain/bitmask.bin"
+MrMimeGalarianBitmasks: INCBIN "gfx/pokemon/mr__mime_galarian/bitmask.bin"
 
-ArticunoPlainBitmasks:    INCLUDE "gfx/pokemon/articuno_plain/bitmask.asm"
-ArticunoGalarianBitmasks: INCLUDE "gfx/pokemon/articuno_galarian/bitmask.asm"
+ArticunoPlainBitmasks:    INCBIN "gfx/pokemon/articuno_plain/bitmask.bin"
+ArticunoGalarianBitmasks: INCBIN "gfx/pokemon/articuno_galarian/bitmask.bin"
 
-ZapdosPlainBitmasks:    INCLUDE "gfx/pokemon/zapdos_plain/bitmask.asm"
-ZapdosGalarianBitmasks: INCLUDE "gfx/pokemon/zapdos_galarian/bitmask.asm"
+ZapdosPlainBitmasks:    INCBIN "gfx/pokemon/zapdos_plain/bitmask.bin"
+ZapdosGalarianBitmasks: INCBIN "gfx/pokemon/zapdos_galarian/bitmask.bin"
 
-MoltresPlainBitmasks:    INCLUDE "gfx/pokemon/moltres_plain/bitmask.asm"
-MoltresGalarianBitmasks: INCLUDE "gfx/pokemon/moltres_galarian/bitmask.asm"
+MoltresPlainBitmasks:    INCBIN "gfx/pokemon/moltres_plain/bitmask.bin"
+MoltresGalarianBitmasks: INCBIN "gfx/pokemon/moltres_galarian/bitmask.bin"
 
-SlowkingPlainBitmasks:    INCLUDE "gfx/pokemon/slowking_plain/bitmask.asm"
-SlowkingGalarianBitmasks: INCLUDE "gfx/pokemon/slowking_galarian/bitmask.asm"
+SlowkingPlainBitmasks:    INCBIN "gfx/pokemon/slowking_plain/bitmask.bin"
+SlowkingGalarianBitmasks: INCBIN "gfx/pokemon/slowking_galarian/bitmask.bin"
 
-CorsolaPlainBitmasks:    INCLUDE "gfx/pokemon/corsola_plain/bitmask.asm"
-CorsolaGalarianBitmasks: INCLUDE "gfx/pokemon/corsola_galarian/bitmask.asm"
+CorsolaPlainBitmasks:    INCBIN "gfx/pokemon/corsola_plain/bitmask.bin"
+CorsolaGalarianBitmasks: INCBIN "gfx/pokemon/corsola_galarian/bitmask.bin"
 
-GrowlithePlainBitmasks:   INCLUDE "gfx/pokemon/growlithe_plain/bitmask.asm"
-GrowlitheHisuianBitmasks: INCLUDE "gfx/pokemon/growlithe_hisuian/bitmask.asm"
+GrowlithePlainBitmasks:   INCBIN "gfx/pokemon/growlithe_plain/bitmask.bin"
+GrowlitheHisuianBitmasks: INCBIN "gfx/pokemon/growlithe_hisuian/bitmask.bin"
 
-ArcaninePlainBitmasks:   INCLUDE "gfx/pokemon/arcanine_plain/bitmask.asm"
-ArcanineHisuianBitmasks: INCLUDE "gfx/pokemon/arcanine_hisuian/bitmask.asm"
+ArcaninePlainBitmasks:   INCBIN "gfx/pokemon/arcanine_plain/bitmask.bin"
+ArcanineHisuianBitmasks: INCBIN "gfx/pokemon/arcanine_hisuian/bitmask.bin"
 
-VoltorbPlainBitmasks:   INCLUDE "gfx/pokemon/voltorb_plain/bitmask.asm"
-VoltorbHisuianBitmasks: INCLUDE "gfx/pokemon/voltorb_hisuian/bitmask.asm"
+VoltorbPlainBitmasks:   INCBIN "gfx/pokemon/voltorb_plain/bitmask.bin"
+VoltorbHisuianBitmasks: INCBIN "gfx/pokemon/voltorb_hisuian/bitmask.bin"
 
-ElectrodePlainBitmasks:   INCLUDE "gfx/pokemon/electrode_plain/bitmask.asm"
-ElectrodeHisuianBitmasks: INCLUDE "gfx/pokemon/electrode_hisuian/bitmask.asm"
+ElectrodePlainBitmasks:   INCBIN "gfx/pokemon/electrode_plain/bitmask.bin"
+ElectrodeHisuianBitmasks: INCBIN "gfx/pokemon/electrode_hisuian/bitmask.bin"
 
-TyphlosionPlainBitmasks:   INCLUDE "gfx/pokemon/typhlosion_plain/bitmask.asm"
-TyphlosionHisuianBitmasks: INCLUDE "gfx/pokemon/typhlosion_hisuian/bitmask.asm"
+TyphlosionPlainBitmasks:   INCBIN "gfx/pokemon/typhlosion_plain/bitmask.bin"
+TyphlosionHisuianBitmasks: INCBIN "gfx/pokemon/typhlosion_hisuian/bitmask.bin"
 
-QwilfishPlainBitmasks:   INCLUDE "gfx/pokemon/qwilfish_plain/bitmask.asm"
-QwilfishHisuianBitmasks: INCLUDE "gfx/pokemon/qwilfish_hisuian/bitmask.asm"
+QwilfishPlainBitmasks:   INCBIN "gfx/pokemon/qwilfish_plain/bitmask.bin"
+QwilfishHisuianBitmasks: INCBIN "gfx/pokemon/qwilfish_hisuian/bitmask.bin"
 
-SneaselPlainBitmasks:   INCLUDE "gfx/pokemon/sneasel_plain/bitmask.asm"
-SneaselHisuianBitmasks: INCLUDE "gfx/pokemon/sneasel_hisuian/bitmask.asm"
+SneaselPlainBitmasks:   INCBIN "gfx/pokemon/sneasel_plain/bitmask.bin"
+SneaselHisuianBitmasks: INCBIN "gfx/pokemon/sneasel_hisuian/bitmask.bin"
 
-WooperPlainBitmasks:    INCLUDE "gfx/pokemon/wooper_plain/bitmask.asm"
-WooperPaldeanBitmasks:  INCLUDE "gfx/pokemon/wooper_paldean/bitmask.asm"
+WooperPlainBitmasks:    INCBIN "gfx/pokemon/wooper_plain/bitmask.bin"
+WooperPaldeanBitmasks:  INCBIN "gfx/pokemon/wooper_paldean/bitmask.bin"
 
-TaurosPlainBitmasks:        INCLUDE "gfx/pokemon/tauros_plain/bitmask.asm"
-TaurosPaldeanBitmasks:      INCLUDE "gfx/pokemon/tauros_paldean/bitmask.asm"
-TaurosPaldeanFireBitmasks:  INCLUDE "gfx/pokemon/tauros_paldean_fire/bitmask.asm"
-TaurosPaldeanWaterBitmasks: INCLUDE "gfx/pokemon/tauros_paldean_water/bitmask.asm"
+TaurosPlainBitmasks:        INCBIN "gfx/pokemon/tauros_plain/bitmask.bin"
+TaurosPaldeanBitmasks:      INCBIN "gfx/pokemon/tauros_paldean/bitmask.bin"
+TaurosPaldeanFireBitmasks:  INCBIN "gfx/pokemon/tauros_paldean_fire/bitmask.bin"
+TaurosPaldeanWaterBitmasks: INCBIN "gfx/pokemon/tauros_paldean_water/bitmask.bin"
 
-UrsalunaPlainBitmasks:     INCLUDE "gfx/pokemon/ursaluna_plain/bitmask.asm"
-UrsalunaBloodmoonBitmasks: INCLUDE "gfx/pokemon/ursaluna_bloodmoon/bitmask.asm"
+UrsalunaPlainBitmasks:     INCBIN "gfx/pokemon/ursaluna_plain/bitmask.bin"
+UrsalunaBloodmoonBitmasks: INCBIN "gfx/pokemon/ursaluna_bloodmoon/bitmask.bin"
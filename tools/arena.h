@@ -0,0 +1,61 @@
+#ifndef GUARD_ARENA_H
+#define GUARD_ARENA_H
+
+// Include common.h before this header
+
+#define ARENA_BLOCK_SIZE 0x10000
+
+// A bump allocator: memory is never freed piecemeal, only all at once by arena_reset or arena_free
+struct ArenaBlock {
+	struct ArenaBlock *next;
+	size_t used;
+	size_t capacity;
+	max_align_t data[];
+};
+
+struct Arena {
+	struct ArenaBlock *blocks; // newest first
+};
+
+void *arena_alloc(struct Arena *arena, size_t size) {
+	size = (size + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+	struct ArenaBlock *block = arena->blocks;
+	if (!block || block->used + size > block->capacity) {
+		size_t capacity = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+		block = xmalloc(sizeof(*block) + capacity);
+		block->next = arena->blocks;
+		block->used = 0;
+		block->capacity = capacity;
+		arena->blocks = block;
+	}
+	void *m = (uint8_t *)block->data + block->used;
+	block->used += size;
+	return m;
+}
+
+void *arena_calloc(struct Arena *arena, size_t size) {
+	void *m = arena_alloc(arena, size);
+	memset(m, 0, size);
+	return m;
+}
+
+// Frees everything allocated so far, but keeps the newest block for reuse
+void arena_reset(struct Arena *arena) {
+	struct ArenaBlock *block = arena->blocks;
+	if (block) {
+		for (struct ArenaBlock *old = block->next, *next; old; old = next) {
+			next = old->next;
+			free(old);
+		}
+		block->next = NULL;
+		block->used = 0;
+	}
+}
+
+void arena_free(struct Arena *arena) {
+	arena_reset(arena);
+	free(arena->blocks);
+	arena->blocks = NULL;
+}
+
+#endif // GUARD_ARENA_H
@@ -0,0 +1,376 @@
+#define PROGRAM_NAME "block_compression"
+#define USAGE_OPTS "[-h|--help] [-d|--outdir dir] [-q|--quiet] [file.ablk...]"
+
+#include "common.h"
+#include "mapdata.h"
+#include "lz/lz.h"
+
+struct Options {
+	const char *outdir;
+	bool quiet;
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"outdir", required_argument, 0, 'd'},
+		{"quiet", no_argument, 0, 'q'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "d:qh", long_options)) != -1;) {
+		switch (opt) {
+		case 'd':
+			options->outdir = optarg;
+			break;
+		case 'q':
+			options->quiet = true;
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+// Decoding costs are in M-cycles (4 T-cycles; 2 in double speed mode),
+// counted along the instruction paths of the routines named below.
+// Call setup and bank switching are the same for every format and left out.
+
+#define RLE_END 0xff
+#define RLE_MAX_RUN 0x100 // a count of 0 copies 256 bytes
+
+struct Evaluation {
+	const char *filename;
+	long raw_size;
+	long lz_size;
+	long rle_size; // -1 if the data contains $ff, which CopyRLE cannot encode
+	long raw_cycles;
+	long lz_cycles;
+	long rle_cycles;
+};
+
+// _CopyBytes in home/copy.asm: one byte, then two, then four per loop iteration
+long copy_bytes_cycles(long size) {
+	int low = size & 0xff;
+	long high = size >> 8;
+	long cycles = 1 + 2 + (low & 1 ? 2 + 6 : 3) + 2 + (low & 2 ? 2 + 12 : 3);
+	int loops = low >> 2;
+	cycles += loops ? 2 + loops * 25 + (loops - 1) * 3 + 2 : 3;
+	// Every further 256 bytes are $40 more iterations
+	cycles += high * (1 + 2 + 2 + 3 + 0x40 * 25 + (0x40 - 1) * 3 + 2);
+	return cycles + 1 + 5;
+}
+
+// CopyRLE in home/copy_rle.asm: (value, count) pairs terminated by $ff
+long rle_encode(const uint8_t *data, long size, uint8_t *output, long *cycles) {
+	long length = 0;
+	*cycles = 0;
+	for (long i = 0; i < size;) {
+		if (data[i] == RLE_END) {
+			return -1;
+		}
+		long run = 1;
+		while (run < RLE_MAX_RUN && i + run < size && data[i + run] == data[i]) {
+			run++;
+		}
+		output[length++] = data[i];
+		output[length++] = (uint8_t)run;
+		*cycles += 12 + 8 * run;
+		i += run;
+	}
+	output[length++] = RLE_END;
+	*cycles += 8;
+	return length;
+}
+
+// Serializes commands the way lzcomp writes them (see write_command_to_file in lz/output.c)
+long lz_serialize(const struct command *commands, unsigned short num_commands, const uint8_t *data, uint8_t *output) {
+	long length = 0;
+	for (unsigned short i = 0; i < num_commands; i++) {
+		struct command command = commands[i];
+		unsigned count = command.count - minimum_count(command.command);
+		if (count < SHORT_COMMAND_COUNT) {
+			output[length++] = (uint8_t)((command.command << 5) + count);
+		} else {
+			output[length++] = (uint8_t)(0xe0 + (command.command << 2) + (count >> 8));
+			output[length++] = (uint8_t)count;
+		}
+		switch (command.command) {
+		case LZ_DATA:
+			memcpy(output + length, data + command.value, command.count);
+			length += command.count;
+			break;
+		case LZ_REPEAT:
+			output[length++] = (uint8_t)command.value;
+			break;
+		case LZ_ALTERNATE:
+			output[length++] = (uint8_t)command.value;
+			output[length++] = (uint8_t)(command.value >> 8);
+			break;
+		case LZ_ZERO:
+			break;
+		default:
+			if (command.value < 0) {
+				output[length++] = (uint8_t)(command.value ^ 0x7f);
+			} else {
+				output[length++] = (uint8_t)(command.value >> 8);
+				output[length++] = (uint8_t)command.value;
+			}
+		}
+	}
+	output[length++] = 0xff;
+	return length;
+}
+
+// The unrolled loops in _Decompress write two bytes per iteration:
+// "rr c / inc c / jr nc, .skip / half / .skip: half / dec c / jr nz"
+long lz_loop_cycles(int count, int half) {
+	int iterations = ((count - 1) >> 1) + 1;
+	// An odd count jumps over the first half, so one byte less is written
+	return 2 + 1 + (count & 1 ? 3 - half : 2) + iterations * (2 * half + 1) + (iterations - 1) * 3 + 2;
+}
+
+// Decodes like _Decompress in home/decompress.asm, adding up the cycles of each command's path.
+// Returns the decoded size, or -1 if the stream is invalid or overflows the output.
+long lz_decode(const uint8_t *lz, long lz_size, uint8_t *output, long max_size, long *cycles) {
+	long in = 0, out = 0;
+	*cycles = 0;
+	for (;;) {
+		if (in >= lz_size) {
+			return -1;
+		}
+		int command_byte = lz[in++];
+		int command = command_byte >> 5;
+		int count = command_byte & 0x1f;
+		long path = 7; // .Main: "ld a, [de] / inc de / ld c, a / and LZ_CMD"
+		if (command == LZ_DATA) {
+			path += 3;
+		} else if (command == LZ_LONG) {
+			path += 2 + 1 + 2 + 3 + 1; // to .long, "inc b"
+			if (command_byte == 0xff) {
+				*cycles += path + 5;
+				return out;
+			}
+			if (in >= lz_size) {
+				return -1;
+			}
+			command = (command_byte >> 2) & 7;
+			count = ((command_byte & 1) << 8) | lz[in++];
+			path += 2 + 1 + 2 + 2 + 1 + 2 + 1 + 3 + 1 + 1 + 2; // to "and LZ_CMD"
+			path += command == LZ_DATA ? 2 + 3 + 2 : 3; // "jr .lz_data / srl b" or "jr nz, .cont"
+		} else {
+			path += 2 + 1 + 2 + 2 + 4; // to .cont
+		}
+		count += minimum_count(command);
+		if (command == LZ_DATA) {
+			if (in + count > lz_size || out + count > max_size) {
+				return -1;
+			}
+			memcpy(output + out, lz + in, count);
+			in += count;
+			out += count;
+			*cycles += path + lz_loop_cycles(count, 6);
+			continue;
+		}
+		if (out + count > max_size) {
+			return -1;
+		}
+		if (command < LZ_COPY_NORMAL) {
+			path += 1 + 2 + 2; // "rla / jr c / cp"
+			if (command == LZ_ZERO) {
+				memset(output + out, 0, count);
+				*cycles += path + 2 + 3 + 1 + 2 + lz_loop_cycles(count, 2) + 3;
+			} else if (command == LZ_REPEAT) {
+				if (in + 1 > lz_size) {
+					return -1;
+				}
+				memset(output + out, lz[in++], count);
+				*cycles += path + 2 + 2 + 9 + 2 + lz_loop_cycles(count - 1, 2) + 3;
+			} else {
+				if (in + 2 > lz_size) {
+					return -1;
+				}
+				for (int i = 0; i < count; i++) {
+					output[out + i] = lz[in + (i & 1)];
+				}
+				in += 2;
+				*cycles += path + 3 + 24 + 2 + lz_loop_cycles(count - 2, 6) + 8;
+			}
+			out += count;
+			continue;
+		}
+
+		path += 1 + 3 + 2 + 2; // "rla / jr c / ld a, [de] / bit 7, a"
+		if (in >= lz_size) {
+			return -1;
+		}
+		long offset;
+		if (lz[in] & 0x80) {
+			offset = out - ((lz[in++] & 0x7f) + 1);
+			path += 3 + 14;
+		} else {
+			if (in + 2 > lz_size) {
+				return -1;
+			}
+			offset = (lz[in] << 8) | lz[in + 1];
+			in += 2;
+			path += 2 + 26;
+		}
+		path += 12; // .got_offset
+		if (offset < 0 || offset >= out || (command == LZ_COPY_REVERSED && offset - count + 1 < 0)) {
+			return -1;
+		}
+		for (int i = 0; i < count; i++) {
+			if (command == LZ_COPY_NORMAL) {
+				output[out + i] = output[offset + i];
+			} else if (command == LZ_COPY_FLIPPED) {
+				output[out + i] = bit_flipping_table[output[offset + i]];
+			} else {
+				output[out + i] = output[offset - i];
+			}
+		}
+		out += count;
+		if (command == LZ_COPY_FLIPPED) {
+			path += 3 + 2 + lz_loop_cycles(count, 21);
+		} else {
+			path += (command == LZ_COPY_NORMAL ? 2 + 2 : 2 + 3) + 2 + lz_loop_cycles(count, 6);
+		}
+		*cycles += path + 8; // "pop de / inc de / jr .Main"
+	}
+}
+
+void write_variant(const char *outdir, const char *filename, const char *extension, uint8_t *data, long size) {
+	char *name = xmalloc(strlen(filename) + strlen(extension) + 1);
+	sprintf(name, "%s%s", filename, extension);
+	char *path = output_path(outdir, name);
+	write_u8(path, data, size);
+	free(path);
+	free(name);
+}
+
+void evaluate(struct Evaluation *evaluation, const char *outdir) {
+	long size;
+	uint8_t *data = read_u8(evaluation->filename, &size);
+	if (size > MAX_FILE_SIZE) {
+		error_exit("%s: too big to compress (%ld bytes)\n", evaluation->filename, size);
+	}
+	evaluation->raw_size = size;
+	evaluation->raw_cycles = copy_bytes_cycles(size);
+
+	// Worst cases: every byte a literal with a long header, or every byte its own run
+	uint8_t *lz = xmalloc(size + size / SHORT_COMMAND_COUNT * 2 + 3);
+	uint8_t *rle = xmalloc(size * 2 + 1);
+	uint8_t *decoded = xmalloc(size + 1);
+	uint8_t *bitflipped = xmalloc(size + 1);
+	for (long i = 0; i < size; i++) {
+		bitflipped[i] = bit_flipping_table[data[i]];
+	}
+
+	unsigned short num_commands = (unsigned short)size;
+	struct command *commands = compress_dp(data, bitflipped, &num_commands);
+	evaluation->lz_size = lz_serialize(commands, num_commands, data, lz);
+	if (lz_decode(lz, evaluation->lz_size, decoded, size, &evaluation->lz_cycles) != size || memcmp(decoded, data, size)) {
+		error_exit("%s: LZ data does not decompress to the original\n", evaluation->filename);
+	}
+	evaluation->rle_size = rle_encode(data, size, rle, &evaluation->rle_cycles);
+
+	if (outdir) {
+		write_variant(outdir, evaluation->filename, ".lz", lz, evaluation->lz_size);
+		if (evaluation->rle_size != -1) {
+			write_variant(outdir, evaluation->filename, ".rle", rle, evaluation->rle_size);
+		}
+	}
+
+	free(commands);
+	free(bitflipped);
+	free(decoded);
+	free(rle);
+	free(lz);
+	free(data);
+}
+
+void print_evaluations(const struct Evaluation *evaluations, int num_evaluations, bool quiet) {
+	long raw_size = 0, lz_size = 0, rle_size = 0, best_size = 0;
+	long raw_cycles = 0, lz_cycles = 0, rle_cycles = 0;
+	int num_unencodable = 0;
+	int num_best[3] = {0}; // raw, lz, rle
+	if (!quiet) {
+		printf("%-40s %6s %6s %6s %8s %8s %8s\n", "; file", "raw", "lz", "rle", "copy", "lz cyc", "rle cyc");
+	}
+	for (int i = 0; i < num_evaluations; i++) {
+		const struct Evaluation *evaluation = &evaluations[i];
+		raw_size += evaluation->raw_size;
+		raw_cycles += evaluation->raw_cycles;
+		lz_size += evaluation->lz_size;
+		lz_cycles += evaluation->lz_cycles;
+		// Unencodable RLE falls back to the LZ data, so totals stay comparable
+		bool rle = evaluation->rle_size != -1;
+		rle_size += rle ? evaluation->rle_size : evaluation->lz_size;
+		rle_cycles += rle ? evaluation->rle_cycles : evaluation->lz_cycles;
+		num_unencodable += !rle;
+		long best = evaluation->lz_size;
+		int best_format = 1;
+		if (evaluation->raw_size < best) {
+			best = evaluation->raw_size;
+			best_format = 0;
+		}
+		if (rle && evaluation->rle_size < best) {
+			best = evaluation->rle_size;
+			best_format = 2;
+		}
+		best_size += best;
+		num_best[best_format]++;
+		if (quiet) {
+			continue;
+		}
+		printf("%-40s %6ld %6ld ", evaluation->filename, evaluation->raw_size, evaluation->lz_size);
+		if (rle) {
+			printf("%6ld ", evaluation->rle_size);
+		} else {
+			printf("%6s ", "-");
+		}
+		printf("%8ld %8ld ", evaluation->raw_cycles, evaluation->lz_cycles);
+		if (rle) {
+			printf("%8ld\n", evaluation->rle_cycles);
+		} else {
+			printf("%8s\n", "-");
+		}
+	}
+
+	printf("; %d files, %ld bytes raw (%ld cycles to copy)\n", num_evaluations, raw_size, raw_cycles);
+	printf("; lz: %ld bytes, saves %ld; %ld cycles to decode\n", lz_size, raw_size - lz_size, lz_cycles);
+	printf("; rle: %ld bytes, saves %ld; %ld cycles to decode", rle_size, raw_size - rle_size, rle_cycles);
+	if (num_unencodable) {
+		printf(" (%d files with block $ff kept as lz)", num_unencodable);
+	}
+	putchar('\n');
+	printf("; smallest per file: %ld bytes (%d raw, %d lz, %d rle), saves %ld over lz\n",
+		best_size, num_best[0], num_best[1], num_best[2], lz_size - best_size);
+}
+
+int main(int argc, char *argv[]) {
+	struct Options options = {0};
+	parse_args(argc, argv, &options);
+
+	argc -= optind;
+	argv += optind;
+
+	struct MapData data = {0};
+	int num_evaluations = argc;
+	if (!argc) {
+		load_map_data(&data);
+		num_evaluations = data.num_block_data;
+	}
+	struct Evaluation *evaluations = xcalloc(num_evaluations * sizeof(*evaluations));
+	for (int i = 0; i < num_evaluations; i++) {
+		evaluations[i].filename = argc ? argv[i] : data.block_data[i].filename;
+		evaluate(&evaluations[i], options.outdir);
+	}
+
+	print_evaluations(evaluations, num_evaluations, options.quiet);
+
+	free(evaluations);
+	return 0;
+}
@@ -0,0 +1,621 @@
+#define PROGRAM_NAME "block_regions"
+#define USAGE_OPTS "[-h|--help] [-d|--max-diff n] [-r|--region WxH] [-t|--top n] [-o|--output mapping.txt]"
+
+#include "common.h"
+#include "mapdata.h"
+#include "lz/lz.h"
+
+struct Options {
+	int max_diff;
+	int region_width;
+	int region_height;
+	int top;
+	const char *out_filename;
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"max-diff", required_argument, 0, 'd'},
+		{"region", required_argument, 0, 'r'},
+		{"top", required_argument, 0, 't'},
+		{"output", required_argument, 0, 'o'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "d:r:t:o:h", long_options)) != -1;) {
+		switch (opt) {
+		case 'd':
+			options->max_diff = (int)strtoul(optarg, NULL, 0);
+			break;
+		case 'r':
+			if (sscanf(optarg, "%dx%d", &options->region_width, &options->region_height) != 2
+				|| options->region_width < 1 || options->region_height < 1) {
+				error_exit("Invalid region size: %s\n", optarg);
+			}
+			break;
+		case 't':
+			options->top = (int)strtoul(optarg, NULL, 0);
+			break;
+		case 'o':
+			options->out_filename = optarg;
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+// Bytes of script each map needs to patch a shared layout back into its own:
+// a MAPCALLBACK_TILES entry in its def_callbacks table, the callback's endcallback,
+// and one changeblock per block
+#define CALLBACK_ENTRY_BYTES 3
+#define ENDCALLBACK_BYTES 1
+#define CHANGEBLOCK_BYTES 4
+
+struct BlockFile {
+	const struct BlockData *block_data;
+	int width;
+	int height;
+	uint8_t *blocks;
+	long lz_size; // what the ROM stores, as lzcomp would compress it
+	int base; // file whose data this one can point to instead, or -1
+	int num_diffs; // blocks to change after loading the base's data
+	int num_maps; // maps whose headers point to it, each needing its own callback
+	long saved_bytes; // by pointing to the base instead, net of the maps' scripts
+	bool is_base;
+	bool loaded_by_script; // a "changemapblocks" loads one of its labels, so it must keep its own data
+	bool exported; // code compares pointers against one of its labels, so it cannot share data at all
+};
+
+struct Window {
+	uint64_t hash;
+	int file;
+	int x;
+	int y;
+};
+
+struct Cluster {
+	int first; // index into the sorted windows
+	int count; // windows with the same contents, all in different places
+	int num_files;
+};
+
+struct Regions {
+	const struct MapData *data;
+	struct BlockFile *files;
+	int num_files;
+	int width; // window size, in blocks
+	int height;
+	struct Window *windows;
+	int num_windows;
+	struct Cluster *clusters;
+	int num_clusters;
+	int **cluster_at; // per file, the shared cluster of the window at each block, or -1
+};
+
+long lz_size(const uint8_t *data, long size) {
+	uint8_t *bitflipped = xmalloc(size);
+	for (long i = 0; i < size; i++) {
+		bitflipped[i] = bit_flipping_table[data[i]];
+	}
+	unsigned short num_commands = (unsigned short)size;
+	struct command *commands = compress_dp(data, bitflipped, &num_commands);
+	long length = compressed_length(commands, num_commands) + 1; // and the $ff terminator
+	free(commands);
+	free(bitflipped);
+	return length;
+}
+
+void read_block_files(struct Regions *regions) {
+	const struct MapData *data = regions->data;
+	regions->files = xmalloc(data->num_block_data * sizeof(*regions->files));
+	for (int i = 0; i < data->num_block_data; i++) {
+		const struct BlockData *block_data = &data->block_data[i];
+		if (block_data->map == -1) {
+			continue; // no map uses it, so its size is unknown
+		}
+		const struct Map *map = &data->maps[block_data->map];
+		long size;
+		uint8_t *blocks = read_u8(block_data->filename, &size);
+		if (size != map->width * map->height) {
+			error_exit("%s: %ld bytes, but %s is %dx%d blocks\n", block_data->filename, size, map->name,
+				map->width, map->height);
+		}
+		regions->files[regions->num_files++] = (struct BlockFile){
+			.block_data = block_data,
+			.width = map->width,
+			.height = map->height,
+			.blocks = blocks,
+			.lz_size = lz_size(blocks, size),
+			.base = -1,
+		};
+		for (int m = 0; m < data->num_maps; m++) {
+			regions->files[regions->num_files - 1].num_maps += data->maps[m].block_data == i;
+		}
+	}
+}
+
+// Adds the labels that map scripts load with "changemapblocks", like "AzaleaTownRaining"
+void read_script_labels(const struct MapData *data, char ***labels, int *num_labels) {
+	for (int i = 0; i < data->num_maps; i++) {
+		char filename[0x100];
+		snprintf(filename, sizeof(filename), "maps/%s.asm", data->maps[i].name);
+		if (!file_exists(filename)) {
+			continue;
+		}
+		char *text = read_text(filename);
+		char *cursor = text;
+		for (char *line; (line = next_line(&cursor));) {
+			char *args = macro_args(line, "changemapblocks");
+			char *suffix = args ? strstr(args, "_BlockData") : NULL;
+			if (suffix) {
+				*labels = xrealloc(*labels, (*num_labels + 1) * sizeof(**labels));
+				(*labels)[(*num_labels)++] = xstrndup(args, suffix - args);
+			}
+		}
+		free(text);
+	}
+}
+
+// Flags the files whose data is referred to by something other than their map's header
+void read_label_uses(struct Regions *regions) {
+	const struct MapData *data = regions->data;
+	char **script_labels = NULL;
+	int num_script_labels = 0;
+	read_script_labels(data, &script_labels, &num_script_labels);
+
+	bool *loaded_by_script = xcalloc(data->num_block_data * sizeof(bool));
+	bool *exported = xcalloc(data->num_block_data * sizeof(bool));
+	bool group_loaded = false, group_exported = false;
+	int index = 0;
+	char *text = read_text(MAP_BLOCKS_FILE);
+	char *cursor = text;
+	for (char *line; (line = next_line(&cursor)) && index < data->num_block_data;) {
+		char *suffix = strstr(line, "_BlockData:");
+		if (suffix && !isspace((unsigned)line[0]) && strncmp(line, "SECTION", 7)) {
+			group_exported |= suffix[strlen("_BlockData:")] == ':';
+			*suffix = '\0';
+			for (int i = 0; i < num_script_labels; i++) {
+				group_loaded |= !strcmp(line, script_labels[i]);
+			}
+			continue;
+		}
+		char *filename = incbin_filename(line);
+		if (!filename) {
+			continue;
+		}
+		free(filename);
+		loaded_by_script[index] = group_loaded;
+		exported[index++] = group_exported;
+		group_loaded = group_exported = false;
+	}
+	free(text);
+
+	for (int f = 0; f < regions->num_files; f++) {
+		struct BlockFile *file = &regions->files[f];
+		int i = (int)(file->block_data - data->block_data);
+		file->loaded_by_script = loaded_by_script[i];
+		file->exported = exported[i];
+	}
+	free(loaded_by_script);
+	free(exported);
+	for (int i = 0; i < num_script_labels; i++) {
+		free(script_labels[i]);
+	}
+	free(script_labels);
+}
+
+// Labels that point to a file, as they appear in data/maps/blocks.asm
+void print_labels(FILE *f, const struct Regions *regions, int file) {
+	const struct MapData *data = regions->data;
+	int block_data = (int)(regions->files[file].block_data - data->block_data);
+	bool any = false;
+	for (int i = 0; i < data->num_maps; i++) {
+		if (data->maps[i].block_data == block_data) {
+			fprintf(f, "%s%s_BlockData", any ? ", " : "", data->maps[i].name);
+			any = true;
+		}
+	}
+	if (!any) {
+		fprintf(f, "%s_BlockData", regions->files[file].block_data->label);
+	}
+}
+
+int count_diffs(const struct BlockFile *a, const struct BlockFile *b) {
+	int diffs = 0;
+	for (int i = 0; i < a->width * a->height; i++) {
+		diffs += a->blocks[i] != b->blocks[i];
+	}
+	return diffs;
+}
+
+struct Candidate {
+	int file;
+	int base;
+	int num_diffs;
+	long saved_bytes;
+};
+
+int compare_candidates(const void *a, const void *b) {
+	const struct Candidate *x = a, *y = b;
+	if (x->saved_bytes != y->saved_bytes) {
+		return x->saved_bytes < y->saved_bytes ? 1 : -1;
+	}
+	return x->file != y->file ? x->file - y->file : x->base - y->base;
+}
+
+// Same-sized files that differ in at most max_diff blocks can share one pointer,
+// with changeblock commands patching in the differences.
+// Greedily picks the pairs that save the most, so that no base is itself replaced.
+// Data that a script loads by label is never replaced, since its changeblock patches would not run
+// after "changemapblocks"; data that code compares pointers against, like GenericMart's, is never shared.
+long find_shared_layouts(struct Regions *regions, int max_diff) {
+	struct Candidate *candidates = NULL;
+	int num_candidates = 0;
+	for (int i = 0; i < regions->num_files; i++) {
+		for (int j = 0; j < regions->num_files; j++) {
+			const struct BlockFile *file = &regions->files[i], *base = &regions->files[j];
+			if (i == j || file->width != base->width || file->height != base->height
+				|| file->loaded_by_script || file->exported || base->exported) {
+				continue;
+			}
+			int diffs = count_diffs(file, base);
+			long script_bytes = CALLBACK_ENTRY_BYTES + ENDCALLBACK_BYTES + diffs * CHANGEBLOCK_BYTES;
+			long saved = file->lz_size - (diffs ? file->num_maps * script_bytes : 0);
+			// Without a map header to hang a callback on, differing data cannot be patched back
+			if (diffs > max_diff || saved <= 0 || (!diffs && j > i) || (diffs && !file->num_maps)) {
+				continue;
+			}
+			candidates = xrealloc(candidates, (num_candidates + 1) * sizeof(*candidates));
+			candidates[num_candidates++] = (struct Candidate){i, j, diffs, saved};
+		}
+	}
+	qsort(candidates, num_candidates, sizeof(*candidates), compare_candidates);
+
+	long saved_bytes = 0;
+	for (int c = 0; c < num_candidates; c++) {
+		struct BlockFile *file = &regions->files[candidates[c].file];
+		struct BlockFile *base = &regions->files[candidates[c].base];
+		if (file->base != -1 || file->is_base || base->base != -1) {
+			continue;
+		}
+		file->base = candidates[c].base;
+		file->num_diffs = candidates[c].num_diffs;
+		file->saved_bytes = candidates[c].saved_bytes;
+		base->is_base = true;
+		saved_bytes += candidates[c].saved_bytes;
+	}
+	free(candidates);
+	return saved_bytes;
+}
+
+// Rabin-Karp over rows, then over columns of row hashes
+#define ROW_BASE 0x100000001b3ULL
+#define COLUMN_BASE 0x9e3779b97f4a7c15ULL
+
+uint64_t power(uint64_t base, int exponent) {
+	uint64_t result = 1;
+	while (exponent--) {
+		result *= base;
+	}
+	return result;
+}
+
+bool window_is_uniform(const struct BlockFile *file, int x, int y, int width, int height) {
+	uint8_t first = file->blocks[y * file->width + x];
+	for (int dy = 0; dy < height; dy++) {
+		for (int dx = 0; dx < width; dx++) {
+			if (file->blocks[(y + dy) * file->width + x + dx] != first) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// Hashes every window of the region size in every file that keeps its own data.
+// Windows of a single repeated block (walls, water, grass) are skipped:
+// they match everywhere and compress to almost nothing anyway.
+void hash_windows(struct Regions *regions) {
+	int width = regions->width, height = regions->height;
+	uint64_t row_power = power(ROW_BASE, width - 1), column_power = power(COLUMN_BASE, height - 1);
+	for (int f = 0; f < regions->num_files; f++) {
+		const struct BlockFile *file = &regions->files[f];
+		if (file->base != -1 || file->width < width || file->height < height) {
+			continue;
+		}
+		int columns = file->width - width + 1;
+		uint64_t *row_hashes = xmalloc(file->height * columns * sizeof(*row_hashes));
+		for (int y = 0; y < file->height; y++) {
+			const uint8_t *row = &file->blocks[y * file->width];
+			uint64_t hash = 0;
+			for (int x = 0; x < file->width; x++) {
+				if (x >= width) {
+					hash -= row[x - width] * row_power;
+				}
+				hash = hash * ROW_BASE + row[x] + 1;
+				if (x >= width - 1) {
+					row_hashes[y * columns + x - width + 1] = hash;
+				}
+			}
+		}
+		regions->windows = xrealloc(regions->windows,
+			(regions->num_windows + columns * (file->height - height + 1)) * sizeof(*regions->windows));
+		for (int x = 0; x < columns; x++) {
+			uint64_t hash = 0;
+			for (int y = 0; y < file->height; y++) {
+				if (y >= height) {
+					hash -= row_hashes[(y - height) * columns + x] * column_power;
+				}
+				hash = hash * COLUMN_BASE + row_hashes[y * columns + x];
+				if (y >= height - 1 && !window_is_uniform(file, x, y - height + 1, width, height)) {
+					regions->windows[regions->num_windows++] = (struct Window){hash, f, x, y - height + 1};
+				}
+			}
+		}
+		free(row_hashes);
+	}
+}
+
+int compare_windows(const void *a, const void *b) {
+	const struct Window *x = a, *y = b;
+	if (x->hash != y->hash) {
+		return x->hash < y->hash ? -1 : 1;
+	}
+	if (x->file != y->file) {
+		return x->file - y->file;
+	}
+	return x->y != y->y ? x->y - y->y : x->x - y->x;
+}
+
+bool same_window(const struct Regions *regions, const struct Window *a, const struct Window *b) {
+	const struct BlockFile *file_a = &regions->files[a->file], *file_b = &regions->files[b->file];
+	for (int dy = 0; dy < regions->height; dy++) {
+		if (memcmp(&file_a->blocks[(a->y + dy) * file_a->width + a->x],
+			&file_b->blocks[(b->y + dy) * file_b->width + b->x], regions->width)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Groups windows with the same contents that occur in at least two files.
+// Sorting by hash brings them together; a run of equal hashes is split again by contents
+// in case of collisions, moving each group to the front of what is left of the run.
+void cluster_windows(struct Regions *regions) {
+	qsort(regions->windows, regions->num_windows, sizeof(*regions->windows), compare_windows);
+	regions->cluster_at = xmalloc(regions->num_files * sizeof(*regions->cluster_at));
+	for (int f = 0; f < regions->num_files; f++) {
+		const struct BlockFile *file = &regions->files[f];
+		regions->cluster_at[f] = xmalloc(file->width * file->height * sizeof(**regions->cluster_at));
+		for (int i = 0; i < file->width * file->height; i++) {
+			regions->cluster_at[f][i] = -1;
+		}
+	}
+
+	for (int start = 0, end; start < regions->num_windows; start = end) {
+		for (end = start + 1; end < regions->num_windows && regions->windows[end].hash == regions->windows[start].hash;) {
+			end++;
+		}
+		for (int first = start; first < end;) {
+			int count = 1;
+			for (int i = first + 1; i < end; i++) {
+				if (same_window(regions, &regions->windows[first], &regions->windows[i])) {
+					struct Window window = regions->windows[i];
+					memmove(&regions->windows[first + count + 1], &regions->windows[first + count],
+						(i - first - count) * sizeof(*regions->windows));
+					regions->windows[first + count++] = window;
+				}
+			}
+			int num_files = 1;
+			for (int i = first + 1; i < first + count; i++) {
+				num_files += regions->windows[i].file != regions->windows[i - 1].file;
+			}
+			if (num_files > 1) {
+				int c = regions->num_clusters++;
+				regions->clusters = xrealloc(regions->clusters, regions->num_clusters * sizeof(*regions->clusters));
+				regions->clusters[c] = (struct Cluster){first, count, num_files};
+				for (int i = first; i < first + count; i++) {
+					const struct Window *window = &regions->windows[i];
+					regions->cluster_at[window->file][window->y * regions->files[window->file].width + window->x] = c;
+				}
+			}
+			first += count;
+		}
+	}
+}
+
+// If every occurrence of a cluster continues, at the same offset, into one other cluster
+// with as many occurrences, both are part of the same larger shared region
+int next_cluster(const struct Regions *regions, int c, int dx, int dy) {
+	const struct Cluster *cluster = &regions->clusters[c];
+	int next = -1;
+	for (int i = cluster->first; i < cluster->first + cluster->count; i++) {
+		const struct Window *window = &regions->windows[i];
+		const struct BlockFile *file = &regions->files[window->file];
+		int x = window->x + dx, y = window->y + dy;
+		if (x < 0 || y < 0 || x >= file->width || y >= file->height) {
+			return -1;
+		}
+		int other = regions->cluster_at[window->file][y * file->width + x];
+		if (other == -1 || (next != -1 && other != next) || regions->clusters[other].count != cluster->count) {
+			return -1;
+		}
+		next = other;
+	}
+	return next;
+}
+
+struct Region {
+	int cluster; // cluster of the region's top-left window
+	int width;
+	int height;
+	long duplicate_blocks;
+};
+
+int compare_regions(const void *a, const void *b) {
+	const struct Region *x = a, *y = b;
+	if (x->duplicate_blocks != y->duplicate_blocks) {
+		return x->duplicate_blocks < y->duplicate_blocks ? 1 : -1;
+	}
+	return x->cluster - y->cluster;
+}
+
+// Merges overlapping windows back into the rectangles that they were cut from
+struct Region *find_regions(const struct Regions *regions, int *num_regions) {
+	struct Region *found = NULL;
+	*num_regions = 0;
+	for (int c = 0; c < regions->num_clusters; c++) {
+		if (next_cluster(regions, c, -1, 0) != -1 || next_cluster(regions, c, 0, -1) != -1) {
+			continue;
+		}
+		struct Region region = {c, regions->width, regions->height, 0};
+		for (int next = c; (next = next_cluster(regions, next, 1, 0)) != -1;) {
+			region.width++;
+		}
+		for (int next = c; (next = next_cluster(regions, next, 0, 1)) != -1;) {
+			region.height++;
+		}
+		region.duplicate_blocks = (long)region.width * region.height * (regions->clusters[c].count - 1);
+		found = xrealloc(found, (*num_regions + 1) * sizeof(*found));
+		found[(*num_regions)++] = region;
+	}
+	qsort(found, *num_regions, sizeof(*found), compare_regions);
+	return found;
+}
+
+// Blocks of each file that lie in a window also found in another file
+long count_shared_blocks(const struct Regions *regions) {
+	long shared = 0;
+	for (int f = 0; f < regions->num_files; f++) {
+		const struct BlockFile *file = &regions->files[f];
+		bool *covered = xcalloc(file->width * file->height * sizeof(*covered));
+		for (int y = 0; y < file->height; y++) {
+			for (int x = 0; x < file->width; x++) {
+				if (regions->cluster_at[f][y * file->width + x] == -1) {
+					continue;
+				}
+				for (int dy = 0; dy < regions->height; dy++) {
+					for (int dx = 0; dx < regions->width; dx++) {
+						covered[(y + dy) * file->width + x + dx] = true;
+					}
+				}
+			}
+		}
+		for (int i = 0; i < file->width * file->height; i++) {
+			shared += covered[i];
+		}
+		free(covered);
+	}
+	return shared;
+}
+
+void print_regions(const struct Regions *regions, int top) {
+	int num_regions;
+	struct Region *found = find_regions(regions, &num_regions);
+	long shared_blocks = count_shared_blocks(regions);
+	printf("%dx%d+ regions: %d shared by 2+ files, %ld blocks lie in one\n",
+		regions->width, regions->height, num_regions, shared_blocks);
+	for (int r = 0; r < num_regions && r < top; r++) {
+		const struct Cluster *cluster = &regions->clusters[found[r].cluster];
+		printf("\t%dx%d, %d copies in %d files:", found[r].width, found[r].height, cluster->count, cluster->num_files);
+		for (int i = cluster->first; i < cluster->first + cluster->count; i++) {
+			const struct Window *window = &regions->windows[i];
+			printf(" %s(%d,%d)", regions->files[window->file].block_data->filename, window->x, window->y);
+		}
+		putchar('\n');
+	}
+	putchar('\n');
+	free(found);
+}
+
+void print_shared_layouts(const struct Regions *regions, long saved_bytes) {
+	int num_shared = 0;
+	for (int f = 0; f < regions->num_files; f++) {
+		const struct BlockFile *file = &regions->files[f];
+		if (file->base == -1) {
+			continue;
+		}
+		printf("\t%s -> %s, %d blocks differ in %d maps, %ld of %ld bytes saved\n", file->block_data->filename,
+			regions->files[file->base].block_data->filename, file->num_diffs, file->num_maps, file->saved_bytes,
+			file->lz_size);
+		num_shared++;
+	}
+	printf("layouts: %d of %d files can point to another's data, sharable = %ld bytes (compressed, net of scripts)\n\n",
+		num_shared, regions->num_files, saved_bytes);
+}
+
+// The proposed data/maps/blocks.asm changes: the labels of each replaced file
+// move above the INCBIN of its base, and the map gets a MAPCALLBACK_TILES callback
+void write_mapping(const struct Regions *regions, const char *filename) {
+	FILE *f = xfopen(filename, 'w');
+	for (int i = 0; i < regions->num_files; i++) {
+		const struct BlockFile *file = &regions->files[i];
+		if (file->base == -1) {
+			continue;
+		}
+		const struct BlockFile *base = &regions->files[file->base];
+		print_labels(f, regions, i);
+		fprintf(f, " -> %s ; drop %s\n", base->block_data->filename, file->block_data->filename);
+		for (int y = 0; y < file->height; y++) {
+			for (int x = 0; x < file->width; x++) {
+				uint8_t block = file->blocks[y * file->width + x];
+				if (block != base->blocks[y * base->width + x]) {
+					fprintf(f, "\tchangeblock %d, %d, $%02x\n", x * 2, y * 2, block);
+				}
+			}
+		}
+	}
+	fclose(f);
+}
+
+int main(int argc, char *argv[]) {
+	struct Options options = {
+		.max_diff = 8,
+		.region_width = 4,
+		.region_height = 4,
+		.top = 20,
+	};
+	parse_args(argc, argv, &options);
+
+	argc -= optind;
+	argv += optind;
+	if (argc) {
+		usage_exit(1);
+	}
+
+	struct MapData data;
+	load_map_data(&data);
+
+	struct Regions regions = {
+		.data = &data,
+		.width = options.region_width,
+		.height = options.region_height,
+	};
+	read_block_files(&regions);
+	read_label_uses(&regions);
+
+	long saved_bytes = find_shared_layouts(&regions, options.max_diff);
+	print_shared_layouts(&regions, saved_bytes);
+
+	hash_windows(&regions);
+	cluster_windows(&regions);
+	print_regions(&regions, options.top);
+
+	if (options.out_filename) {
+		write_mapping(&regions, options.out_filename);
+	}
+
+	for (int f = 0; f < regions.num_files; f++) {
+		free(regions.files[f].blocks);
+		free(regions.cluster_at[f]);
+	}
+	free(regions.files);
+	free(regions.cluster_at);
+	free(regions.windows);
+	free(regions.clusters);
+	return 0;
+}
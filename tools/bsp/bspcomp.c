@@ -2,6 +2,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <stddef.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #define LETTERS "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
 #define LETTERS_OR_UNDERSCORE LETTERS "_"
@@ -9,24 +14,53 @@
 #define VALID_ID_CHARACTERS LETTERS_OR_UNDERSCORE DIGITS
 #define NUMERIC_CHARACTERS DIGITS "+-"
 
+#define ARENA_BLOCK_SIZE 65536
+
 struct symbol {
   unsigned value;
+  struct symbol * next; // other references to the same label
   char name[];
 };
 
+// open addressing with linear probing; the capacity is zero or a power of two
+struct symbol_table {
+  struct symbol ** slots;
+  unsigned capacity;
+  unsigned count;
+};
+
 struct script_data {
   unsigned length;
-  unsigned symbol_count;
-  unsigned definition_count;
-  unsigned reference_count;
-  struct symbol ** symbols;
-  struct symbol ** definitions;
-  struct symbol ** references;
-  char data[];
+  unsigned capacity;
+  struct symbol_table symbols;
+  struct symbol_table locals;
+  struct symbol_table definitions;
+  struct symbol_table references; // pending references, chained by target label
+  struct symbol_table local_references;
+  char * data;
+};
+
+// a bump allocator: everything allocated from it is released together by arena_reset
+struct arena_block {
+  struct arena_block * next;
+  size_t used;
+  size_t capacity;
+  max_align_t data[];
+};
+
+struct arena {
+  struct arena_block * blocks; // newest first
+};
+
+struct mapped_file {
+  char * data;
+  size_t size;
+  int mapped; // 0 if data was read into a malloc'd buffer instead
 };
 
 struct file_stack_entry {
-  FILE * fp;
+  struct mapped_file file;
+  size_t position; // start of the next line
   char * name;
   unsigned line;
 };
@@ -46,6 +80,10 @@ struct argument {
 int main(int, char **);
 void error_exit(int, const char *, ...);
 void initialize_data(void);
+void * arena_allocate(struct arena *, size_t);
+void * arena_allocate_zeroed(struct arena *, size_t);
+char * arena_copy_string(struct arena *, const char *, size_t);
+void arena_reset(struct arena *);
 void append_data_to_script(const char *, unsigned);
 void append_binary_file_to_script(const char *);
 void write_halfword_to_buffer(void *, unsigned short);
@@ -53,25 +91,27 @@ void write_word_to_buffer(void *, unsigned);
 void write_number_to_buffer(unsigned char *, unsigned, unsigned char);
 struct symbol * find_symbol(const char *);
 struct symbol * find_definition(const char *);
-struct symbol * find_identifier_by_name(const char *, struct symbol **, unsigned);
+unsigned hash_name(const char *);
+struct symbol ** find_table_slot(const struct symbol_table *, const char *);
+struct symbol * find_in_table(const struct symbol_table *, const char *);
+void add_to_table(struct symbol_table *, struct symbol *);
+void clear_table(struct symbol_table *);
 void create_symbol(const char *, unsigned);
 void create_definition(const char *, unsigned);
 void create_reference(const char *, unsigned);
-struct symbol * new_symbol(const char *, unsigned);
-void resolve(const struct symbol *);
+struct symbol * new_symbol(struct arena *, const char *, unsigned);
+const struct symbol * resolve_references(struct symbol_table *, const struct symbol_table *);
 int find_unquoted_character(const char *, char);
 char * trim_string(char *);
 char * duplicate_string(const char *);
 char ** extract_components_from_line(const char *);
-void destroy_component_array(char **);
 unsigned count_parameters(char **);
 unsigned char get_hex_digit(char);
 unsigned convert_string_to_number(const char *);
-FILE * open_text_file(const char *);
-FILE * open_binary_file(const char *);
+struct mapped_file map_input_file(const char *, int);
+void unmap_input_file(struct mapped_file *);
 FILE * open_binary_file_for_writing(const char *);
 FILE * open_file(const char *, const char *, const char *);
-char * read_line(FILE *);
 char * get_line_from_input(void);
 void push_file(const char *);
 void pop_file(void);
@@ -115,6 +155,10 @@ unsigned file_stack_length = 0;
 
 struct script_data * script_data = NULL;
 
+struct arena line_arena = {0}; // tokens and arguments of the current line
+struct arena symbol_arena = {0}; // global labels, defines and references to them
+struct arena local_arena = {0}; // local labels and references to them, until the next global label
+
 struct command script_commands[] = {
   {"add",               0x20, &calculation_command},
   {"addcarry",          0xb0, &two_variables_two_arguments_command},
@@ -232,13 +276,16 @@ int main (int argc, char ** argv) {
   char * line;
   int comment_start;
   while (file_stack_length) {
-    current_line ++;
     line = get_line_from_input();
+    if (!line) {
+      pop_file();
+      continue;
+    }
+    current_line ++;
     comment_start = find_unquoted_character(line, ';');
     if (comment_start >= 0) line[comment_start] = 0;
     process_input_line(line);
-    free(line);
-    if (feof(file_stack -> fp)) pop_file();
+    arena_reset(&line_arena);
   }
   current_file = NULL;
   flush_all_symbols();
@@ -265,8 +312,52 @@ void initialize_data (void) {
   script_data = calloc(1, sizeof(struct script_data));
 }
 
+void * arena_allocate (struct arena * arena, size_t size) {
+  size = (size + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+  struct arena_block * block = arena -> blocks;
+  if (!block || (block -> used + size > block -> capacity)) {
+    size_t capacity = (size > ARENA_BLOCK_SIZE) ? size : ARENA_BLOCK_SIZE;
+    block = malloc(sizeof(struct arena_block) + capacity);
+    *block = (struct arena_block) {.next = arena -> blocks, .used = 0, .capacity = capacity};
+    arena -> blocks = block;
+  }
+  void * result = (char *) block -> data + block -> used;
+  block -> used += size;
+  return result;
+}
+
+void * arena_allocate_zeroed (struct arena * arena, size_t size) {
+  return memset(arena_allocate(arena, size), 0, size);
+}
+
+char * arena_copy_string (struct arena * arena, const char * string, size_t length) {
+  char * result = arena_allocate(arena, length + 1);
+  memcpy(result, string, length);
+  result[length] = 0;
+  return result;
+}
+
+void arena_reset (struct arena * arena) {
+  // keep the newest block, so an arena reset for every line settles into a single block
+  struct arena_block * block = arena -> blocks;
+  if (!block) return;
+  struct arena_block * next;
+  struct arena_block * old;
+  for (old = block -> next; old; old = next) {
+    next = old -> next;
+    free(old);
+  }
+  block -> next = NULL;
+  block -> used = 0;
+}
+
 void append_data_to_script (const char * data, unsigned length) {
-  script_data = realloc(script_data, sizeof(struct script_data) + script_data -> length + length);
+  if (script_data -> length + length > script_data -> capacity) {
+    unsigned capacity = script_data -> capacity ? script_data -> capacity : 4096;
+    while (capacity < script_data -> length + length) capacity *= 2;
+    script_data -> data = realloc(script_data -> data, capacity);
+    script_data -> capacity = capacity;
+  }
   memcpy(script_data -> data + script_data -> length, data, length);
   script_data -> length += length;
 }
@@ -274,16 +365,10 @@ void append_data_to_script (const char * data, unsigned length) {
 void append_binary_file_to_script (const char * file) {
   char * prev_current_file = current_file;
   current_file = NULL;
-  FILE * fp = open_binary_file(file);
-  char * buffer = malloc(65536);
-  unsigned rv;
-  while (!feof(fp)) {
-    rv = fread(buffer, 1, 65536, fp);
-    if ((!rv) && ferror(fp)) error_exit(1, "could not read data from binary file %s", file);
-    append_data_to_script(buffer, rv);
-  }
-  fclose(fp);
-  free(buffer);
+  struct mapped_file binary = map_input_file(file, 0);
+  if (binary.size > -1u - script_data -> length) error_exit(1, "binary file %s is too large", file);
+  if (binary.size) append_data_to_script(binary.data, binary.size);
+  unmap_input_file(&binary);
   current_file = prev_current_file;
 }
 
@@ -304,53 +389,102 @@ void write_number_to_buffer (unsigned char * buffer, unsigned number, unsigned c
 }
 
 struct symbol * find_symbol (const char * name) {
-  return find_identifier_by_name(name, script_data -> symbols, script_data -> symbol_count);
+  return find_in_table((*name == '.') ? &script_data -> locals : &script_data -> symbols, name);
 }
 
 struct symbol * find_definition (const char * name) {
-  return find_identifier_by_name(name, script_data -> definitions, script_data -> definition_count);
+  return find_in_table(&script_data -> definitions, name);
 }
 
-struct symbol * find_identifier_by_name (const char * identifier, struct symbol ** identifiers, unsigned count) {
-  unsigned pos;
-  for (pos = 0; pos < count; pos ++) if (!strcmp(identifiers[pos] -> name, identifier)) return identifiers[pos];
-  return NULL;
+unsigned hash_name (const char * name) {
+  unsigned hash = 2166136261u; // FNV-1a
+  for (; *name; name ++) hash = (hash ^ (unsigned char) *name) * 16777619u;
+  return hash;
+}
+
+struct symbol ** find_table_slot (const struct symbol_table * table, const char * name) {
+  unsigned mask = table -> capacity - 1, pos;
+  for (pos = hash_name(name) & mask; table -> slots[pos]; pos = (pos + 1) & mask)
+    if (!strcmp(table -> slots[pos] -> name, name)) break;
+  return table -> slots + pos;
+}
+
+struct symbol * find_in_table (const struct symbol_table * table, const char * name) {
+  if (!table -> count) return NULL;
+  return *find_table_slot(table, name);
+}
+
+void add_to_table (struct symbol_table * table, struct symbol * symbol) {
+  // keep the load factor at or below 1/2, doubling the capacity as needed
+  if ((table -> count + 1) * 2 > table -> capacity) {
+    struct symbol_table grown = {.capacity = table -> capacity ? table -> capacity * 2 : 16, .count = table -> count};
+    grown.slots = calloc(grown.capacity, sizeof(struct symbol *));
+    unsigned pos;
+    for (pos = 0; pos < table -> capacity; pos ++)
+      if (table -> slots[pos]) *find_table_slot(&grown, table -> slots[pos] -> name) = table -> slots[pos];
+    free(table -> slots);
+    *table = grown;
+  }
+  *find_table_slot(table, symbol -> name) = symbol;
+  table -> count ++;
+}
+
+void clear_table (struct symbol_table * table) {
+  // the symbols themselves belong to an arena
+  free(table -> slots);
+  *table = (struct symbol_table) {0};
 }
 
 void create_symbol (const char * name, unsigned value) {
-  script_data -> symbols = realloc(script_data -> symbols, sizeof(struct symbol *) * (script_data -> symbol_count + 1));
-  script_data -> symbols[script_data -> symbol_count ++] = new_symbol(name, value);
+  if (*name == '.')
+    add_to_table(&script_data -> locals, new_symbol(&local_arena, name, value));
+  else
+    add_to_table(&script_data -> symbols, new_symbol(&symbol_arena, name, value));
 }
 
 void create_definition (const char * name, unsigned value) {
-  script_data -> definitions = realloc(script_data -> definitions, sizeof(struct symbol *) * (script_data -> definition_count + 1));
-  script_data -> definitions[script_data -> definition_count ++] = new_symbol(name, value);
+  add_to_table(&script_data -> definitions, new_symbol(&symbol_arena, name, value));
 }
 
 void create_reference (const char * target, unsigned value) {
-  script_data -> references = realloc(script_data -> references, sizeof(struct symbol *) * (script_data -> reference_count + 1));
-  script_data -> references[script_data -> reference_count ++] = new_symbol(target, value);
+  int local = *target == '.';
+  struct symbol_table * references = local ? &script_data -> local_references : &script_data -> references;
+  struct symbol * reference = new_symbol(local ? &local_arena : &symbol_arena, target, value);
+  struct symbol * first = find_in_table(references, target);
+  if (first) {
+    reference -> next = first -> next;
+    first -> next = reference;
+  } else
+    add_to_table(references, reference);
 }
 
-struct symbol * new_symbol (const char * name, unsigned value) {
-  struct symbol * result = malloc(sizeof(struct symbol) + strlen(name) + 1);
+struct symbol * new_symbol (struct arena * arena, const char * name, unsigned value) {
+  struct symbol * result = arena_allocate(arena, sizeof(struct symbol) + strlen(name) + 1);
   result -> value = value;
+  result -> next = NULL;
   strcpy(result -> name, name);
   return result;
 }
 
-void resolve (const struct symbol * symbol) {
-  unsigned pos = 0;
-  while (pos < script_data -> reference_count) {
-    if (strcmp(symbol -> name, script_data -> references[pos] -> name)) {
-      pos ++;
+const struct symbol * resolve_references (struct symbol_table * references, const struct symbol_table * symbols) {
+  // returns the first unresolved reference, if any; references are created in order of location,
+  // and the first reference to a label heads its chain
+  unsigned pos;
+  const struct symbol * symbol;
+  const struct symbol * reference;
+  const struct symbol * unresolved = NULL;
+  for (pos = 0; pos < references -> capacity; pos ++) {
+    if (!references -> slots[pos]) continue;
+    symbol = find_in_table(symbols, references -> slots[pos] -> name);
+    if (!symbol) {
+      if (!unresolved || (references -> slots[pos] -> value < unresolved -> value)) unresolved = references -> slots[pos];
       continue;
     }
-    write_word_to_buffer(script_data -> data + script_data -> references[pos] -> value, symbol -> value);
-    free(script_data -> references[pos]);
-    script_data -> references[pos] = script_data -> references[-- script_data -> reference_count];
-    script_data -> references = realloc(script_data -> references, sizeof(struct symbol *) * script_data -> reference_count);
+    for (reference = references -> slots[pos]; reference; reference = reference -> next)
+      write_word_to_buffer(script_data -> data + reference -> value, symbol -> value);
   }
+  clear_table(references);
+  return unresolved;
 }
 
 int find_unquoted_character (const char * string, char character) {
@@ -373,10 +507,8 @@ char * trim_string (char * string) {
   while ((*string == ' ') || (*string == '\t')) string ++;
   unsigned effective_length = strlen(string);
   while (effective_length && ((string[effective_length - 1] == ' ') || (string[effective_length - 1] == '\t'))) effective_length --;
-  char * result = malloc(effective_length + 1);
-  memcpy(result, string, effective_length);
-  result[effective_length] = 0;
-  return result;
+  string[effective_length] = 0;
+  return string;
 }
 
 char * duplicate_string (const char * string) {
@@ -384,50 +516,35 @@ char * duplicate_string (const char * string) {
 }
 
 char ** extract_components_from_line (const char * line) {
-  char * copy = duplicate_string(line);
+  // the components point into a copy of the line, and everything lives in the line arena
+  char * copy = arena_copy_string(&line_arena, line, strlen(line));
   int pos = find_unquoted_character(copy, ';');
   if (pos >= 0) copy[pos] = 0;
   char * current = copy + strspn(copy, " \t");
-  if ((!*current)) {
-    free(copy);
-    return NULL;
-  }
+  if ((!*current)) return NULL;
+  unsigned components = 2;
+  const char * comma;
+  for (comma = current; (comma = strchr(comma, ',')); comma ++) components ++;
+  char ** result = arena_allocate(&line_arena, sizeof(char *) * (components + 1));
   pos = strcspn(current, " \t");
-  char ** result;
-  if (!current[pos]) {
-    result = malloc(sizeof(char *) * 2);
-    *result = duplicate_string(current);
-    result[1] = NULL;
-    return result;
-  }
-  result = malloc(sizeof(char *));
-  current[pos] = 0;
-  *result = duplicate_string(current);
-  current += pos + 1;
-  unsigned components = 1;
-  char * component;
-  while (pos >= 0) {
-    pos = find_unquoted_character(current, ',');
-    if (pos >= 0) current[pos] = 0;
-    component = trim_string(current);
-    if (pos >= 0) current += pos + 1;
-    if (*component) {
-      result = realloc(result, sizeof(char *) * (components + 1));
-      result[components ++] = component;
-    } else
-      free(component);
+  *result = current;
+  components = 1;
+  if (current[pos]) {
+    current[pos] = 0;
+    current += pos + 1;
+    char * component;
+    while (pos >= 0) {
+      pos = find_unquoted_character(current, ',');
+      if (pos >= 0) current[pos] = 0;
+      component = trim_string(current);
+      if (pos >= 0) current += pos + 1;
+      if (*component) result[components ++] = component;
+    }
   }
-  result = realloc(result, sizeof(char *) * (components + 1));
   result[components] = NULL;
   return result;
 }
 
-void destroy_component_array (char ** array) {
-  char ** current;
-  for (current = array; *current; current ++) free(*current);
-  free(array);
-}
-
 unsigned count_parameters (char ** components) {
   if (!components) return -1;
   unsigned count = 0;
@@ -450,12 +567,45 @@ unsigned convert_string_to_number (const char * string) {
   return value;
 }
 
-FILE * open_text_file (const char * file) {
-  return open_file(file, "r", "reading");
+struct mapped_file map_input_file (const char * file, int writable) {
+  // a writable mapping is private: writes only change this process's copy of the file
+  int fd = open(file, O_RDONLY);
+  if (fd < 0) error_exit(1, "could not open file %s for reading", file);
+  struct stat st;
+  if (fstat(fd, &st)) error_exit(1, "could not read data from file %s", file);
+  if (!S_ISREG(st.st_mode)) {
+    // pipes and other special files have no usable size, so they are read until EOF instead
+    struct mapped_file result = {.data = NULL, .size = 0, .mapped = 0};
+    size_t capacity = 0;
+    ssize_t rv;
+    while (1) {
+      if (result.size == capacity) {
+        capacity = capacity ? capacity * 2 : 65536;
+        result.data = realloc(result.data, capacity);
+      }
+      rv = read(fd, result.data + result.size, capacity - result.size);
+      if (rv < 0) error_exit(1, "could not read data from file %s", file);
+      if (!rv) break;
+      result.size += rv;
+    }
+    close(fd);
+    return result;
+  }
+  struct mapped_file result = {.data = NULL, .size = st.st_size, .mapped = 1};
+  if (result.size) {
+    result.data = mmap(NULL, result.size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+    if (result.data == MAP_FAILED) error_exit(1, "could not read data from file %s", file);
+  }
+  close(fd);
+  return result;
 }
 
-FILE * open_binary_file (const char * file) {
-  return open_file(file, "rb", "reading");
+void unmap_input_file (struct mapped_file * file) {
+  if (!file -> mapped)
+    free(file -> data);
+  else if (file -> data)
+    munmap(file -> data, file -> size);
+  *file = (struct mapped_file) {0};
 }
 
 FILE * open_binary_file_for_writing (const char * file) {
@@ -468,40 +618,37 @@ FILE * open_file (const char * file, const char * mode, const char * mode_descri
   return fp;
 }
 
-char * read_line (FILE * fp) {
-  char * line = NULL;
-  unsigned length = 0;
-  int c;
-  while (1) {
-    c = getc(fp);
-    if ((c == EOF) || (c == '\n')) break;
-    line = realloc(line, length + 1);
-    line[length ++] = c;
+char * get_line_from_input (void) {
+  // lines are terminated in place in the mapping; only a last line without a newline is copied
+  struct file_stack_entry * entry = file_stack;
+  if (entry -> position >= entry -> file.size) return NULL;
+  char * line = entry -> file.data + entry -> position;
+  size_t remaining = entry -> file.size - entry -> position;
+  char * end = memchr(line, '\n', remaining);
+  if (!end) {
+    entry -> position = entry -> file.size;
+    return arena_copy_string(&line_arena, line, remaining);
   }
-  line = realloc(line, length + 1);
-  line[length] = 0;
+  *end = 0;
+  entry -> position += end - line + 1;
   return line;
 }
 
-char * get_line_from_input (void) {
-  return read_line(file_stack -> fp);
-}
-
 void push_file (const char * file) {
   current_file = NULL;
-  FILE * fp = open_text_file(file);
+  struct mapped_file text = map_input_file(file, 1);
   char * filename = duplicate_string(file);
   if (file_stack_length) file_stack -> line = current_line;
   file_stack = realloc(file_stack, sizeof(struct file_stack_entry) * (file_stack_length + 1));
   memmove(file_stack + 1, file_stack, file_stack_length * sizeof(struct file_stack_entry));
   file_stack_length ++;
-  *file_stack = (struct file_stack_entry) {.fp = fp, .name = filename, .line = 0};
+  *file_stack = (struct file_stack_entry) {.file = text, .position = 0, .name = filename, .line = 0};
   current_file = filename;
   current_line = 0;
 }
 
 void pop_file (void) {
-  fclose(file_stack -> fp);
+  unmap_input_file(&file_stack -> file);
   free(file_stack -> name);
   file_stack_length --;
   memmove(file_stack, file_stack + 1, file_stack_length * sizeof(struct file_stack_entry));
@@ -534,16 +681,13 @@ void process_input_line (const char * line) {
   if (!strchr("\t ", *line)) {
     pos = strchr(line, ':');
     if (pos) {
-      copy = malloc(pos - line + 1);
-      memcpy(copy, line, pos - line);
-      copy[pos - line] = 0;
+      copy = arena_copy_string(&line_arena, line, pos - line);
       line = pos + 1;
     } else {
-      copy = duplicate_string(line);
+      copy = arena_copy_string(&line_arena, line, strlen(line));
       line = NULL;
     }
     declare_label(copy);
-    free(copy);
     if (!(line && *line)) return;
   }
   char ** components = extract_components_from_line(line);
@@ -551,7 +695,6 @@ void process_input_line (const char * line) {
   struct command * command = find_command(*components);
   if (!command) error_exit(1, "unknown command: %s", *components);
   command -> parser(command -> argument, components + 1);
-  destroy_component_array(components);
 }
 
 void declare_label (const char * label) {
@@ -575,33 +718,19 @@ struct command * find_command (const char * command_name) {
 }
 
 void flush_locals (void) {
-  unsigned pos = 0;
-  while (pos < script_data -> symbol_count) {
-    if (*(script_data -> symbols[pos] -> name) != '.') {
-      pos ++;
-      continue;
-    }
-    resolve(script_data -> symbols[pos]);
-    free(script_data -> symbols[pos]);
-    script_data -> symbols[pos] = script_data -> symbols[-- script_data -> symbol_count];
-    script_data -> symbols = realloc(script_data -> symbols, sizeof(struct symbol *) * script_data -> symbol_count);
-  }
-  for (pos = 0; pos < script_data -> reference_count; pos ++) if (*(script_data -> references[pos] -> name) == '.')
-    error_exit(1, "encountered new global label before local '%s' was resolved", script_data -> references[pos] -> name);
+  const struct symbol * unresolved = resolve_references(&script_data -> local_references, &script_data -> locals);
+  if (unresolved) error_exit(1, "encountered new global label before local '%s' was resolved", unresolved -> name);
+  clear_table(&script_data -> locals);
+  arena_reset(&local_arena);
 }
 
 void flush_all_symbols (void) {
-  unsigned pos;
-  for (pos = 0; pos < script_data -> symbol_count; pos ++) {
-    resolve(script_data -> symbols[pos]);
-    free(script_data -> symbols[pos]);
-  }
-  free(script_data -> symbols);
-  script_data -> symbols = NULL;
-  script_data -> symbol_count = 0;
-  if (script_data -> reference_count) error_exit(1, "unresolved label: %s", (**(script_data -> references)).name);
-  free(script_data -> references);
-  script_data -> references = NULL;
+  const struct symbol * unresolved = resolve_references(&script_data -> local_references, &script_data -> locals);
+  const struct symbol * unresolved_global = resolve_references(&script_data -> references, &script_data -> symbols);
+  if (!unresolved || (unresolved_global && (unresolved_global -> value < unresolved -> value))) unresolved = unresolved_global;
+  if (unresolved) error_exit(1, "unresolved label: %s", unresolved -> name);
+  clear_table(&script_data -> locals);
+  clear_table(&script_data -> symbols);
 }
 
 int validate_label (const char * label) {
@@ -618,20 +747,20 @@ struct argument * get_argument (const char * string) {
     return result;
   }
   if (strchr(NUMERIC_CHARACTERS, *string)) {
-    result = malloc(sizeof(struct argument));
+    result = arena_allocate(&line_arena, sizeof(struct argument));
     result -> kind = 0;
     result -> value = convert_string_to_number(string);
     return result;
   }
   struct symbol * definition = find_definition(string);
   if (definition) {
-    result = malloc(sizeof(struct argument));
+    result = arena_allocate(&line_arena, sizeof(struct argument));
     result -> kind = 0;
     result -> value = definition -> value;
     return result;
   }
   if (!(validate_label(string) || ((*string == '.') && validate_label(string + 1)))) error_exit(1, "invalid label identifier: %s", string);
-  result = malloc(sizeof(struct argument) + strlen(string) + 1);
+  result = arena_allocate(&line_arena, sizeof(struct argument) + strlen(string) + 1);
   result -> kind = 2;
   strcpy(result -> reference, string);
   return result;
@@ -639,7 +768,7 @@ struct argument * get_argument (const char * string) {
 
 char * get_string_argument (const char * argument) {
   if (*argument != '"') error_exit(1, "unquoted string");
-  char * result = duplicate_string(argument + 1);
+  char * result = arena_copy_string(&line_arena, argument + 1, strlen(argument + 1));
   unsigned length = strlen(result) - 1;
   if (result[length] != '"') error_exit(1, "unquoted string");
   result[length] = 0;
@@ -648,7 +777,6 @@ char * get_string_argument (const char * argument) {
     pos ++;
     memmove(pos, pos + 1, strlen(pos));
   }
-  result = realloc(result, strlen(result) + 1);
   return result;
 }
 
@@ -691,7 +819,6 @@ void one_byte_argument_command (int opcode_byte, char ** arguments) {
   char buffer[2];
   *buffer = opcode_byte + argument -> kind;
   buffer[1] = argument -> value;
-  free(argument);
   append_data_to_script(buffer, 2);
 }
 
@@ -708,7 +835,6 @@ void one_halfword_argument_command (int opcode_byte, char ** arguments) {
     write_halfword_to_buffer(buffer + 1, argument -> value);
     append_data_to_script(buffer, 3);
   }
-  free(argument);
 }
 
 void calculation_command (int opcode_byte, char ** arguments) {
@@ -721,7 +847,6 @@ void calculation_command (int opcode_byte, char ** arguments) {
   char buffer[7];
   *buffer = opcode_byte + 2;
   buffer[1] = buffer[2] = argument -> value;
-  free(argument);
   argument = get_argument(arguments[1]);
   switch (argument -> kind) {
     case 0:
@@ -738,7 +863,6 @@ void calculation_command (int opcode_byte, char ** arguments) {
       create_reference(argument -> reference, script_data -> length + 3);
       append_data_to_script(buffer, 7);
   }
-  free(argument);
 }
 
 void bit_shift_command (int bit_shift_type, char ** arguments) {
@@ -756,14 +880,12 @@ void bit_shift_command (int bit_shift_type, char ** arguments) {
   struct argument * argument = get_argument(*arguments);
   if (argument -> kind != 1) error_exit(1, "argument must be a variable");
   unsigned char variable = argument -> value;
-  free(argument);
   unsigned char shift_type, shift_count;
   argument = get_argument(arguments[shorthand ? 1 : 2]);
   if (argument -> kind == 2) error_exit(1, "cannot use a reference as a shift count");
   if ((!argument -> kind) && (argument -> value > 31) && (argument -> value < -31u)) error_exit(1, "shift count must be between -31 and 31");
   shift_type = argument -> kind;
   shift_count = argument -> value;
-  free(argument);
   if (!shift_type) shift_count &= 31;
   argument = shorthand ? NULL : get_argument(arguments[1]);
   unsigned char buffer[8];
@@ -796,7 +918,6 @@ void bit_shift_command (int bit_shift_type, char ** arguments) {
         memset(buffer + buffer_length, 0, 4);
         buffer_length += 4;
     }
-  free(argument);
   if (shift_type) buffer[buffer_length ++] = shift_count;
   append_data_to_script((char *) buffer, buffer_length);
 }
@@ -820,12 +941,10 @@ void one_argument_one_byte_argument (int opcode_byte, char ** arguments) {
       memset(buffer, 0, 4);
       current += 4;
   }
-  free(argument);
   argument = get_argument(arguments[1]);
   if (argument -> kind == 2) error_exit(1, "cannot use a reference as a byte-sized argument");
   opcode_byte += argument -> kind;
   *(current ++) = argument -> value;
-  free(argument);
   *buffer = opcode_byte;
   append_data_to_script(buffer, current - buffer);
 }
@@ -849,7 +968,6 @@ void one_argument_one_halfword_argument (int opcode_byte, char ** arguments) {
       memset(buffer, 0, 4);
       current += 4;
   }
-  free(argument);
   argument = get_argument(arguments[1]);
   if (argument -> kind == 2) error_exit(1, "cannot use a reference as a halfword-sized argument");
   opcode_byte += argument -> kind;
@@ -859,7 +977,6 @@ void one_argument_one_halfword_argument (int opcode_byte, char ** arguments) {
     write_halfword_to_buffer(current, argument -> value);
     current += 2;
   }
-  free(argument);
   *buffer = opcode_byte;
   append_data_to_script(buffer, current - buffer);
 }
@@ -873,7 +990,6 @@ void mulacum_command (int opcode_byte, char ** arguments) {
   *buffer = opcode_byte;
   if (argument -> kind != 1) error_exit(1, "argument must be a variable");
   buffer[1] = buffer[2] = argument -> value;
-  free(argument);
   while (arg_number --) {
     argument = get_argument(*(arguments ++));
     switch (argument -> kind) {
@@ -890,7 +1006,6 @@ void mulacum_command (int opcode_byte, char ** arguments) {
         memset(current, 0, 4);
         current += 4;
     }
-    free(argument);
   }
   append_data_to_script(buffer, current - buffer);
 }
@@ -899,14 +1014,13 @@ void standard_command (unsigned char opcode_byte, unsigned char expected_variabl
   unsigned temp = count_parameters(arguments);
   if (temp != (expected_variable_count + expected_argument_count))
     error_exit(1, "command expects %hhu argument(s), got %u", expected_variable_count + expected_argument_count, temp);
-  unsigned char * buffer = calloc(1, 1 + expected_variable_count + 4 * expected_argument_count);
+  unsigned char * buffer = arena_allocate_zeroed(&line_arena, 1 + expected_variable_count + 4 * expected_argument_count);
   unsigned char * current = buffer + 1;
   struct argument * argument;
   while (expected_variable_count --) {
     argument = get_argument(*(arguments ++));
     if (argument -> kind != 1) error_exit(1, "argument must be a variable");
     *(current ++) = argument -> value;
-    free(argument);
   }
   while (expected_argument_count --) {
     argument = get_argument(*(arguments ++));
@@ -923,11 +1037,9 @@ void standard_command (unsigned char opcode_byte, unsigned char expected_variabl
         create_reference(argument -> reference, script_data -> length + (current - buffer));
         current += 4;
     }
-    free(argument);
   }
   *buffer = opcode_byte;
   append_data_to_script((char *) buffer, current - buffer);
-  free(buffer);
 }
 
 void data_command (int width, char ** arguments) {
@@ -941,7 +1053,6 @@ void data_command (int width, char ** arguments) {
       memset(buffer, 0, 4);
       length = strlen(string);
       append_data_to_script(string, length);
-      free(string);
       if (length % width) append_data_to_script(buffer, width - (length % width));
       continue;
     }
@@ -960,7 +1071,6 @@ void data_command (int width, char ** arguments) {
         create_reference(argument -> reference, script_data -> length);
         append_data_to_script(buffer, 4);
     }
-    free(argument);
   }
 }
 
@@ -971,11 +1081,10 @@ void hexdata_command (__attribute__((unused)) int _, char ** arguments) {
     if (strspn(arguments[argument_number], "0123456789abcdefABCDEF") != strlen(arguments[argument_number]))
       error_exit(1, "argument %u to hexdata is not a valid hex string", argument_number + 1);
     length = (strlen(arguments[argument_number]) + 1) >> 1;
-    buffer = malloc(length);
+    buffer = arena_allocate(&line_arena, length);
     for (pos = 0; pos < length; pos ++)
       buffer[pos] = (get_hex_digit(arguments[argument_number][pos << 1]) << 4) | get_hex_digit(arguments[argument_number][(pos << 1) + 1]);
     append_data_to_script(buffer, length);
-    free(buffer);
   }
 }
 
@@ -985,7 +1094,6 @@ void define_command (__attribute__((unused)) int _, char ** arguments) {
   struct argument * argument = get_argument(arguments[1]);
   if (argument -> kind) error_exit(1, "the second argument to define must be a number (got: %s)", arguments[1]);
   unsigned value = argument -> value;
-  free(argument);
   struct symbol * definition = find_definition(*arguments);
   if (definition)
     definition -> value = value;
@@ -1000,7 +1108,6 @@ void include_command (int is_binary, char ** arguments) {
     append_binary_file_to_script(filename);
   else
     push_file(filename);
-  free(filename);
 }
 
 void string_command (__attribute__((unused)) int _, char ** arguments) {
@@ -1008,7 +1115,6 @@ void string_command (__attribute__((unused)) int _, char ** arguments) {
   for (; *arguments; arguments ++) {
     string = get_string_argument(*arguments);
     append_data_to_script(string, strlen(string) + 1);
-    free(string);
   }
 }
 
@@ -1017,10 +1123,7 @@ void align_command (__attribute__((unused)) int _, char ** arguments) {
   struct argument * argument = get_argument(*arguments);
   if (argument -> kind || !(argument -> value)) error_exit(1, "the argument to align must be a non-zero number (got: %s)", *arguments);
   unsigned alignment = argument -> value;
-  free(argument);
   if (!(script_data -> length % alignment)) return;
   alignment -= script_data -> length % alignment;
-  void * padding = calloc(alignment, 1);
-  append_data_to_script(padding, alignment);
-  free(padding);
+  append_data_to_script(arena_allocate_zeroed(&line_arena, alignment), alignment);
 }
@@ -0,0 +1,297 @@
+#define PROGRAM_NAME "collision_asm2bin"
+#define USAGE_OPTS "[-h|--help] [-c|--constants file.asm] [-m|--macros file.asm] [-o|--output out.bin] collision.asm..."
+
+#include "common.h"
+#include "mapdata.h"
+
+struct Options {
+	const char *constants_filename;
+	const char *macros_filename;
+	const char *out_filename;
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"constants", required_argument, 0, 'c'},
+		{"macros", required_argument, 0, 'm'},
+		{"output", required_argument, 0, 'o'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "c:m:o:h", long_options)) != -1;) {
+		switch (opt) {
+		case 'c':
+			options->constants_filename = optarg;
+			break;
+		case 'm':
+			options->macros_filename = optarg;
+			break;
+		case 'o':
+			options->out_filename = optarg;
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+#define COLLISION_CONSTANTS_FILE "constants/collision_constants.asm"
+#define COLLISION_MACROS_FILE "macros/collision.asm"
+#define MAX_MACRO_ARGS 9
+
+struct Symbol {
+	char *name;
+	int value;
+};
+
+// A macro whose body is only "db" lines, like tilecoll
+struct Macro {
+	char *name;
+	char **lines; // "db" arguments, with "\1" to "\9" still unexpanded
+	int num_lines;
+};
+
+struct Assembler {
+	struct Symbol *symbols;
+	int num_symbols;
+	struct Macro *macros;
+	int num_macros;
+};
+
+int compare_symbols(const void *a, const void *b) {
+	return strcmp(((const struct Symbol *)a)->name, ((const struct Symbol *)b)->name);
+}
+
+int compare_symbol_key(const void *key, const void *symbol) {
+	return strcmp(key, ((const struct Symbol *)symbol)->name);
+}
+
+// Reads "DEF NAME EQU value" lines; collision constants are all plain numbers
+void read_constants(struct Assembler *assembler, const char *filename) {
+	char *text = read_text(filename);
+	char *cursor = text;
+	for (char *line; (line = next_line(&cursor));) {
+		char *def = macro_args(line, "DEF");
+		char *equ = def ? strstr(def, " EQU ") : NULL;
+		if (!equ) {
+			continue;
+		}
+		size_t len = strcspn(def, " \t");
+		char *value = equ + strlen(" EQU ");
+		value += strspn(value, " \t");
+		if (*value != '$' && *value != '%' && !isdigit((unsigned)*value)) {
+			error_exit("%s: unsupported constant value: %s\n", filename, line);
+		}
+		assembler->symbols = xrealloc(assembler->symbols, (assembler->num_symbols + 1) * sizeof(*assembler->symbols));
+		assembler->symbols[assembler->num_symbols++] = (struct Symbol){
+			.name = xstrndup(def, len),
+			.value = parse_asm_number(value),
+		};
+	}
+	free(text);
+	qsort(assembler->symbols, assembler->num_symbols, sizeof(*assembler->symbols), compare_symbols);
+}
+
+void read_macros(struct Assembler *assembler, const char *filename) {
+	char *text = read_text(filename);
+	char *cursor = text;
+	struct Macro *macro = NULL;
+	for (char *line; (line = next_line(&cursor));) {
+		char *args;
+		if ((args = macro_args(line, "MACRO"))) {
+			assembler->macros = xrealloc(assembler->macros, (assembler->num_macros + 1) * sizeof(*assembler->macros));
+			macro = &assembler->macros[assembler->num_macros++];
+			*macro = (struct Macro){.name = xstrdup(args)};
+		} else if (!strcmp(line + strspn(line, " \t"), "ENDM")) {
+			macro = NULL;
+		} else if (macro && (args = macro_args(line, "db"))) {
+			macro->lines = xrealloc(macro->lines, (macro->num_lines + 1) * sizeof(*macro->lines));
+			macro->lines[macro->num_lines++] = xstrdup(args);
+		} else if (macro && *line) {
+			error_exit("%s: unsupported line in macro %s: %s\n", filename, macro->name, line);
+		}
+	}
+	free(text);
+}
+
+const struct Macro *find_macro(const struct Assembler *assembler, const char *name, size_t len) {
+	for (int i = 0; i < assembler->num_macros; i++) {
+		if (strlen(assembler->macros[i].name) == len && !strncmp(assembler->macros[i].name, name, len)) {
+			return &assembler->macros[i];
+		}
+	}
+	return NULL;
+}
+
+// Evaluates a number, a constant, or several of them joined by "+" or "|".
+// As in rgbasm, "|" binds looser than "+"; any other operator is an error.
+int evaluate(const struct Assembler *assembler, const char *expr, const char *filename, int lineno) {
+	int value = 0, sum = 0;
+	for (const char *term = expr;;) {
+		term += strspn(term, " \t");
+		size_t len = strcspn(term, " \t+|");
+		char name[0x100];
+		if (!len || len >= sizeof(name)) {
+			error_exit("%s:%d: invalid expression: %s\n", filename, lineno, expr);
+		}
+		memcpy(name, term, len);
+		name[len] = '\0';
+
+		int term_value;
+		if (*name == '$' || *name == '%' || isdigit((unsigned)*name)) {
+			term_value = parse_asm_number(name);
+		} else {
+			const struct Symbol *symbol = bsearch(name, assembler->symbols, assembler->num_symbols,
+				sizeof(*assembler->symbols), compare_symbol_key);
+			if (!symbol) {
+				error_exit("%s:%d: unknown symbol \"%s\"\n", filename, lineno, name);
+			}
+			term_value = symbol->value;
+		}
+		sum += term_value;
+
+		term += len;
+		term += strspn(term, " \t");
+		if (!*term) {
+			return value | sum;
+		}
+		if (*term == '|') {
+			value |= sum;
+			sum = 0;
+		} else if (*term != '+') {
+			error_exit("%s:%d: unsupported operator '%c' in expression: %s\n", filename, lineno, *term, expr);
+		}
+		term++;
+	}
+}
+
+void emit_db(const struct Assembler *assembler, char *args, const char *filename, int lineno,
+	uint8_t **output, long *size) {
+	char *argv[0x100];
+	int argc = split_args(args, argv, COUNTOF(argv));
+	for (int i = 0; i < argc; i++) {
+		int value = evaluate(assembler, argv[i], filename, lineno);
+		if (value < -0x80 || value > 0xff) {
+			error_exit("%s:%d: value does not fit in a byte: %s\n", filename, lineno, argv[i]);
+		}
+		*output = xrealloc(*output, *size + 1);
+		(*output)[(*size)++] = (uint8_t)value;
+	}
+}
+
+// Substitutes "\1" to "\9" in a macro line with the arguments it was called with
+char *expand_macro_line(const char *line, char *argv[], int argc, const char *filename, int lineno) {
+	size_t cap = strlen(line) + 1;
+	for (int i = 0; i < argc; i++) {
+		cap += strlen(argv[i]) * 4;
+	}
+	char *expanded = xmalloc(cap);
+	size_t len = 0;
+	for (const char *c = line; *c; c++) {
+		if (*c == '\\' && c[1] >= '1' && c[1] <= '9') {
+			int arg = c[1] - '1';
+			if (arg >= argc) {
+				error_exit("%s:%d: macro argument \\%c is missing\n", filename, lineno, c[1]);
+			}
+			size_t arg_len = strlen(argv[arg]);
+			if (len + arg_len + strlen(c) >= cap) {
+				cap = len + arg_len + strlen(c) + 1;
+				expanded = xrealloc(expanded, cap);
+			}
+			memcpy(expanded + len, argv[arg], arg_len);
+			len += arg_len;
+			c++;
+		} else {
+			expanded[len++] = *c;
+		}
+	}
+	expanded[len] = '\0';
+	return expanded;
+}
+
+uint8_t *assemble(const struct Assembler *assembler, const char *filename, long *size) {
+	char *text = read_text(filename);
+	char *cursor = text;
+	uint8_t *output = NULL;
+	*size = 0;
+	int lineno = 0;
+	for (char *line; (line = next_line(&cursor));) {
+		lineno++;
+		line += strspn(line, " \t");
+		if (!*line) {
+			continue;
+		}
+		char *args = macro_args(line, "db");
+		if (args) {
+			emit_db(assembler, args, filename, lineno, &output, size);
+			continue;
+		}
+		size_t len = strcspn(line, " \t");
+		const struct Macro *macro = find_macro(assembler, line, len);
+		if (!macro) {
+			error_exit("%s:%d: unsupported line: %s\n", filename, lineno, line);
+		}
+		char *argv[MAX_MACRO_ARGS];
+		int argc = line[len] ? split_args(line + len, argv, MAX_MACRO_ARGS) : 0;
+		for (int i = 0; i < macro->num_lines; i++) {
+			char *expanded = expand_macro_line(macro->lines[i], argv, argc, filename, lineno);
+			emit_db(assembler, expanded, filename, lineno, &output, size);
+			free(expanded);
+		}
+	}
+	free(text);
+	return output;
+}
+
+int main(int argc, char *argv[]) {
+	struct Options options = {
+		.constants_filename = COLLISION_CONSTANTS_FILE,
+		.macros_filename = COLLISION_MACROS_FILE,
+	};
+	parse_args(argc, argv, &options);
+
+	argc -= optind;
+	argv += optind;
+	if (argc < 1 || (options.out_filename && argc != 1)) {
+		usage_exit(1);
+	}
+
+	struct Assembler assembler = {0};
+	read_constants(&assembler, options.constants_filename);
+	read_macros(&assembler, options.macros_filename);
+
+	for (int i = 0; i < argc; i++) {
+		long size;
+		uint8_t *data = assemble(&assembler, argv[i], &size);
+		if (options.out_filename) {
+			write_if_changed(options.out_filename, data, size);
+		} else {
+			size_t len = strlen(argv[i]);
+			if (len < 4 || strcmp(argv[i] + len - 4, ".asm")) {
+				error_exit("%s: expected a .asm file\n", argv[i]);
+			}
+			char *out_filename = xstrdup(argv[i]);
+			strcpy(out_filename + len - 4, ".bin");
+			write_if_changed(out_filename, data, size);
+			free(out_filename);
+		}
+		free(data);
+	}
+
+	for (int i = 0; i < assembler.num_symbols; i++) {
+		free(assembler.symbols[i].name);
+	}
+	for (int i = 0; i < assembler.num_macros; i++) {
+		for (int j = 0; j < assembler.macros[i].num_lines; j++) {
+			free(assembler.macros[i].lines[j]);
+		}
+		free(assembler.macros[i].lines);
+		free(assembler.macros[i].name);
+	}
+	free(assembler.symbols);
+	free(assembler.macros);
+	return 0;
+}
@@ -114,6 +114,26 @@ void write_u8(const char *filename, uint8_t *data, size_t size) {
 	fclose(f);
 }
 
+// Leaves unchanged outputs alone, so their timestamps do not trigger rebuilds
+void write_if_changed(const char *filename, uint8_t *data, long size) {
+	FILE *f = fopen(filename, "rb");
+	if (f) {
+		long old_size = xfsize(filename, f);
+		bool same = old_size == size;
+		if (same && size) {
+			uint8_t *old = xmalloc(size);
+			xfread(old, size, filename, f);
+			same = !memcmp(old, data, size);
+			free(old);
+		}
+		fclose(f);
+		if (same) {
+			return;
+		}
+	}
+	write_u8(filename, data, size);
+}
+
 uint32_t read_png_width(const char *filename) {
 	FILE *f = xfopen(filename, 'r');
 	uint8_t header[16] = {0};
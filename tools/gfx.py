@@ -522,18 +522,18 @@ def convert_2bpp_to_png(image, **kwargs):
 def get_pic_animation(tmap, w, h):
     """
     Generate pic animation data from a combined tilemap of each frame.
+    Returns the frame pointer table, the frame data it points into,
+    and the bitmasks, as tools/pokemon_front writes them to
+    frames.asm, frames.bin, and bitmask.bin.
     """
     frame_text = ''
-    bitmask_text = ''
+    frame_data = []
 
     frames = list(split(tmap, w * h))
     base = frames.pop(0)
     bitmasks = []
 
-    for i in xrange(len(frames)):
-        frame_text += '\tdw .frame{}\n'.format(i + 1)
-
-    for i, frame in enumerate(frames):
+    for frame in frames:
         bitmask = map(operator.ne, frame, base)
         if bitmask not in bitmasks:
             bitmasks.append(bitmask)
@@ -542,20 +542,17 @@ def get_pic_animation(tmap, w, h):
         mask = iter(bitmask)
         masked_frame = filter(lambda _: mask.next(), frame)
 
-        frame_text += '.frame{}\n'.format(i + 1)
-        frame_text += '\tdb ${:02x} ; bitmask\n'.format(which_bitmask)
-        if masked_frame:
-            frame_text += '\tdb {}\n'.format(', '.join(
-                map('${:02x}'.format, masked_frame)
-            ))
+        frame_text += '\tdw .frames + {}\n'.format(len(frame_data))
+        frame_data += [which_bitmask] + masked_frame
 
-    for i, bitmask in enumerate(bitmasks):
-        bitmask_text += '; {}\n'.format(i)
-        for byte in split(bitmask, 8):
-            byte = int(''.join(map(int.__repr__, reversed(byte))), 2)
-            bitmask_text += '\tdb %{:08b}\n'.format(byte)
+    bitmask_data = []
+    for bitmask in bitmasks:
+        bitmask_data.append([
+            int(''.join(map(int.__repr__, reversed(byte))), 2)
+            for byte in split(bitmask, 8)
+        ])
 
-    return frame_text, bitmask_text
+    return frame_text, frame_data, bitmask_data
 
 
 def export_png_to_2bpp(filein, fileout=None, palout=None, **kwargs):
@@ -579,23 +576,25 @@ def export_png_to_2bpp(filein, fileout=None, palout=None, **kwargs):
 
     if tmap != None and arguments['animate'] and arguments['pic_dimensions']:
         # Generate pic animation data.
-        frame_text, bitmask_text = get_pic_animation(tmap, *arguments['pic_dimensions'])
+        frame_text, frame_data, bitmask_data = get_pic_animation(tmap, *arguments['pic_dimensions'])
+
+        frames_bin_path = os.path.join(os.path.split(fileout)[0], 'frames.bin')
+        to_file(frames_bin_path, frame_data)
 
+        if frame_data:
+            frame_text += '.frames\n\tINCBIN "{}"\n'.format(frames_bin_path)
         frames_path = os.path.join(os.path.split(fileout)[0], 'frames.asm')
         with open(frames_path, 'w') as out:
             out.write(frame_text)
 
-        bitmask_path = os.path.join(os.path.split(fileout)[0], 'bitmask.asm')
+        bitmask_path = os.path.join(os.path.split(fileout)[0], 'bitmask.bin')
 
         # The following Pokemon have a bitmask dummied out.
         for exception in arguments['stupid_bitmask_hack']:
            if exception in bitmask_path:
-                bitmasks = bitmask_text.split(';')
-                bitmasks[-1] = bitmasks[-1].replace('1', '0')
-                bitmask_text = ';'.join(bitmasks)
+                bitmask_data[-1] = [0] * len(bitmask_data[-1])
 
-        with open(bitmask_path, 'w') as out:
-            out.write(bitmask_text)
+        to_file(bitmask_path, sum(bitmask_data, []))
 
     elif tmap != None and arguments.get('tilemap', False):
         tilemap_path = os.path.splitext(fileout)[0] + '.tilemap'
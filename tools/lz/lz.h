@@ -0,0 +1,37 @@
+// The compression engine without lzcomp's command line, for other tools to build with:
+// lz/dpcomp.c, lz/global.c and lz/command.c need nothing from the rest of lz/
+#ifndef LZ_H
+#define LZ_H
+
+#define MAX_FILE_SIZE            32768
+#define SHORT_COMMAND_COUNT         32
+#define MAX_COMMAND_COUNT          512
+#define LOOKBACK_LIMIT             128 /* highest negative valid count for a copy command */
+
+#define LZ_DATA          0 /* Read literal data for n bytes.   */
+#define LZ_REPEAT        1 /* Write the same byte for n bytes. */
+#define LZ_ALTERNATE     2 /* Alternate two bytes for n bytes. */
+#define LZ_ZERO          3 /* Write 0 for n bytes.             */
+#define LZ_COPY_NORMAL   4 /* Repeat n bytes from the offset.  */
+#define LZ_COPY_FLIPPED  5 /* Repeat n bitflipped bytes.       */
+#define LZ_COPY_REVERSED 6 /* Repeat n bytes in reverse.       */
+#define LZ_LONG          7 /* Expand n to 9 bits               */
+
+struct command {
+  unsigned command: 3; // commands 0-6 as per compression spec; command 7 is used as a dummy placeholder
+  unsigned count:  12; // always equals the uncompressed data length
+  signed value:    17; // offset for commands 0 (into source) and 4-6 (into decompressed output); repeated bytes for commands 1-2
+};
+
+// global.c
+extern const unsigned char bit_flipping_table[];
+
+// command.c
+unsigned minimum_count(unsigned command);
+short command_size(struct command);
+unsigned short compressed_length(const struct command *, unsigned short);
+
+// dpcomp.c
+struct command * compress_dp(const unsigned char * data, const unsigned char * bitflipped, unsigned short * size);
+
+#endif
@@ -21,26 +21,3 @@ unsigned char * read_file_into_buffer (const char * file, unsigned short * size)
   *size = rv;
   return buf;
 }
-
-unsigned minimum_count (unsigned command) {
-  switch (command) {
-    case LZ_ALTERNATE:
-        return 3;
-    case LZ_REPEAT:
-        return 2;
-    default:
-        return 1;
-  }
-}
-
-short command_size (struct command command) {
-  short header_size = 1 + (command.count - minimum_count(command.command) > SHORT_COMMAND_COUNT - 1);
-  if (command.command & 4) return header_size + 1 + (command.value >= 0);
-  return header_size + command.command[(short []) {command.count, 1, 2, 0}];
-}
-
-unsigned short compressed_length (const struct command * commands, unsigned short count) {
-  unsigned short current, total = 0;
-  for (current = 0; current < count; current ++) if (commands[current].command != 7) total += command_size(commands[current]);
-  return total;
-}
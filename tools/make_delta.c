@@ -0,0 +1,523 @@
+#define PROGRAM_NAME "make_delta"
+#define USAGE_OPTS "[-h|--help] [-i|--ips] [-s|--stats] source.gbc target.gbc output.bps|output.ips"
+
+#include "common.h"
+#include "mapdata.h"
+
+#include <time.h>
+
+#define HASH_BITS 20
+#define HASH_SIZE (1 << HASH_BITS)
+#define HASH_BYTES 4 // bytes hashed at each position
+#define MAX_CHAIN 64 // candidates checked per position
+#define MIN_COPY 6 // shorter copies cost more than their literal bytes
+#define MIN_SOURCE_READ 3
+#define LONG_SOURCE_READ 32 // source reads this long are taken without looking for copies
+
+#define IPS_MAX_OFFSET 0xffffff
+#define IPS_EOF_OFFSET 0x454f46 // "EOF" cannot be a record offset
+#define IPS_MAX_RECORD 0xffff
+#define IPS_MIN_RLE 9 // an RLE record is 8 bytes
+
+struct Options {
+	bool ips;
+	bool stats;
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"ips", no_argument, 0, 'i'},
+		{"stats", no_argument, 0, 's'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "ish", long_options)) != -1;) {
+		switch (opt) {
+		case 'i':
+			options->ips = true;
+			break;
+		case 's':
+			options->stats = true;
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+struct Bytes {
+	uint8_t *data;
+	size_t size;
+	size_t capacity;
+};
+
+void put_byte(struct Bytes *bytes, uint8_t byte) {
+	if (bytes->size >= bytes->capacity) {
+		bytes->capacity = bytes->capacity ? bytes->capacity * 2 : 0x1000;
+		bytes->data = xrealloc(bytes->data, bytes->capacity);
+	}
+	bytes->data[bytes->size++] = byte;
+}
+
+void put_bytes(struct Bytes *bytes, const uint8_t *data, size_t size) {
+	for (size_t i = 0; i < size; i++) {
+		put_byte(bytes, data[i]);
+	}
+}
+
+void put_u32(struct Bytes *bytes, uint32_t n) {
+	for (int i = 0; i < 4; i++) {
+		put_byte(bytes, (n >> (i * 8)) & 0xff);
+	}
+}
+
+uint32_t crc32(const uint8_t *data, size_t size) {
+	static uint32_t table[256];
+	static bool initialized = false;
+	if (!initialized) {
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t c = i;
+			for (int k = 0; k < 8; k++) {
+				c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+			}
+			table[i] = c;
+		}
+		initialized = true;
+	}
+	uint32_t crc = 0xffffffffu;
+	for (size_t i = 0; i < size; i++) {
+		crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+// Chains of positions whose next HASH_BYTES bytes share a hash, most recently added first
+struct HashChains {
+	const uint8_t *data;
+	int32_t *heads; // latest position per hash, or -1
+	int32_t *prev; // previous position with the same hash, or -1
+};
+
+uint32_t hash_at(const uint8_t *data) {
+	uint32_t n = data[0] | data[1] << 8 | data[2] << 16 | (uint32_t)data[3] << 24;
+	return (n * 2654435761u) >> (32 - HASH_BITS);
+}
+
+void init_chains(struct HashChains *chains, const uint8_t *data, size_t size) {
+	chains->data = data;
+	chains->heads = xmalloc(HASH_SIZE * sizeof(*chains->heads));
+	memset(chains->heads, 0xff, HASH_SIZE * sizeof(*chains->heads));
+	chains->prev = xmalloc((size ? size : 1) * sizeof(*chains->prev));
+}
+
+void add_chain(struct HashChains *chains, size_t pos) {
+	uint32_t hash = hash_at(&chains->data[pos]);
+	chains->prev[pos] = chains->heads[hash];
+	chains->heads[hash] = (int32_t)pos;
+}
+
+void free_chains(struct HashChains *chains) {
+	free(chains->heads);
+	free(chains->prev);
+}
+
+size_t match_length(const uint8_t *a, const uint8_t *b, size_t limit) {
+	size_t n = 0;
+	while (n < limit && a[n] == b[n]) {
+		n++;
+	}
+	return n;
+}
+
+// Finds the longest match for target[pos...] among the first MAX_CHAIN chained positions
+size_t longest_match(const struct HashChains *chains, size_t chain_size, const uint8_t *target, size_t pos, size_t target_size, size_t *match_pos) {
+	size_t best = 0;
+	int checked = 0;
+	for (int32_t candidate = chains->heads[hash_at(&target[pos])]; candidate != -1 && checked < MAX_CHAIN; candidate = chains->prev[candidate], checked++) {
+		// Target copies may overlap the bytes being written, so they can run up to the end of the target
+		size_t limit = target_size - pos;
+		if (chains->data != target && chain_size - candidate < limit) {
+			limit = chain_size - candidate;
+		}
+		size_t length = match_length(&chains->data[candidate], &target[pos], limit);
+		if (length > best) {
+			best = length;
+			*match_pos = candidate;
+			if (length == limit) {
+				break;
+			}
+		}
+	}
+	return best;
+}
+
+enum BPSAction { BPS_SOURCE_READ, BPS_TARGET_READ, BPS_SOURCE_COPY, BPS_TARGET_COPY };
+
+void put_bps_number(struct Bytes *patch, uint64_t n) {
+	for (;;) {
+		uint8_t x = n & 0x7f;
+		n >>= 7;
+		if (!n) {
+			put_byte(patch, 0x80 | x);
+			break;
+		}
+		put_byte(patch, x);
+		n--;
+	}
+}
+
+void put_bps_action(struct Bytes *patch, enum BPSAction action, size_t length) {
+	put_bps_number(patch, ((uint64_t)(length - 1) << 2) | action);
+}
+
+void put_bps_offset(struct Bytes *patch, int64_t offset) {
+	put_bps_number(patch, (uint64_t)(offset < 0 ? -offset : offset) << 1 | (offset < 0));
+}
+
+struct BPSStats {
+	size_t actions[4];
+	size_t bytes[4];
+};
+
+void flush_target_read(struct Bytes *patch, const uint8_t *target, size_t *literal_start, size_t pos, struct BPSStats *stats) {
+	if (*literal_start < pos) {
+		put_bps_action(patch, BPS_TARGET_READ, pos - *literal_start);
+		put_bytes(patch, &target[*literal_start], pos - *literal_start);
+		stats->actions[BPS_TARGET_READ]++;
+		stats->bytes[BPS_TARGET_READ] += pos - *literal_start;
+	}
+	*literal_start = pos;
+}
+
+// Greedily covers the target with reads of the source at the same offset, copies from anywhere
+// in the source (so relocated banks cost one command), copies of earlier target data, and literals
+void make_bps(struct Bytes *patch, const uint8_t *source, size_t source_size, const uint8_t *target, size_t target_size, struct BPSStats *stats) {
+	put_bytes(patch, (const uint8_t *)"BPS1", 4);
+	put_bps_number(patch, source_size);
+	put_bps_number(patch, target_size);
+	put_bps_number(patch, 0); // no metadata
+
+	struct HashChains source_chains, target_chains;
+	init_chains(&source_chains, source, source_size);
+	init_chains(&target_chains, target, target_size);
+	// Index the source backwards, so each chain lists positions from first to last
+	for (size_t i = source_size >= HASH_BYTES ? source_size - HASH_BYTES + 1 : 0; i-- > 0;) {
+		add_chain(&source_chains, i);
+	}
+
+	size_t source_relative = 0, target_relative = 0;
+	size_t literal_start = 0;
+	size_t indexed = 0; // target positions below this are in target_chains
+	for (size_t pos = 0; pos < target_size;) {
+		size_t read_length = pos < source_size
+			? match_length(&source[pos], &target[pos], (source_size < target_size ? source_size : target_size) - pos) : 0;
+		size_t source_pos = 0, source_length = 0, target_pos = 0, target_length = 0;
+		if (read_length < LONG_SOURCE_READ && pos + HASH_BYTES <= target_size) {
+			source_length = longest_match(&source_chains, source_size, target, pos, target_size, &source_pos);
+			target_length = longest_match(&target_chains, target_size, target, pos, target_size, &target_pos);
+		}
+
+		enum BPSAction action = BPS_TARGET_READ;
+		size_t length = 1;
+		// A source read has no offset to encode, so it wins unless a copy is clearly longer
+		if (read_length >= MIN_SOURCE_READ && read_length + MIN_SOURCE_READ >= source_length && read_length + MIN_SOURCE_READ >= target_length) {
+			action = BPS_SOURCE_READ;
+			length = read_length;
+		} else if (source_length >= MIN_COPY && source_length >= target_length) {
+			action = BPS_SOURCE_COPY;
+			length = source_length;
+		} else if (target_length >= MIN_COPY) {
+			action = BPS_TARGET_COPY;
+			length = target_length;
+		}
+
+		if (action != BPS_TARGET_READ) {
+			flush_target_read(patch, target, &literal_start, pos, stats);
+			put_bps_action(patch, action, length);
+			if (action == BPS_SOURCE_COPY) {
+				put_bps_offset(patch, (int64_t)source_pos - (int64_t)source_relative);
+				source_relative = source_pos + length;
+			} else if (action == BPS_TARGET_COPY) {
+				put_bps_offset(patch, (int64_t)target_pos - (int64_t)target_relative);
+				target_relative = target_pos + length;
+			}
+			stats->actions[action]++;
+			stats->bytes[action] += length;
+			literal_start = pos + length;
+		}
+		pos += length;
+		for (; indexed < pos && indexed + HASH_BYTES <= target_size; indexed++) {
+			add_chain(&target_chains, indexed);
+		}
+	}
+	flush_target_read(patch, target, &literal_start, target_size, stats);
+
+	free_chains(&source_chains);
+	free_chains(&target_chains);
+
+	put_u32(patch, crc32(source, source_size));
+	put_u32(patch, crc32(target, target_size));
+	put_u32(patch, crc32(patch->data, patch->size));
+}
+
+uint64_t read_bps_number(const uint8_t *patch, size_t size, size_t *pos) {
+	uint64_t n = 0, shift = 1;
+	for (;;) {
+		if (*pos >= size) {
+			error_exit("Verify: truncated BPS patch\n");
+		}
+		uint8_t x = patch[(*pos)++];
+		n += (x & 0x7f) * shift;
+		if (x & 0x80) {
+			return n;
+		}
+		shift <<= 7;
+		n += shift;
+	}
+}
+
+// Applies a BPS patch and returns the target, checking every copy and checksum
+uint8_t *apply_bps(const uint8_t *patch, size_t patch_size, const uint8_t *source, size_t source_size, size_t *target_size) {
+	if (patch_size < 16 || memcmp(patch, "BPS1", 4)) {
+		error_exit("Verify: not a BPS patch\n");
+	}
+	size_t end = patch_size - 12, pos = 4;
+	if (read_bps_number(patch, end, &pos) != source_size) {
+		error_exit("Verify: BPS source size mismatch\n");
+	}
+	size_t size = read_bps_number(patch, end, &pos);
+	pos += read_bps_number(patch, end, &pos); // skip metadata
+	uint8_t *target = xmalloc(size ? size : 1);
+	size_t out = 0;
+	int64_t source_relative = 0, target_relative = 0;
+	while (pos < end) {
+		uint64_t data = read_bps_number(patch, end, &pos);
+		size_t length = (data >> 2) + 1;
+		if (out + length > size) {
+			error_exit("Verify: BPS action past the end of the target\n");
+		}
+		switch (data & 3) {
+		case BPS_SOURCE_READ:
+			if (out + length > source_size) {
+				error_exit("Verify: BPS source read past the end of the source\n");
+			}
+			memcpy(&target[out], &source[out], length);
+			break;
+		case BPS_TARGET_READ:
+			if (pos + length > end) {
+				error_exit("Verify: truncated BPS patch\n");
+			}
+			memcpy(&target[out], &patch[pos], length);
+			pos += length;
+			break;
+		case BPS_SOURCE_COPY:
+		case BPS_TARGET_COPY: {
+			uint64_t offset = read_bps_number(patch, end, &pos);
+			int64_t delta = (int64_t)(offset >> 1) * (offset & 1 ? -1 : 1);
+			bool from_source = (data & 3) == BPS_SOURCE_COPY;
+			int64_t *relative = from_source ? &source_relative : &target_relative;
+			*relative += delta;
+			if (*relative < 0 || (from_source ? (size_t)*relative + length > source_size : (size_t)*relative >= out)) {
+				error_exit("Verify: BPS copy out of range\n");
+			}
+			for (size_t i = 0; i < length; i++) {
+				// Target copies go byte by byte, since they may overlap what they write
+				target[out + i] = from_source ? source[*relative + i] : target[*relative + i];
+			}
+			*relative += length;
+			break;
+		}
+		}
+		out += length;
+	}
+	if (out != size) {
+		error_exit("Verify: BPS patch wrote %zu of %zu target bytes\n", out, size);
+	}
+	uint32_t crcs[3];
+	for (int i = 0; i < 3; i++) {
+		const uint8_t *p = &patch[end + i * 4];
+		crcs[i] = p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+	}
+	if (crcs[0] != crc32(source, source_size) || crcs[1] != crc32(target, size) || crcs[2] != crc32(patch, end + 8)) {
+		error_exit("Verify: BPS checksum mismatch\n");
+	}
+	*target_size = size;
+	return target;
+}
+
+void put_ips_record(struct Bytes *patch, size_t offset, size_t size) {
+	uint8_t header[5] = {offset >> 16, offset >> 8, offset, size >> 8, size};
+	put_bytes(patch, header, 5);
+}
+
+// Writes IPS records for the differing byte ranges, with RLE records for long runs of one value
+void make_ips(struct Bytes *patch, const uint8_t *source, size_t source_size, const uint8_t *target, size_t target_size, size_t *num_records) {
+	if (target_size > IPS_MAX_OFFSET + 1) {
+		error_exit("Target is too large for an IPS patch: %zu bytes\n", target_size);
+	}
+	put_bytes(patch, (const uint8_t *)"PATCH", 5);
+	*num_records = 0;
+	for (size_t pos = 0; pos < target_size;) {
+		if (pos < source_size && source[pos] == target[pos]) {
+			pos++;
+			continue;
+		}
+		// Extend the changed range over equal gaps too short to be worth a new record header
+		size_t end = pos + 1;
+		for (size_t gap = 0; end + gap < target_size && gap < 5;) {
+			if (end + gap < source_size && source[end + gap] == target[end + gap]) {
+				gap++;
+			} else {
+				end += gap + 1;
+				gap = 0;
+			}
+		}
+		while (pos < end) {
+			// A record cannot start at the "EOF" offset, so start a literal one a byte early
+			size_t record_start = pos == IPS_EOF_OFFSET ? pos - 1 : pos;
+			size_t run = match_length(&target[pos], &target[pos + 1], end - pos - 1) + 1;
+			if (run >= IPS_MIN_RLE && record_start == pos) {
+				run = run < IPS_MAX_RECORD ? run : IPS_MAX_RECORD;
+				put_ips_record(patch, pos, 0);
+				put_bytes(patch, (uint8_t []){run >> 8, run, target[pos]}, 3);
+				pos += run;
+			} else {
+				// Stop the literal record where the next long run starts
+				size_t literal_end = pos + run;
+				while (literal_end < end && literal_end - record_start < IPS_MAX_RECORD) {
+					size_t next_run = match_length(&target[literal_end], &target[literal_end + 1], end - literal_end - 1) + 1;
+					if (next_run >= IPS_MIN_RLE) {
+						break;
+					}
+					literal_end += next_run;
+				}
+				if (literal_end - record_start > IPS_MAX_RECORD) {
+					literal_end = record_start + IPS_MAX_RECORD;
+				}
+				put_ips_record(patch, record_start, literal_end - record_start);
+				put_bytes(patch, &target[record_start], literal_end - record_start);
+				pos = literal_end;
+			}
+			(*num_records)++;
+		}
+	}
+	put_bytes(patch, (const uint8_t *)"EOF", 3);
+	if (target_size < source_size) {
+		// The common truncation extension: the target size after "EOF"
+		put_bytes(patch, (uint8_t []){target_size >> 16, target_size >> 8, target_size}, 3);
+	}
+}
+
+uint8_t *apply_ips(const uint8_t *patch, size_t patch_size, const uint8_t *source, size_t source_size, size_t *target_size) {
+	if (patch_size < 8 || memcmp(patch, "PATCH", 5)) {
+		error_exit("Verify: not an IPS patch\n");
+	}
+	size_t capacity = source_size > IPS_MAX_OFFSET + 1 + IPS_MAX_RECORD ? source_size : IPS_MAX_OFFSET + 1 + IPS_MAX_RECORD;
+	uint8_t *target = xmalloc(capacity);
+	memcpy(target, source, source_size);
+	size_t size = source_size;
+	size_t pos = 5;
+	for (;;) {
+		if (pos + 3 > patch_size) {
+			error_exit("Verify: truncated IPS patch\n");
+		}
+		if (!memcmp(&patch[pos], "EOF", 3)) {
+			pos += 3;
+			break;
+		}
+		if (pos + 5 > patch_size) {
+			error_exit("Verify: truncated IPS patch\n");
+		}
+		size_t offset = patch[pos] << 16 | patch[pos + 1] << 8 | patch[pos + 2];
+		size_t length = patch[pos + 3] << 8 | patch[pos + 4];
+		pos += 5;
+		if (length) {
+			if (pos + length > patch_size) {
+				error_exit("Verify: truncated IPS patch\n");
+			}
+			memcpy(&target[offset], &patch[pos], length);
+			pos += length;
+		} else {
+			if (pos + 3 > patch_size) {
+				error_exit("Verify: truncated IPS patch\n");
+			}
+			length = patch[pos] << 8 | patch[pos + 1];
+			memset(&target[offset], patch[pos + 2], length);
+			pos += 3;
+		}
+		if (offset + length > size) {
+			// Growing the file leaves any skipped bytes as zero
+			if (offset > size) {
+				memset(&target[size], 0, offset - size);
+			}
+			size = offset + length;
+		}
+	}
+	if (pos + 3 <= patch_size) {
+		size = patch[pos] << 16 | patch[pos + 1] << 8 | patch[pos + 2];
+	}
+	*target_size = size;
+	return target;
+}
+
+int main(int argc, char *argv[]) {
+	struct Options options = {0};
+	parse_args(argc, argv, &options);
+
+	argc -= optind;
+	argv += optind;
+	if (argc != 3) {
+		usage_exit(1);
+	}
+
+	struct MappedFile source = map_file(argv[0]);
+	struct MappedFile target = map_file(argv[1]);
+	const uint8_t *source_data = source.data ? source.data : (const uint8_t *)"";
+	const uint8_t *target_data = target.data ? target.data : (const uint8_t *)"";
+
+	clock_t start = clock();
+	struct Bytes patch = {0};
+	struct BPSStats bps_stats = {0};
+	size_t num_records = 0;
+	if (options.ips) {
+		make_ips(&patch, source_data, source.size, target_data, target.size, &num_records);
+	} else {
+		make_bps(&patch, source_data, source.size, target_data, target.size, &bps_stats);
+	}
+	clock_t generated = clock();
+
+	// Verify the patch by applying it to the source
+	size_t result_size;
+	uint8_t *result = options.ips
+		? apply_ips(patch.data, patch.size, source_data, source.size, &result_size)
+		: apply_bps(patch.data, patch.size, source_data, source.size, &result_size);
+	if (result_size != target.size || memcmp(result, target_data, result_size)) {
+		error_exit("Verify: applying the patch does not reproduce \"%s\"\n", argv[1]);
+	}
+	free(result);
+	clock_t verified = clock();
+
+	write_u8(argv[2], patch.data, patch.size);
+
+	if (options.stats) {
+		fprintf(stderr, "%s: %zu bytes (%zu -> %zu byte ROM)\n", argv[2], patch.size, source.size, target.size);
+		if (options.ips) {
+			fprintf(stderr, "    %zu records\n", num_records);
+		} else {
+			static const char *action_names[] = {"source reads", "target reads", "source copies", "target copies"};
+			for (int i = 0; i < 4; i++) {
+				fprintf(stderr, "    %zu %s (%zu bytes)\n", bps_stats.actions[i], action_names[i], bps_stats.bytes[i]);
+			}
+		}
+		fprintf(stderr, "    generated in %.1f ms, verified in %.1f ms\n",
+			(generated - start) * 1000.0 / CLOCKS_PER_SEC, (verified - generated) * 1000.0 / CLOCKS_PER_SEC);
+	}
+
+	free(patch.data);
+	unmap_file(&source);
+	unmap_file(&target);
+	return 0;
+}
@@ -1,9 +1,42 @@
 #define PROGRAM_NAME "make_patch"
-#define USAGE_OPTS "values.sym patched.gbc original.gbc vc.patch.template vc.patch"
+#define USAGE_OPTS "[-h|--help] [-j|--jobs n] values.sym|values.symdb patched.gbc original.gbc vc.patch.template vc.patch\n" \
+	"   or: " PROGRAM_NAME " [-j|--jobs n] -t|--template vc.patch.template {values.sym|values.symdb patched.gbc original.gbc vc.patch}..."
 
 #include "common.h"
+#include "mapdata.h"
+#include "parallel.h"
+#include "symdb.h"
 
-#include <ctype.h>
+#include <stdarg.h>
+
+struct Options {
+	const char *template;
+	int jobs;
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"template", required_argument, 0, 't'},
+		{"jobs", required_argument, 0, 'j'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "t:j:h", long_options)) != -1;) {
+		switch (opt) {
+		case 't':
+			options->template = optarg;
+			break;
+		case 'j':
+			options->jobs = (int)strtoul(optarg, NULL, 0);
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
 
 struct Buffer {
 	size_t item_size;
@@ -19,11 +52,50 @@ struct Symbol {
 	char name[]; // C99 FAM
 };
 
+struct SymbolEntry {
+	const char *key; // NULL for an empty slot
+	const struct Symbol *symbol;
+};
+
+struct SymbolIndex {
+	struct SymbolEntry *entries;
+	size_t capacity; // a power of two
+};
+
+struct SymbolTable {
+	struct Symbol *symbols;
+	struct SymbolIndex names; // full symbol names
+	struct SymbolIndex locals; // every ".local" suffix of the symbol names
+	struct SymDB db; // if loaded, symbols are looked up here instead, and kept in `symbols` once found
+	const struct Symbol **found; // for each symbol in `db`, its entry in `symbols`, or NULL if not yet found
+};
+
 struct Patch {
 	unsigned int offset;
 	unsigned int size;
 };
 
+// A template command, like "{dws Foo .bar+1}", split into its name and arguments
+struct Command {
+	char *name; // the whole command text, NUL-separated into name and arguments
+	char **argv;
+	int argc;
+};
+
+// A vc.patch.template compiled into a sequence of items, so filling it in does not re-tokenize it
+struct TemplateItem {
+	enum { ITEM_TEXT, ITEM_HOOK, ITEM_COMMAND } type;
+	size_t start; // ITEM_TEXT: span of Template.text
+	size_t length;
+	char *hook; // ITEM_HOOK: the ".VC_" label that the following commands patch
+	struct Command command; // ITEM_COMMAND
+};
+
+struct Template {
+	struct Buffer *text; // literal output, all concatenated
+	struct Buffer *items;
+};
+
 struct Buffer *buffer_create(size_t item_size) {
 	struct Buffer *buffer = xmalloc(sizeof(*buffer));
 	buffer->item_size = item_size;
@@ -41,6 +113,32 @@ void buffer_append(struct Buffer *buffer, const void *item) {
 	memcpy((char *)buffer->data + (buffer->size++ * buffer->item_size), item, buffer->item_size);
 }
 
+void buffer_extend(struct Buffer *buffer, const void *items, size_t count) {
+	if (buffer->size + count > buffer->capacity) {
+		buffer->capacity = (buffer->size + count) * 2;
+		buffer->data = xrealloc(buffer->data, buffer->capacity * buffer->item_size);
+	}
+	memcpy((char *)buffer->data + buffer->size * buffer->item_size, items, count * buffer->item_size);
+	buffer->size += count;
+}
+
+// Appends formatted text to a buffer of chars, without its NUL terminator
+__attribute__((format(printf, 2, 3)))
+void buffer_printf(struct Buffer *buffer, const char *format, ...) {
+	va_list args;
+	va_start(args, format);
+	int length = vsnprintf(NULL, 0, format, args);
+	va_end(args);
+	if (buffer->size + length + 1 > buffer->capacity) {
+		buffer->capacity = (buffer->size + length + 1) * 2;
+		buffer->data = xrealloc(buffer->data, buffer->capacity);
+	}
+	va_start(args, format);
+	vsnprintf((char *)buffer->data + buffer->size, length + 1, format, args);
+	va_end(args);
+	buffer->size += length;
+}
+
 void buffer_free(struct Buffer *buffer) {
 	free(buffer->data);
 	free(buffer);
@@ -65,26 +163,92 @@ void symbol_free(struct Symbol *symbols) {
 	}
 }
 
-const struct Symbol *symbol_find(const struct Symbol *symbols, const char *name) {
-	size_t name_len = strlen(name);
+uint32_t hash_string(const char *s) {
+	uint32_t hash = 2166136261u; // FNV-1a
+	for (; *s; s++) {
+		hash = (hash ^ (uint8_t)*s) * 16777619u;
+	}
+	return hash;
+}
+
+void symbol_index_create(struct SymbolIndex *index, size_t count) {
+	index->capacity = 0x10;
+	while (index->capacity < count * 2) {
+		index->capacity *= 2;
+	}
+	index->entries = xcalloc(index->capacity * sizeof(*index->entries));
+}
+
+struct SymbolEntry *symbol_index_slot(const struct SymbolIndex *index, const char *key) {
+	size_t mask = index->capacity - 1;
+	for (size_t i = hash_string(key) & mask;; i = (i + 1) & mask) {
+		struct SymbolEntry *entry = &index->entries[i];
+		if (!entry->key || !strcmp(entry->key, key)) {
+			return entry;
+		}
+	}
+}
+
+void symbol_index_add(struct SymbolIndex *index, const char *key, const struct Symbol *symbol) {
+	struct SymbolEntry *entry = symbol_index_slot(index, key);
+	// Symbols are added newest first, and the newest one with a given name wins
+	if (!entry->key) {
+		entry->key = key;
+		entry->symbol = symbol;
+	}
+}
+
+void symbol_table_create(struct SymbolTable *table, struct Symbol *symbols) {
+	size_t num_names = 0, num_locals = 0;
 	for (const struct Symbol *symbol = symbols; symbol; symbol = symbol->next) {
-		size_t sym_name_len = strlen(symbol->name);
-		if (name_len > sym_name_len) {
-			continue;
+		num_names++;
+		for (const char *dot = strchr(symbol->name, '.'); dot; dot = strchr(dot + 1, '.')) {
+			num_locals++;
 		}
-		const char *sym_name = symbol->name;
-		if (name[0] == '.') {
-			// If `name` is a local label, compare it to the local part of `symbol->name`
-			sym_name += sym_name_len - name_len;
+	}
+	table->symbols = symbols;
+	symbol_index_create(&table->names, num_names);
+	symbol_index_create(&table->locals, num_locals);
+	for (const struct Symbol *symbol = symbols; symbol; symbol = symbol->next) {
+		symbol_index_add(&table->names, symbol->name, symbol);
+		for (const char *dot = strchr(symbol->name, '.'); dot; dot = strchr(dot + 1, '.')) {
+			symbol_index_add(&table->locals, dot, symbol);
 		}
-		if (!strcmp(sym_name, name)) {
-			return symbol;
+	}
+}
+
+void symbol_table_free(struct SymbolTable *table) {
+	symbol_free(table->symbols);
+	free(table->names.entries);
+	free(table->locals.entries);
+	free(table->found);
+	if (table->db.header) {
+		symdb_free(&table->db);
+	}
+}
+
+const struct Symbol *symbol_find(struct SymbolTable *symbols, const char *name) {
+	if (symbols->db.header) {
+		const struct SymDBSymbol *symbol = symdb_find(&symbols->db, name);
+		if (!symbol) {
+			error_exit("Error: Unknown symbol: \"%s\"\n", name);
 		}
+		const struct Symbol **found = &symbols->found[symbol - symbols->db.symbols];
+		if (!*found) {
+			symbol_append(&symbols->symbols, symdb_name(&symbols->db, symbol->name), symbol->bank, symbol->address);
+			*found = symbols->symbols;
+		}
+		return *found;
+	}
+	// If `name` is a local label, look it up by the local part of the symbol names
+	const struct SymbolEntry *entry = symbol_index_slot(name[0] == '.' ? &symbols->locals : &symbols->names, name);
+	if (!entry->key) {
+		error_exit("Error: Unknown symbol: \"%s\"\n", name);
 	}
-	error_exit("Error: Unknown symbol: \"%s\"\n", name);
+	return entry->symbol;
 }
 
-const struct Symbol *symbol_find_cat(const struct Symbol *symbols, const char *prefix, const char *suffix) {
+const struct Symbol *symbol_find_cat(struct SymbolTable *symbols, const char *prefix, const char *suffix) {
 	char *sym_name = xmalloc(strlen(prefix) + strlen(suffix) + 1);
 	sprintf(sym_name, "%s%s", prefix, suffix);
 	const struct Symbol *symbol = symbol_find(symbols, sym_name);
@@ -160,6 +324,16 @@ struct Symbol *parse_symbols(const char *filename) {
 	return symbols;
 }
 
+void symbol_table_load(struct SymbolTable *table, const char *filename) {
+	*table = (struct SymbolTable){0};
+	if (is_symdb_file(filename)) {
+		symdb_load(&table->db, filename);
+		table->found = xcalloc(table->db.header->num_symbols * sizeof(*table->found));
+	} else {
+		symbol_table_create(table, parse_symbols(filename));
+	}
+}
+
 int strfind(const char *s, const char *list[], int count) {
 	for (int i = 0; i < count; i++) {
 		if (!strcmp(s, list[i])) {
@@ -171,7 +345,7 @@ int strfind(const char *s, const char *list[], int count) {
 
 #define vstrfind(s, ...) strfind(s, (const char *[]){__VA_ARGS__}, COUNTOF((const char *[]){__VA_ARGS__}))
 
-int parse_arg_value(const char *arg, bool absolute, const struct Symbol *symbols, const char *patch_name) {
+int parse_arg_value(const char *arg, bool absolute, struct SymbolTable *symbols, const char *patch_name) {
 	// Comparison operators for "ConditionValueB" evaluate to their particular values
 	int op = vstrfind(arg, "==", ">", "<", ">=", "<=", "!=", "||");
 	if (op >= 0) {
@@ -185,37 +359,42 @@ int parse_arg_value(const char *arg, bool absolute, const struct Symbol *symbols
 
 	// Symbols evaluate to their offset or address, plus an optional offset mod
 	int offset_mod = 0;
-	char *plus = strchr(arg, '+');
+	const char *plus = strchr(arg, '+');
 	if (plus) {
 		offset_mod = parse_number(plus, 0);
-		*plus = '\0';
 	}
-	const char *sym_name = !strcmp(arg, "@") ? patch_name : arg; // "@" is the current patch label
+	char *name = xstrndup(arg, plus ? (size_t)(plus - arg) : strlen(arg));
+	if (!strcmp(name, "@") && !patch_name) {
+		error_exit("Error: No current patch for \"@\"\n");
+	}
+	const char *sym_name = !strcmp(name, "@") ? patch_name : name; // "@" is the current patch label
 	const struct Symbol *symbol = symbol_find(symbols, sym_name);
+	free(name);
 	return (absolute ? symbol->offset : symbol->address) + offset_mod;
 }
 
-void interpret_command(char *command, const struct Symbol *current_hook, const struct Symbol *symbols, struct Buffer *patches, FILE *restrict new_rom, FILE *restrict orig_rom, FILE *restrict output) {
+void parse_command(struct Command *command, const char *text) {
 	// Strip all leading spaces and all but one trailing space
+	char *name = xmalloc(strlen(text) + 1);
 	int x = 0;
-	for (int i = 0; command[i]; i++) {
-		if (!isspace((unsigned)command[i]) || (i > 0 && !isspace((unsigned)command[i - 1]))) {
-			command[x++] = command[i];
+	for (int i = 0; text[i]; i++) {
+		if (!isspace((unsigned)text[i]) || (i > 0 && !isspace((unsigned)text[i - 1]))) {
+			name[x++] = text[i];
 		}
 	}
-	command[x - (x > 0 && isspace((unsigned)command[x - 1]))] = '\0';
+	name[x - (x > 0 && isspace((unsigned)name[x - 1]))] = '\0';
 
 	// Count the arguments
 	int argc = 0;
-	for (const char *c = command; *c; c++) {
+	for (const char *c = name; *c; c++) {
 		if (isspace((unsigned)*c)) {
 			argc++;
 		}
 	}
 
 	// Get the arguments
-	char *argv[argc]; // VLA
-	char *arg = command;
+	char **argv = xmalloc(argc * sizeof(*argv));
+	char *arg = name;
 	for (int i = 0; i < argc; i++) {
 		while (*arg && !isspace((unsigned)*arg)) {
 			arg++;
@@ -227,6 +406,15 @@ void interpret_command(char *command, const struct Symbol *current_hook, const s
 		argv[i] = arg;
 	}
 
+	*command = (struct Command){name, argv, argc};
+}
+
+void interpret_command(const struct Command *cmd, const struct Symbol *current_hook, struct SymbolTable *symbols, struct Buffer *patches, const struct MappedFile *new_rom, const struct MappedFile *orig_rom, struct Buffer *output) {
+	const char *command = cmd->name;
+	char *const *argv = cmd->argv;
+	int argc = cmd->argc;
+	const char *patch_name = current_hook ? current_hook->name : NULL;
+
 	// Use the arguments
 	if (vstrfind(command, "patch", "PATCH", "patch_", "PATCH_", "patch/", "PATCH/") >= 0) {
 		if (argc > 2) {
@@ -235,11 +423,11 @@ void interpret_command(char *command, const struct Symbol *current_hook, const s
 		if (!current_hook) {
 			error_exit("Error: No current patch for command: \"%s\"\n", command);
 		}
-		int current_offset = current_hook->offset + (argc > 0 ? parse_number(argv[0], 0) : 0);
-		if (fseek(orig_rom, current_offset, SEEK_SET)) {
+		unsigned int current_offset = current_hook->offset + (argc > 0 ? parse_number(argv[0], 0) : 0);
+		if (current_offset > orig_rom->size) {
 			error_exit("Error: Cannot seek to \"vc_patch %s\" in the original ROM\n", current_hook->name);
 		}
-		if (fseek(new_rom, current_offset, SEEK_SET)) {
+		if (current_offset > new_rom->size) {
 			error_exit("Error: Cannot seek to \"vc_patch %s\" in the new ROM\n", current_hook->name);
 		}
 		int length;
@@ -249,23 +437,26 @@ void interpret_command(char *command, const struct Symbol *current_hook, const s
 			const struct Symbol *current_hook_end = symbol_find_cat(symbols, current_hook->name, "_End");
 			length = current_hook_end->offset - current_offset;
 		}
+		if (length < 0) {
+			error_exit("Error: \"vc_patch %s\" has a negative length\n", current_hook->name);
+		}
+		if (current_offset + length > orig_rom->size || current_offset + length > new_rom->size) {
+			error_exit("Error: \"vc_patch %s\" runs past the end of the ROM\n", current_hook->name);
+		}
 		buffer_append(patches, &(struct Patch){current_offset, length});
-		bool modified = false;
+		const uint8_t *new_bytes = &new_rom->data[current_offset];
+		bool modified = memcmp(new_bytes, &orig_rom->data[current_offset], length);
 		if (length == 1) {
-			int c = getc(new_rom);
-			modified = c != getc(orig_rom);
-			fprintf(output, isupper((unsigned)command[0]) ? "0x%02X" : "0x%02x", c);
+			buffer_printf(output, isupper((unsigned)command[0]) ? "0x%02X" : "0x%02x", new_bytes[0]);
 		} else {
 			if (command[strlen(command) - 1] != '/') {
-				fprintf(output, command[strlen(command) - 1] == '_' ? "a%d: " : "a%d:", length);
+				buffer_printf(output, command[strlen(command) - 1] == '_' ? "a%d: " : "a%d:", length);
 			}
 			for (int i = 0; i < length; i++) {
 				if (i) {
-					putc(' ', output);
+					buffer_append(output, &(char){' '});
 				}
-				int c = getc(new_rom);
-				modified |= c != getc(orig_rom);
-				fprintf(output, isupper((unsigned)command[0]) ? "%02X" : "%02x", c);
+				buffer_printf(output, isupper((unsigned)command[0]) ? "%02X" : "%02x", new_bytes[i]);
 			}
 		}
 		if (!modified) {
@@ -277,48 +468,48 @@ void interpret_command(char *command, const struct Symbol *current_hook, const s
 			error_exit("Error: Invalid arguments for command: \"%s\"\n", command);
 		}
 		if (command[strlen(command) - 1] != '/') {
-			fprintf(output, command[strlen(command) - 1] == '_' ? "a%d: " : "a%d:", argc * 2);
+			buffer_printf(output, command[strlen(command) - 1] == '_' ? "a%d: " : "a%d:", argc * 2);
 		}
 		for (int i = 0; i < argc; i++) {
-			int value = parse_arg_value(argv[i], false, symbols, current_hook->name);
+			int value = parse_arg_value(argv[i], false, symbols, patch_name);
 			if (value > 0xffff) {
 				error_exit("Error: Invalid value for \"%s\" argument: 0x%x\n", command, value);
 			}
 			if (i) {
-				putc(' ', output);
+				buffer_append(output, &(char){' '});
 			}
-			fprintf(output, isupper((unsigned)command[0]) ? "%02X %02X": "%02x %02x", value & 0xff, value >> 8);
+			buffer_printf(output, isupper((unsigned)command[0]) ? "%02X %02X": "%02x %02x", value & 0xff, value >> 8);
 		}
 
 	} else if (vstrfind(command, "db", "DB", "db_", "DB_", "db/", "DB/") >= 0) {
 		if (argc != 1) {
 			error_exit("Error: Invalid arguments for command: \"%s\"\n", command);
 		}
-		int value = parse_arg_value(argv[0], false, symbols, current_hook->name);
+		int value = parse_arg_value(argv[0], false, symbols, patch_name);
 		if (value > 0xff) {
 			error_exit("Error: Invalid value for \"%s\" argument: 0x%x\n", command, value);
 		}
 		if (command[strlen(command) - 1] != '/') {
-			fputs(command[strlen(command) - 1] == '_' ? "a1: " : "a1:", output);
+			buffer_printf(output, "%s", command[strlen(command) - 1] == '_' ? "a1: " : "a1:");
 		}
-		fprintf(output, isupper((unsigned)command[0]) ? "%02X" : "%02x", value);
+		buffer_printf(output, isupper((unsigned)command[0]) ? "%02X" : "%02x", value);
 
 	} else if (vstrfind(command, "hex", "HEX", "HEx", "Hex", "heX", "hEX", "hex~", "HEX~", "HEx~", "Hex~", "heX~", "hEX~") >= 0) {
 		if (argc != 1 && argc != 2) {
 			error_exit("Error: Invalid arguments for command: \"%s\"\n", command);
 		}
-		int value = parse_arg_value(argv[0], command[strlen(command) - 1] != '~', symbols, current_hook->name);
+		int value = parse_arg_value(argv[0], command[strlen(command) - 1] != '~', symbols, patch_name);
 		int padding = argc > 1 ? parse_number(argv[1], 0) : 2;
 		if (vstrfind(command, "HEx", "HEx~") >= 0) {
-			fprintf(output, "0x%0*X%02x", padding - 2, value >> 8, value & 0xff);
+			buffer_printf(output, "0x%0*X%02x", padding - 2, value >> 8, value & 0xff);
 		} else if (vstrfind(command, "Hex", "Hex~") >= 0) {
-			fprintf(output, "0x%0*X%03x", padding - 3, value >> 12, value & 0xfff);
+			buffer_printf(output, "0x%0*X%03x", padding - 3, value >> 12, value & 0xfff);
 		} else if (vstrfind(command, "heX", "heX~") >= 0) {
-			fprintf(output, "0x%0*x%02X", padding - 2, value >> 8, value & 0xff);
+			buffer_printf(output, "0x%0*x%02X", padding - 2, value >> 8, value & 0xff);
 		} else if (vstrfind(command, "hEX", "hEX~") >= 0) {
-			fprintf(output, "0x%0*x%03X", padding - 3, value >> 12, value & 0xfff);
+			buffer_printf(output, "0x%0*x%03X", padding - 3, value >> 12, value & 0xfff);
 		} else {
-			fprintf(output, isupper((unsigned)command[0]) ? "0x%0*X" : "0x%0*x", padding, value);
+			buffer_printf(output, isupper((unsigned)command[0]) ? "0x%0*X" : "0x%0*x", padding, value);
 		}
 
 	} else {
@@ -326,63 +517,88 @@ void interpret_command(char *command, const struct Symbol *current_hook, const s
 	}
 }
 
-void skip_to_next_line(FILE *restrict input, FILE *restrict output) {
-	for (int c = getc(input); c != EOF; c = getc(input)) {
-		putc(c, output);
+void free_template(struct Template *template) {
+	for (size_t i = 0; i < template->items->size; i++) {
+		struct TemplateItem *item = &((struct TemplateItem *)template->items->data)[i];
+		free(item->hook);
+		free(item->command.name);
+		free(item->command.argv);
+	}
+	buffer_free(template->items);
+	buffer_free(template->text);
+}
+
+// Appends a literal char, extending the previous text item if possible
+void template_putc(struct Template *template, char c) {
+	struct TemplateItem *last = template->items->size
+		? &((struct TemplateItem *)template->items->data)[template->items->size - 1] : NULL;
+	if (!last || last->type != ITEM_TEXT || last->start + last->length != template->text->size) {
+		buffer_append(template->items, &(struct TemplateItem){.type = ITEM_TEXT, .start = template->text->size});
+		last = &((struct TemplateItem *)template->items->data)[template->items->size - 1];
+	}
+	buffer_append(template->text, &c);
+	last->length++;
+}
+
+void skip_to_next_line(const char **input, struct Template *template) {
+	while (**input) {
+		char c = *(*input)++;
+		template_putc(template, c);
 		if (c == '\n' || c == '\r') {
 			break;
 		}
 	}
 }
 
-struct Buffer *process_template(const char *template_filename, const char *patch_filename, FILE *restrict new_rom, FILE *restrict orig_rom, const struct Symbol *symbols) {
-	FILE *input = xfopen(template_filename, 'r');
-	FILE *output = xfopen(patch_filename, 'w');
-
-	struct Buffer *patches = buffer_create(sizeof(struct Patch));
+void compile_template(struct Template *template, const char *template_filename) {
+	char *text = read_text(template_filename);
+	template->text = buffer_create(1);
+	template->items = buffer_create(sizeof(struct TemplateItem));
 	struct Buffer *buffer = buffer_create(1);
 
-	// The ROM checksum will always differ
-	buffer_append(patches, &(struct Patch){0x14e, 2});
-
-	// Fill in the template
-	const struct Symbol *current_hook = NULL;
-	for (int c = getc(input); c != EOF; c = getc(input)) {
+	for (const char *input = text; *input;) {
+		char c = *input++;
 		switch (c) {
 		case ';':
 			// ";" comments until the end of the line
-			putc(c, output);
-			skip_to_next_line(input, output);
+			template_putc(template, c);
+			skip_to_next_line(&input, template);
 			break;
 
 		case '{':
 			// "{...}" is a template command; buffer its contents
 			buffer->size = 0;
-			for (c = getc(input); c != EOF && c != '}'; c = getc(input)) {
-				buffer_append(buffer, &c);
+			while (*input && *input != '}') {
+				buffer_append(buffer, input++);
+			}
+			if (*input) {
+				input++;
 			}
 			buffer_append(buffer, &(char []){'\0'});
-			// Interpret the command in the context of the current patch
-			interpret_command(buffer->data, current_hook, symbols, patches, new_rom, orig_rom, output);
+			struct TemplateItem command = {.type = ITEM_COMMAND};
+			parse_command(&command.command, buffer->data);
+			buffer_append(template->items, &command);
 			break;
 
 		case '[':
 			// "[...]" is a patch label; buffer its contents
-			putc(c, output);
+			template_putc(template, c);
 			bool alternate = false;
 			buffer->size = 0;
-			for (c = getc(input); c != EOF; c = getc(input)) {
+			buffer_printf(buffer, ".VC_");
+			while (*input) {
+				c = *input++;
 				if (!alternate && c == '@') {
 					// "@" designates an alternate name for the ".VC_" label
 					alternate = true;
-					buffer->size = 0;
+					buffer->size = 4;
 				} else if (c == ']') {
-					putc(c, output);
+					template_putc(template, c);
 					break;
 				} else {
 					if (!alternate) {
-						putc(c, output);
-						if (!isalnum(c) && c != '_') {
+						template_putc(template, c);
+						if (!isalnum((unsigned)c) && c != '_') {
 							// Convert non-identifier characters to underscores
 							c = '_';
 						}
@@ -392,21 +608,48 @@ struct Buffer *process_template(const char *template_filename, const char *patch
 			}
 			buffer_append(buffer, &(char []){'\0'});
 			// The current patch should have a corresponding ".VC_" label
-			current_hook = symbol_find_cat(symbols, ".VC_", buffer->data);
-			skip_to_next_line(input, output);
+			buffer_append(template->items, &(struct TemplateItem){.type = ITEM_HOOK, .hook = xstrdup(buffer->data)});
+			skip_to_next_line(&input, template);
 			break;
 
 		default:
-			putc(c, output);
+			template_putc(template, c);
 		}
 	}
 
-	rewind(orig_rom);
-	rewind(new_rom);
-
-	fclose(input);
-	fclose(output);
 	buffer_free(buffer);
+	free(text);
+}
+
+// Fills in a compiled template for one pair of ROMs, and writes it with a single write
+struct Buffer *process_template(const struct Template *template, const char *patch_filename, const struct MappedFile *new_rom, const struct MappedFile *orig_rom, struct SymbolTable *symbols) {
+	struct Buffer *patches = buffer_create(sizeof(struct Patch));
+	struct Buffer *output = buffer_create(1);
+
+	// The ROM checksum will always differ
+	buffer_append(patches, &(struct Patch){0x14e, 2});
+
+	const struct Symbol *current_hook = NULL;
+	for (size_t i = 0; i < template->items->size; i++) {
+		const struct TemplateItem *item = &((const struct TemplateItem *)template->items->data)[i];
+		switch (item->type) {
+		case ITEM_TEXT:
+			buffer_extend(output, (const char *)template->text->data + item->start, item->length);
+			break;
+		case ITEM_HOOK:
+			current_hook = symbol_find(symbols, item->hook);
+			break;
+		case ITEM_COMMAND:
+			// Interpret the command in the context of the current patch
+			interpret_command(&item->command, current_hook, symbols, patches, new_rom, orig_rom, output);
+			break;
+		}
+	}
+
+	FILE *f = xfopen(patch_filename, 'w');
+	xfwrite(output->data, output->size, patch_filename, f);
+	fclose(f);
+	buffer_free(output);
 	return patches;
 }
 
@@ -416,52 +659,149 @@ int compare_patch(const void *patch1, const void *patch2) {
 	return (offset1 > offset2) - (offset1 < offset2);
 }
 
-bool verify_completeness(FILE *restrict orig_rom, FILE *restrict new_rom, struct Buffer *patches) {
-	qsort(patches->data, patches->size, patches->item_size, compare_patch);
-	for (unsigned int offset = 0, index = 0; ; offset++) {
-		int orig_byte = getc(orig_rom);
-		int new_byte = getc(new_rom);
-		if (orig_byte == EOF || new_byte == EOF) {
-			return orig_byte == new_byte;
-		}
-		struct Patch *patch = &((struct Patch *)patches->data)[index];
-		if (index < patches->size && patch->offset == offset) {
-			if (fseek(orig_rom, patch->size, SEEK_CUR)) {
-				return false;
-			}
-			if (fseek(new_rom, patch->size, SEEK_CUR)) {
-				return false;
-			}
-			offset += patch->size;
-			index++;
-		} else if (orig_byte != new_byte) {
-			fprintf(stderr, PROGRAM_NAME ": Warning: Unpatched difference at offset: 0x%x\n", offset);
-			fprintf(stderr, "    Original ROM value: 0x%02x\n", orig_byte);
-			fprintf(stderr, "    Patched ROM value: 0x%02x\n", new_byte);
-			fprintf(stderr, "    Current patch offset: 0x%06x\n", patch->offset);
-			return false;
+#define DIFF_BLOCK_SIZE 0x1000
+
+// Returns the first offset in [start, end) where the ROMs differ, or `end` if there is none
+size_t find_difference(const uint8_t *orig, const uint8_t *patched, size_t start, size_t end) {
+	// memcmp skips equal blocks with vector compares; a differing block is halved until one byte is left
+	size_t block_size = DIFF_BLOCK_SIZE;
+	while (start < end) {
+		size_t size = end - start < block_size ? end - start : block_size;
+		if (!memcmp(&orig[start], &patched[start], size)) {
+			start += size;
+		} else if (size == 1) {
+			return start;
+		} else {
+			block_size = size / 2;
 		}
 	}
+	return end;
 }
 
-int main(int argc, char *argv[]) {
-	if (argc != 6) {
-		usage_exit(1);
+// Reports each differing range in [start, end) of the ROMs; returns whether there were any
+bool report_differences(const uint8_t *orig, const uint8_t *patched, size_t start, size_t end, const struct Patch *next_patch) {
+	bool found = false;
+	while ((start = find_difference(orig, patched, start, end)) < end) {
+		size_t range_end = start + 1;
+		while (range_end < end && orig[range_end] != patched[range_end]) {
+			range_end++;
+		}
+		// Print each warning in one call, so warnings from concurrent variants do not interleave
+		struct Buffer *warning = buffer_create(1);
+		if (range_end - start == 1) {
+			buffer_printf(warning, PROGRAM_NAME ": Warning: Unpatched difference at offset: 0x%zx\n", start);
+		} else {
+			buffer_printf(warning, PROGRAM_NAME ": Warning: Unpatched differences at offsets: 0x%zx-0x%zx\n", start, range_end - 1);
+		}
+		buffer_printf(warning, "    Original ROM value: 0x%02x\n", orig[start]);
+		buffer_printf(warning, "    Patched ROM value: 0x%02x\n", patched[start]);
+		if (next_patch) {
+			buffer_printf(warning, "    Next patch offset: 0x%06x\n", next_patch->offset);
+		}
+		fwrite(warning->data, 1, warning->size, stderr);
+		buffer_free(warning);
+		found = true;
+		start = range_end;
+	}
+	return found;
+}
+
+bool verify_completeness(const struct MappedFile *orig_rom, const struct MappedFile *new_rom, struct Buffer *patches) {
+	qsort(patches->data, patches->size, patches->item_size, compare_patch);
+	const struct Patch *sorted_patches = patches->data;
+	size_t size = orig_rom->size < new_rom->size ? orig_rom->size : new_rom->size;
+	bool complete = orig_rom->size == new_rom->size;
+	// Compare the gaps between patches, so every unpatched difference gets reported in one pass
+	size_t offset = 0;
+	for (size_t i = 0; i < patches->size && offset < size; i++) {
+		const struct Patch *patch = &sorted_patches[i];
+		if (patch->offset > offset) {
+			complete &= !report_differences(orig_rom->data, new_rom->data, offset, patch->offset < size ? patch->offset : size, patch);
+		}
+		if (patch->offset + patch->size > offset) {
+			offset = patch->offset + patch->size;
+		}
 	}
+	if (offset < size) {
+		complete &= !report_differences(orig_rom->data, new_rom->data, offset, size, NULL);
+	}
+	return complete;
+}
 
-	struct Symbol *symbols = parse_symbols(argv[1]);
+// The files for one ROM variant's patch
+struct Variant {
+	const char *symbols;
+	const char *new_rom;
+	const char *orig_rom;
+	const char *patch;
+};
 
-	FILE *new_rom = xfopen(argv[2], 'r');
-	FILE *orig_rom = xfopen(argv[3], 'r');
-	struct Buffer *patches = process_template(argv[4], argv[5], new_rom, orig_rom, symbols);
+struct Batch {
+	const struct Template *template;
+	const struct Variant *variants;
+};
 
-	if (!verify_completeness(orig_rom, new_rom, patches)) {
-		fprintf(stderr, PROGRAM_NAME ": Warning: Not all ROM differences are defined by \"%s\"\n", argv[5]);
+void make_variant_patch(const struct Template *template, const struct Variant *variant) {
+	struct SymbolTable symbols;
+	symbol_table_load(&symbols, variant->symbols);
+
+	struct MappedFile new_rom = map_file(variant->new_rom);
+	struct MappedFile orig_rom = map_file(variant->orig_rom);
+	struct Buffer *patches = process_template(template, variant->patch, &new_rom, &orig_rom, &symbols);
+
+	if (!verify_completeness(&orig_rom, &new_rom, patches)) {
+		fprintf(stderr, PROGRAM_NAME ": Warning: Not all ROM differences are defined by \"%s\"\n", variant->patch);
 	}
 
-	symbol_free(symbols);
-	fclose(new_rom);
-	fclose(orig_rom);
+	symbol_table_free(&symbols);
+	unmap_file(&new_rom);
+	unmap_file(&orig_rom);
 	buffer_free(patches);
+}
+
+void process_variant(int index, int thread, void *arg) {
+	(void)thread;
+	const struct Batch *batch = arg;
+	make_variant_patch(batch->template, &batch->variants[index]);
+}
+
+int main(int argc, char *argv[]) {
+	struct Options options = {0};
+	parse_args(argc, argv, &options);
+
+	argc -= optind;
+	argv += optind;
+
+	struct Variant *variants;
+	int num_variants;
+	const char *template_filename = options.template;
+	if (template_filename) {
+		// Several variants share one compiled template
+		if (!argc || argc % 4) {
+			usage_exit(1);
+		}
+		num_variants = argc / 4;
+		variants = xmalloc(num_variants * sizeof(*variants));
+		for (int i = 0; i < num_variants; i++) {
+			variants[i] = (struct Variant){argv[i * 4], argv[i * 4 + 1], argv[i * 4 + 2], argv[i * 4 + 3]};
+		}
+	} else {
+		if (argc != 5) {
+			usage_exit(1);
+		}
+		template_filename = argv[3];
+		num_variants = 1;
+		variants = xmalloc(sizeof(*variants));
+		variants[0] = (struct Variant){argv[0], argv[1], argv[2], argv[4]};
+	}
+
+	struct Template template;
+	compile_template(&template, template_filename);
+
+	struct Batch batch = {&template, variants};
+	parallel_for(num_variants, parallel_num_threads(options.jobs), process_variant, &batch);
+
+	free_template(&template);
+	free(variants);
 	return 0;
 }
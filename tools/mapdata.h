@@ -0,0 +1,801 @@
+#ifndef GUARD_MAPDATA_H
+#define GUARD_MAPDATA_H
+
+// Include common.h before this header
+// Loads the tileset and map definitions that the ROM is assembled from:
+// - constants/tileset_constants.asm for TILESET_* order
+// - data/tilesets.asm for tileset labels, metatile/attribute/collision files, and graphics
+// - constants/map_constants.asm for map sizes
+// - data/maps/maps.asm for map tilesets
+// - data/maps/attributes.asm for map border blocks
+// - data/maps/blocks.asm for map .ablk files
+// All paths are relative to the repository root, where the tools are run from.
+
+#include <ctype.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define TILESET_CONSTANTS_FILE "constants/tileset_constants.asm"
+#define TILESETS_FILE "data/tilesets.asm"
+#define MAP_CONSTANTS_FILE "constants/map_constants.asm"
+#define MAP_HEADERS_FILE "data/maps/maps.asm"
+#define MAP_ATTRIBUTES_FILE "data/maps/attributes.asm"
+#define MAP_BLOCKS_FILE "data/maps/blocks.asm"
+#define FIELD_MOVE_BLOCKS_FILE "data/collision/field_move_blocks.asm"
+#define TILESET_ANIMS_FILE "engine/tilesets/tileset_anims.asm"
+
+#define TILE_SIZE 16 // 8x8-px 2bpp tile
+#define METATILE_WIDTH 4 // tiles per block row
+#define METATILE_SIZE (METATILE_WIDTH * METATILE_WIDTH) // tiles per block
+#define MAX_BLOCKS 0x100
+
+// Metatile attribute bits (see hardware.inc)
+#define ATTR_PALETTE 0x07
+#define ATTR_BANK1 0x08
+#define ATTR_XFLIP 0x20
+#define ATTR_YFLIP 0x40
+#define ATTR_PRIORITY 0x80
+
+// VRAM tile slots: $000-$0ff for bank 0 and $100-$1ff for bank 1
+#define NUM_VRAM_SLOTS 0x200
+#define VRAM_SLOT(tile, attr) ((((attr) & ATTR_BANK1) ? 0x100 : 0) | (tile))
+
+// Tileset graphics groups (see _LoadTilesetGFX in home/map.asm)
+enum { GFX0, GFX1, GFX2, NUM_GFX };
+#define GFX_GROUP_TILES 0x7f // each group loads at most $7f tiles
+static const int gfx_group_slots[NUM_GFX] = {0x000, 0x100, 0x180};
+
+struct TilesetGFX {
+	char *filename; // e.g. "gfx/tilesets/johto_common.2bpp"; NULL if the group is empty
+	int first_tile; // index of the first tile in the file that this group loads
+};
+
+struct Tileset {
+	char *constant; // e.g. "TILESET_JOHTO_TRADITIONAL"
+	char *label; // e.g. "TilesetJohto1"
+	char *name; // e.g. "johto_traditional"
+	char *metatiles_filename;
+	char *attributes_filename;
+	char *collision_filename;
+	struct TilesetGFX gfx[NUM_GFX];
+	bool roof; // loads map group roof tiles over GFX0 (see LoadMapGroupRoof)
+};
+
+// Roof tiles overwrite these GFX0 slots (see engine/tilesets/mapgroup_roofs.asm)
+#define ROOF_FIRST_SLOT 0x0a
+#define ROOF_LENGTH 9
+
+struct BlockData {
+	char *filename; // e.g. "maps/JohtoPokeCenter1F.ablk"
+	char *label; // first label, without its "_BlockData" suffix
+	int map; // first map that uses this block data, or -1
+};
+
+struct Map {
+	char *name; // e.g. "NewBarkTown"
+	char *constant; // e.g. "NEW_BARK_TOWN"
+	int tileset; // index into MapData.tilesets
+	int width;
+	int height;
+	int border_block;
+	int block_data; // index into MapData.block_data, or -1
+};
+
+struct MapData {
+	struct Tileset *tilesets;
+	int num_tilesets;
+	struct Map *maps;
+	int num_maps;
+	struct BlockData *block_data;
+	int num_block_data;
+};
+
+struct MappedFile {
+	uint8_t *data;
+	size_t size;
+};
+
+struct MappedFile map_file(const char *filename) {
+	errno = 0;
+	int fd = open(filename, O_RDONLY);
+	if (fd == -1) {
+		error_exit("Could not open file \"%s\": %s\n", filename, strerror(errno));
+	}
+	struct stat st;
+	if (fstat(fd, &st) == -1) {
+		close(fd);
+		error_exit("Could not measure file \"%s\": %s\n", filename, strerror(errno));
+	}
+	struct MappedFile file = {NULL, (size_t)st.st_size};
+	if (file.size) {
+		void *data = mmap(NULL, file.size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED) {
+			close(fd);
+			error_exit("Could not map file \"%s\": %s\n", filename, strerror(errno));
+		}
+		file.data = data;
+	}
+	close(fd);
+	return file;
+}
+
+void unmap_file(struct MappedFile *file) {
+	if (file->data) {
+		munmap(file->data, file->size);
+	}
+	file->data = NULL;
+	file->size = 0;
+}
+
+bool file_exists(const char *filename) {
+	return !access(filename, F_OK);
+}
+
+// Returns "outdir/filename" (outdir defaults to "."), creating any missing directories
+char *output_path(const char *outdir, const char *filename) {
+	if (!outdir) {
+		outdir = ".";
+	}
+	char *path = xmalloc(strlen(outdir) + strlen(filename) + 2);
+	sprintf(path, "%s/%s", outdir, filename);
+	for (char *slash = strchr(path + 1, '/'); slash; slash = strchr(slash + 1, '/')) {
+		*slash = '\0';
+		if (mkdir(path, 0777) && errno != EEXIST) {
+			error_exit("Could not create directory \"%s\": %s\n", path, strerror(errno));
+		}
+		*slash = '/';
+	}
+	return path;
+}
+
+char *xstrdup(const char *s) {
+	size_t size = strlen(s) + 1;
+	char *d = xmalloc(size);
+	memcpy(d, s, size);
+	return d;
+}
+
+char *xstrndup(const char *s, size_t n) {
+	char *d = xmalloc(n + 1);
+	memcpy(d, s, n);
+	d[n] = '\0';
+	return d;
+}
+
+// Returns the NUL-terminated contents of a text file
+char *read_text(const char *filename) {
+	long size;
+	uint8_t *data = read_u8(filename, &size);
+	data = xrealloc(data, size + 1);
+	data[size] = '\0';
+	return (char *)data;
+}
+
+// Splits off the next line of `*text`, with any ";" comment and trailing space removed
+char *next_line(char **text) {
+	char *line = *text;
+	if (!line || !*line) {
+		return NULL;
+	}
+	char *end = strchr(line, '\n');
+	*text = end ? end + 1 : NULL;
+	if (end) {
+		*end = '\0';
+	}
+	char *comment = strchr(line, ';');
+	if (comment) {
+		*comment = '\0';
+	}
+	size_t len = strlen(line);
+	while (len && isspace((unsigned)line[len - 1])) {
+		line[--len] = '\0';
+	}
+	return line;
+}
+
+// Returns the arguments after `keyword` if `line` is a use of that macro, or NULL
+char *macro_args(char *line, const char *keyword) {
+	line += strspn(line, " \t");
+	size_t len = strlen(keyword);
+	if (strncmp(line, keyword, len) || (line[len] != ' ' && line[len] != '\t')) {
+		return NULL;
+	}
+	return line + len + strspn(line + len, " \t");
+}
+
+// Splits `args` on commas into at most `max` trimmed arguments; returns the argument count
+int split_args(char *args, char *argv[], int max) {
+	int argc = 0;
+	while (args && argc < max) {
+		char *comma = strchr(args, ',');
+		if (comma) {
+			*comma++ = '\0';
+		}
+		args += strspn(args, " \t");
+		size_t len = strlen(args);
+		while (len && isspace((unsigned)args[len - 1])) {
+			args[--len] = '\0';
+		}
+		argv[argc++] = args;
+		args = comma;
+	}
+	return argc;
+}
+
+int parse_asm_number(const char *s) {
+	char *end;
+	long n = *s == '$' ? strtol(s + 1, &end, 16) : *s == '%' ? strtol(s + 1, &end, 2) : strtol(s, &end, 10);
+	if (end == s || *end) {
+		error_exit("Cannot parse number: \"%s\"\n", s);
+	}
+	return (int)n;
+}
+
+// Returns the quoted filename of an INCBIN, without any ".lz" extension, or NULL
+char *incbin_filename(const char *line) {
+	const char *incbin = strstr(line, "INCBIN \"");
+	if (!incbin) {
+		return NULL;
+	}
+	const char *start = incbin + strlen("INCBIN \"");
+	const char *end = strchr(start, '"');
+	if (!end) {
+		return NULL;
+	}
+	size_t len = end - start;
+	if (len > 3 && !strncmp(end - 3, ".lz", 3)) {
+		len -= 3;
+	}
+	return xstrndup(start, len);
+}
+
+int compare_map_names(const void *a, const void *b) {
+	return strcmp((*(const struct Map *const *)a)->name, (*(const struct Map *const *)b)->name);
+}
+
+// Sorted index of maps by name, for find_map
+struct Map **map_index;
+
+int compare_map_name_key(const void *key, const void *map) {
+	return strcmp(key, (*(const struct Map *const *)map)->name);
+}
+
+int find_map(const struct MapData *data, const char *name) {
+	struct Map **found = bsearch(name, map_index, data->num_maps, sizeof(*map_index), compare_map_name_key);
+	return found ? (int)(*found - data->maps) : -1;
+}
+
+int find_tileset_constant(const struct MapData *data, const char *constant) {
+	for (int i = 0; i < data->num_tilesets; i++) {
+		if (!strcmp(data->tilesets[i].constant, constant)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void read_tileset_constants(struct MapData *data) {
+	char *text = read_text(TILESET_CONSTANTS_FILE);
+	char *cursor = text;
+	bool started = false;
+	for (char *line; (line = next_line(&cursor));) {
+		char *args;
+		if (strstr(line, "NUM_TILESETS")) {
+			break;
+		} else if (strstr(line, "NO_ROOF_TILESETS")) {
+			// Tilesets before this constant load roof tiles
+			for (int i = 0; i < data->num_tilesets; i++) {
+				data->tilesets[i].roof = true;
+			}
+		} else if ((args = macro_args(line, "const_def"))) {
+			started = true;
+		} else if (started && (args = macro_args(line, "const"))) {
+			data->tilesets = xrealloc(data->tilesets, (data->num_tilesets + 1) * sizeof(*data->tilesets));
+			data->tilesets[data->num_tilesets++] = (struct Tileset){.constant = xstrdup(args)};
+		}
+	}
+	free(text);
+}
+
+void read_tilesets(struct MapData *data) {
+	char *text = read_text(TILESETS_FILE);
+	char *cursor = text;
+	int num_labeled = 0;
+	// Labels such as "TilesetJohto1GFX0::" may be stacked above a shared INCBIN
+	char *pending[0x100];
+	int num_pending = 0;
+	for (char *line; (line = next_line(&cursor));) {
+		char *args = macro_args(line, "tileset");
+		if (args) {
+			if (num_labeled >= data->num_tilesets) {
+				error_exit("%s: more tilesets than TILESET_* constants\n", TILESETS_FILE);
+			}
+			data->tilesets[num_labeled++].label = xstrdup(args);
+			continue;
+		}
+		char *colons = strstr(line, "::");
+		if (colons && !isspace((unsigned)line[0])) {
+			if (num_pending < (int)COUNTOF(pending)) {
+				pending[num_pending++] = xstrndup(line, colons - line);
+			}
+			line = colons + 2;
+			line += strspn(line, " \t");
+			if (!*line) {
+				continue;
+			}
+		}
+		if (!*line) {
+			continue;
+		}
+		// Any other statement resolves the pending labels
+		char *filename = incbin_filename(line);
+		for (int i = 0; i < num_pending; i++) {
+			for (int j = 0; j < num_labeled; j++) {
+				struct Tileset *tileset = &data->tilesets[j];
+				size_t len = strlen(tileset->label);
+				if (strncmp(pending[i], tileset->label, len)) {
+					continue;
+				}
+				const char *suffix = pending[i] + len;
+				if (!strcmp(suffix, "Meta")) {
+					tileset->metatiles_filename = filename ? xstrdup(filename) : NULL;
+				} else if (!strcmp(suffix, "Attr")) {
+					tileset->attributes_filename = filename ? xstrdup(filename) : NULL;
+				} else if (!strcmp(suffix, "Coll")) {
+					tileset->collision_filename = filename ? xstrdup(filename) : NULL;
+				} else if (!strncmp(suffix, "GFX", 3) && suffix[3] >= '0' && suffix[3] < '0' + NUM_GFX && !suffix[4]) {
+					struct TilesetGFX *gfx = &tileset->gfx[suffix[3] - '0'];
+					gfx->filename = NULL;
+					gfx->first_tile = 0;
+					if (filename) {
+						// "foo.2bpp.vram1" is the second 128 tiles of "foo.2bpp"; "vram1p" is 127
+						char *vram = strstr(filename, ".2bpp.vram");
+						if (vram) {
+							int k = vram[strlen(".2bpp.vram")] - '0';
+							gfx->first_tile = k * (vram[strlen(".2bpp.vram") + 1] == 'p' ? 0x7f : 0x80);
+							gfx->filename = xstrndup(filename, vram + strlen(".2bpp") - filename);
+						} else {
+							gfx->filename = xstrdup(filename);
+						}
+					}
+				}
+			}
+			free(pending[i]);
+		}
+		num_pending = 0;
+		free(filename);
+	}
+	free(text);
+
+	if (num_labeled != data->num_tilesets) {
+		error_exit("%s: %d tilesets for %d TILESET_* constants\n", TILESETS_FILE, num_labeled, data->num_tilesets);
+	}
+	for (int i = 0; i < data->num_tilesets; i++) {
+		struct Tileset *tileset = &data->tilesets[i];
+		if (!tileset->metatiles_filename || !tileset->attributes_filename) {
+			error_exit("%s: no metatiles or attributes for %s\n", TILESETS_FILE, tileset->label);
+		}
+		// "data/tilesets/johto_traditional_metatiles.bin" is named "johto_traditional"
+		const char *base = strrchr(tileset->metatiles_filename, '/');
+		base = base ? base + 1 : tileset->metatiles_filename;
+		const char *suffix = strstr(base, "_metatiles.bin");
+		tileset->name = suffix ? xstrndup(base, suffix - base) : xstrdup(base);
+	}
+}
+
+void read_map_constants(struct MapData *data) {
+	char *text = read_text(MAP_CONSTANTS_FILE);
+	char *cursor = text;
+	for (char *line; (line = next_line(&cursor));) {
+		char *args = macro_args(line, "map_const");
+		char *argv[3];
+		if (!args || split_args(args, argv, 3) != 3) {
+			continue;
+		}
+		data->maps = xrealloc(data->maps, (data->num_maps + 1) * sizeof(*data->maps));
+		data->maps[data->num_maps++] = (struct Map){
+			.constant = xstrdup(argv[0]),
+			.tileset = -1,
+			.width = parse_asm_number(argv[1]),
+			.height = parse_asm_number(argv[2]),
+			.block_data = -1,
+		};
+	}
+	free(text);
+}
+
+void read_map_headers(struct MapData *data) {
+	char *text = read_text(MAP_HEADERS_FILE);
+	char *cursor = text;
+	int num_named = 0;
+	for (char *line; (line = next_line(&cursor));) {
+		char *args = macro_args(line, "map");
+		char *argv[2];
+		if (!args || split_args(args, argv, 2) != 2) {
+			continue;
+		}
+		if (num_named >= data->num_maps) {
+			error_exit("%s: more maps than map_const entries\n", MAP_HEADERS_FILE);
+		}
+		struct Map *map = &data->maps[num_named++];
+		map->name = xstrdup(argv[0]);
+		map->tileset = find_tileset_constant(data, argv[1]);
+		if (map->tileset == -1) {
+			error_exit("%s: unknown tileset for %s: %s\n", MAP_HEADERS_FILE, map->name, argv[1]);
+		}
+	}
+	free(text);
+	if (num_named != data->num_maps) {
+		error_exit("%s: %d maps for %d map_const entries\n", MAP_HEADERS_FILE, num_named, data->num_maps);
+	}
+
+	map_index = xmalloc(data->num_maps * sizeof(*map_index));
+	for (int i = 0; i < data->num_maps; i++) {
+		map_index[i] = &data->maps[i];
+	}
+	qsort(map_index, data->num_maps, sizeof(*map_index), compare_map_names);
+}
+
+void read_map_attributes(struct MapData *data) {
+	char *text = read_text(MAP_ATTRIBUTES_FILE);
+	char *cursor = text;
+	for (char *line; (line = next_line(&cursor));) {
+		char *args = macro_args(line, "map_attributes");
+		char *argv[3];
+		if (!args || split_args(args, argv, 3) != 3) {
+			continue;
+		}
+		int i = find_map(data, argv[0]);
+		if (i == -1) {
+			error_exit("%s: unknown map: %s\n", MAP_ATTRIBUTES_FILE, argv[0]);
+		}
+		data->maps[i].border_block = parse_asm_number(argv[2]);
+	}
+	free(text);
+}
+
+// Returns the map with the longest name that prefixes `label`, e.g. "AzaleaTown" for "AzaleaTownRaining"
+int find_map_prefix(const struct MapData *data, const char *label) {
+	int best = -1;
+	size_t best_len = 0;
+	for (int i = 0; i < data->num_maps; i++) {
+		size_t len = strlen(data->maps[i].name);
+		if (len > best_len && !strncmp(label, data->maps[i].name, len)) {
+			best = i;
+			best_len = len;
+		}
+	}
+	return best;
+}
+
+void read_map_blocks(struct MapData *data) {
+	char *text = read_text(MAP_BLOCKS_FILE);
+	char *cursor = text;
+	int pending[0x100];
+	int num_pending = 0;
+	char *first_label = NULL;
+	for (char *line; (line = next_line(&cursor));) {
+		char *suffix = strstr(line, "_BlockData:");
+		if (suffix && !isspace((unsigned)line[0]) && strncmp(line, "SECTION", 7)) {
+			*suffix = '\0';
+			if (!first_label) {
+				first_label = xstrdup(line);
+			}
+			int i = find_map(data, line);
+			if (i != -1 && num_pending < (int)COUNTOF(pending)) {
+				pending[num_pending++] = i;
+			}
+			continue;
+		}
+		char *filename = incbin_filename(line);
+		if (!filename) {
+			continue;
+		}
+		int index = data->num_block_data++;
+		data->block_data = xrealloc(data->block_data, data->num_block_data * sizeof(*data->block_data));
+		struct BlockData *block_data = &data->block_data[index];
+		block_data->filename = filename;
+		block_data->label = first_label ? first_label : xstrdup("");
+		block_data->map = num_pending ? pending[0] : -1;
+		for (int i = 0; i < num_pending; i++) {
+			data->maps[pending[i]].block_data = index;
+		}
+		if (block_data->map == -1) {
+			// Alternate block data such as "AzaleaTownRaining" belongs to the map it is named after
+			block_data->map = find_map_prefix(data, block_data->label);
+		}
+		num_pending = 0;
+		first_label = NULL;
+	}
+	free(first_label);
+	free(text);
+}
+
+void load_map_data(struct MapData *data) {
+	*data = (struct MapData){0};
+	read_tileset_constants(data);
+	read_tilesets(data);
+	read_map_constants(data);
+	read_map_headers(data);
+	read_map_attributes(data);
+	read_map_blocks(data);
+}
+
+// Number of tiles in a tileset graphics file, from its .2bpp or else its .png
+int count_gfx_tiles(const char *filename) {
+	struct stat st;
+	if (!stat(filename, &st)) {
+		return (int)(st.st_size / TILE_SIZE);
+	}
+	size_t len = strlen(filename);
+	if (len < 5 || strcmp(filename + len - 5, ".2bpp")) {
+		return 0;
+	}
+	char *png_filename = xmalloc(len);
+	memcpy(png_filename, filename, len - 5);
+	strcpy(png_filename + len - 5, ".png");
+	int num_tiles = 0;
+	if (file_exists(png_filename)) {
+		FILE *f = xfopen(png_filename, 'r');
+		uint8_t header[24];
+		xfread(header, sizeof(header), png_filename, f);
+		fclose(f);
+		uint32_t width = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+		uint32_t height = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+		num_tiles = (int)((width / 8) * (height / 8));
+	}
+	free(png_filename);
+	return num_tiles;
+}
+
+// Number of tiles that a graphics group actually loads into VRAM
+int count_gfx_group_tiles(const struct TilesetGFX *gfx) {
+	if (!gfx->filename) {
+		return 0;
+	}
+	int num_tiles = count_gfx_tiles(gfx->filename) - gfx->first_tile;
+	return num_tiles < 0 ? 0 : num_tiles > GFX_GROUP_TILES ? GFX_GROUP_TILES : num_tiles;
+}
+
+// Loads the tiles that a tileset puts in VRAM slots, from the built .2bpp files;
+// `loaded` marks which slots the tileset fills
+uint8_t *load_tileset_vram(const struct Tileset *tileset, bool loaded[NUM_VRAM_SLOTS]) {
+	uint8_t *vram = xcalloc(NUM_VRAM_SLOTS * TILE_SIZE);
+	memset(loaded, 0, NUM_VRAM_SLOTS * sizeof(*loaded));
+	for (int g = 0; g < NUM_GFX; g++) {
+		const struct TilesetGFX *gfx = &tileset->gfx[g];
+		if (!gfx->filename) {
+			continue;
+		}
+		struct MappedFile file = map_file(gfx->filename);
+		int num_tiles = (int)(file.size / TILE_SIZE) - gfx->first_tile;
+		if (num_tiles > GFX_GROUP_TILES) {
+			num_tiles = GFX_GROUP_TILES;
+		}
+		for (int i = 0; i < num_tiles; i++) {
+			int slot = gfx_group_slots[g] + i;
+			memcpy(&vram[slot * TILE_SIZE], &file.data[(gfx->first_tile + i) * TILE_SIZE], TILE_SIZE);
+			loaded[slot] = true;
+		}
+		unmap_file(&file);
+	}
+	return vram;
+}
+
+// Per-tileset bitsets of used blocks and VRAM tile slots, as written by tileset_usage
+struct TilesetUsage {
+	uint8_t blocks[MAX_BLOCKS / 8];
+	uint8_t slots[NUM_VRAM_SLOTS / 8];
+};
+
+#define BIT_SET(bits, i) ((bits)[(i) / 8] |= 1 << ((i) % 8))
+#define BIT_TEST(bits, i) (((bits)[(i) / 8] >> ((i) % 8)) & 1)
+
+struct TilesetUsage *read_tileset_usage(const char *filename, int num_tilesets) {
+	long size;
+	uint8_t *data = read_u8(filename, &size);
+	if (size != num_tilesets * (long)sizeof(struct TilesetUsage)) {
+		error_exit("%s: expected usage for %d tilesets\n", filename, num_tilesets);
+	}
+	return (struct TilesetUsage *)data;
+}
+
+// Blocks placed by "changeblock x, y, block" in a map's script. A block given by a constant is looked up
+// in the script's own "DEF ... EQU" lines; one built from a macro argument, like UNDERGROUND_DOOR_\2,
+// marks every constant with that prefix. Returns how many blocks could not be resolved.
+int mark_script_blocks(const char *map_name, uint8_t *blocks) {
+	char filename[0x100];
+	snprintf(filename, sizeof(filename), "maps/%s.asm", map_name);
+	if (!file_exists(filename)) {
+		return 0;
+	}
+	struct { char name[0x40]; int value; } constants[0x40];
+	int num_constants = 0;
+	char *symbolic[0x40];
+	int num_symbolic = 0;
+	int num_unresolved = 0;
+	char *text = read_text(filename);
+	char *cursor = text;
+	for (char *line; (line = next_line(&cursor));) {
+		char name[0x40], value[0x20];
+		if (sscanf(line, " DEF %63s EQU %31s", name, value) == 2 && (*value == '$' || isdigit((unsigned)*value))
+			&& num_constants < (int)COUNTOF(constants)) {
+			strcpy(constants[num_constants].name, name);
+			constants[num_constants++].value = parse_asm_number(value);
+			continue;
+		}
+		char *args = macro_args(line, "changeblock");
+		char *argv[3];
+		if (!args || split_args(args, argv, 3) != 3) {
+			continue;
+		}
+		if (*argv[2] == '$' || isdigit((unsigned)*argv[2])) {
+			int block = parse_asm_number(argv[2]);
+			if (block >= 0 && block < MAX_BLOCKS) {
+				BIT_SET(blocks, block);
+			}
+		} else if (num_symbolic < (int)COUNTOF(symbolic)) {
+			symbolic[num_symbolic++] = argv[2];
+		} else {
+			num_unresolved++;
+		}
+	}
+	for (int i = 0; i < num_symbolic; i++) {
+		size_t prefix_len = strcspn(symbolic[i], "\\");
+		bool is_prefix = symbolic[i][prefix_len] == '\\';
+		bool found = false;
+		for (int c = 0; c < num_constants; c++) {
+			const char *name = constants[c].name;
+			if (is_prefix ? !strncmp(name, symbolic[i], prefix_len) : !strcmp(name, symbolic[i])) {
+				if (constants[c].value >= 0 && constants[c].value < MAX_BLOCKS) {
+					BIT_SET(blocks, constants[c].value);
+				}
+				found = true;
+			}
+		}
+		num_unresolved += !found;
+	}
+	free(text);
+	return num_unresolved;
+}
+
+// Blocks that field moves such as Cut and Whirlpool replace, and replace them with
+// (see data/collision/field_move_blocks.asm)
+void mark_field_move_blocks(const struct MapData *data, struct TilesetUsage *usage) {
+	char *text = read_text(FIELD_MOVE_BLOCKS_FILE);
+	char *cursor = text;
+	// Local labels map to tilesets; stacked labels fall through to the next "db -1"
+	struct { char *label; int tileset; } targets[0x100];
+	int num_targets = 0;
+	int active[0x100];
+	int num_active = 0;
+	for (char *line; (line = next_line(&cursor));) {
+		char *args;
+		char *argv[2];
+		if ((args = macro_args(line, "dbw")) && split_args(args, argv, 2) == 2) {
+			int tileset = find_tileset_constant(data, argv[0]);
+			if (tileset != -1 && num_targets < (int)COUNTOF(targets)) {
+				targets[num_targets].label = xstrdup(argv[1]);
+				targets[num_targets++].tileset = tileset;
+			}
+		} else if (line[0] == '.') {
+			for (int i = 0; i < num_targets; i++) {
+				if (!strcmp(targets[i].label, line) && num_active < (int)COUNTOF(active)) {
+					active[num_active++] = targets[i].tileset;
+				}
+			}
+		} else if ((args = macro_args(line, "db"))) {
+			int argc = split_args(args, argv, 2);
+			if (argc == 1 || !strcmp(argv[0], "-1")) {
+				num_active = 0;
+				continue;
+			}
+			for (int i = 0; i < num_active; i++) {
+				BIT_SET(usage[active[i]].blocks, parse_asm_number(argv[0]));
+				BIT_SET(usage[active[i]].blocks, parse_asm_number(argv[1]));
+			}
+		} else if (*line && !isspace((unsigned)line[0])) {
+			// A new table starts
+			num_active = 0;
+		}
+	}
+	for (int i = 0; i < num_targets; i++) {
+		free(targets[i].label);
+	}
+	free(text);
+}
+
+char *replace_extension(const char *filename, const char *old_ext, const char *new_ext) {
+	size_t len = strlen(filename), old_len = strlen(old_ext);
+	if (len < old_len || strcmp(filename + len - old_len, old_ext)) {
+		error_exit("%s: expected a %s file\n", filename, old_ext);
+	}
+	char *result = xmalloc(len - old_len + strlen(new_ext) + 1);
+	memcpy(result, filename, len - old_len);
+	strcpy(result + len - old_len, new_ext);
+	return result;
+}
+
+// Slots that must keep their tiles: those that tile animations write to (see engine/tilesets/tileset_anims.asm;
+// slots outside any "Tileset*Anim::" table are pinned for every tileset), roof slots, and any `extra` slots
+void read_tileset_pins(const struct MapData *data, uint8_t (*pinned)[NUM_VRAM_SLOTS / 8], const uint8_t *extra) {
+	char *text = read_text(TILESET_ANIMS_FILE);
+	char *cursor = text;
+	int active[0x100];
+	int num_active = 0;
+	bool stacking = false;
+	uint8_t global[NUM_VRAM_SLOTS / 8] = {0};
+	for (char *line; (line = next_line(&cursor));) {
+		if (!*line) {
+			continue;
+		}
+		if (!isspace((unsigned)line[0])) {
+			// Stacked labels share one table; any other label ends it
+			if (!stacking) {
+				num_active = 0;
+			}
+			stacking = true;
+			char *colon = strchr(line, ':');
+			if (colon) {
+				*colon = '\0';
+			}
+			for (int i = 0; i < data->num_tilesets; i++) {
+				size_t len = strlen(data->tilesets[i].label);
+				if (!strncmp(line, data->tilesets[i].label, len) && !strcmp(line + len, "Anim")
+					&& num_active < (int)COUNTOF(active)) {
+					active[num_active++] = i;
+				}
+			}
+			continue;
+		}
+		stacking = false;
+		for (char *vtiles = strstr(line, "vTiles"); vtiles; vtiles = strstr(vtiles + 1, "vTiles")) {
+			int base = vtiles[6] == '2' ? 0x000 : vtiles[6] == '5' ? 0x100 : vtiles[6] == '4' ? 0x180 : -1;
+			if (base == -1 || strncmp(vtiles + 7, " tile $", strlen(" tile $"))) {
+				continue;
+			}
+			int slot = base + (int)strtol(vtiles + 7 + strlen(" tile $"), NULL, 16);
+			if (slot >= NUM_VRAM_SLOTS) {
+				continue;
+			}
+			if (num_active) {
+				for (int i = 0; i < num_active; i++) {
+					BIT_SET(pinned[active[i]], slot);
+				}
+			} else {
+				BIT_SET(global, slot);
+			}
+		}
+	}
+	free(text);
+
+	for (int i = 0; i < data->num_tilesets; i++) {
+		for (int j = 0; j < NUM_VRAM_SLOTS / 8; j++) {
+			pinned[i][j] |= global[j] | (extra ? extra[j] : 0);
+		}
+		if (data->tilesets[i].roof) {
+			for (int j = 0; j < ROOF_LENGTH; j++) {
+				BIT_SET(pinned[i], ROOF_FIRST_SLOT + j);
+			}
+		}
+	}
+}
+
+// Tilesets such as cave and quiet_cave share metatiles, attributes, and collision
+bool shares_metatiles(const struct Tileset *a, const struct Tileset *b) {
+	return !strcmp(a->metatiles_filename, b->metatiles_filename);
+}
+
+// Which graphics group a VRAM slot is loaded from, or -1
+int slot_group(int slot) {
+	for (int g = NUM_GFX - 1; g >= 0; g--) {
+		if (slot >= gfx_group_slots[g] && slot < gfx_group_slots[g] + GFX_GROUP_TILES) {
+			return g;
+		}
+	}
+	return -1;
+}
+
+#endif // GUARD_MAPDATA_H
@@ -0,0 +1,427 @@
+#define PROGRAM_NAME "pack_frames"
+#define USAGE_OPTS "[-h|--help] [-v|--verbose]"
+
+#include "common.h"
+#include "mapdata.h"
+#include "tilepng.h"
+#include "pokemon_animation.h"
+
+// Reports how much ROM the Pokémon animation bitmasks and frames would take if they were shared across species.
+// The engine (engine/gfx/pic_animation.asm) reads them like this:
+// - BitmasksPointers[species] points to a table of fixed-size bitmasks (4, 5, or 7 bytes for 5x5, 6x6, or 7x7 pics),
+//   indexed by a one-byte ID, so species with the same dimensions can index into one shared pool of up to 256
+// - FramesPointers[species] points to a table of frame pointers, each to a bitmask ID followed by one tile per set bit,
+//   so a frame can start anywhere in another frame's bytes of the same bank (KantoFrames or JohtoFrames)
+// The order of tiles within a frame is fixed by the engine's bit scan, so pooling is what is left to optimize.
+
+#define BITMASKS_FILE "gfx/pokemon/bitmasks.asm"
+#define KANTO_FRAMES_FILE "gfx/pokemon/kanto_frames.asm"
+#define JOHTO_FRAMES_FILE "gfx/pokemon/johto_frames.asm"
+
+#define MAX_POOL_SIZE 256 // bitmask IDs are one byte
+#define MAX_FRAME_SIZE (1 + 7 * 7)
+
+struct Options {
+	bool verbose;
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"verbose", no_argument, 0, 'v'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "vh", long_options)) != -1;) {
+		switch (opt) {
+		case 'v':
+			options->verbose = true;
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+enum Bank { KANTO_BANK, JOHTO_BANK, NUM_BANKS };
+
+const char *bank_names[NUM_BANKS] = {"KantoFrames", "JohtoFrames"};
+
+struct Species {
+	char *dir;
+	enum Bank bank;
+	int width;
+	struct Frames frames;
+	struct Bitmasks bitmasks;
+	int pool;
+	uint8_t *pool_ids; // pool ID of each of the species' own bitmasks
+};
+
+struct Pool {
+	int width;
+	const uint8_t *bitmasks[MAX_POOL_SIZE];
+	int num_bitmasks;
+	int slots[MAX_POOL_SIZE * 2]; // indexes into bitmasks, or -1 for empty
+	int num_species;
+};
+
+struct Packer {
+	struct Species *species;
+	int num_species;
+	struct Pool *pools;
+	int num_pools;
+	struct Arena arena; // every species' frames and bitmasks
+};
+
+int bitmask_size(int width) {
+	return (width * width + 7) / 8;
+}
+
+// Reads each "Label: INCLUDE "gfx/pokemon/<dir>/frames.asm"" line of a frames bank
+void read_frames_bank(struct Packer *packer, const char *filename, enum Bank bank) {
+	char *text = read_text(filename);
+	char *cursor = text;
+	for (char *line; (line = next_line(&cursor));) {
+		char *path = strstr(line, "INCLUDE \"");
+		if (!path) {
+			continue;
+		}
+		path += strlen("INCLUDE \"");
+		char *end = strstr(path, "/frames.asm\"");
+		if (!end) {
+			error_exit("%s: unexpected INCLUDE: %s\n", filename, line);
+		}
+		packer->species = xrealloc(packer->species, (packer->num_species + 1) * sizeof(*packer->species));
+		packer->species[packer->num_species++] = (struct Species){
+			.dir = xstrndup(path, end - path),
+			.bank = bank,
+		};
+	}
+	free(text);
+}
+
+// Builds the species' frames and bitmasks exactly as pokemon_front does
+void load_species(struct Species *species, struct Arena *arena) {
+	char *filename = species_path(species->dir, "front.png");
+	uint32_t width_px = read_png_width(filename);
+	if (width_px != 40 && width_px != 48 && width_px != 56) {
+		error_exit("Not a valid width for \"%s\": %" PRIu32 " px\n", filename, width_px);
+	}
+	species->width = width_px / 8;
+
+	int num_tiles;
+	uint8_t *tiles = read_png_tiles(filename, &num_tiles);
+	long tiles_size = num_tiles * TILE_SIZE;
+	transpose_frames(tiles, tiles_size, species->width, filename);
+	long tilemap_size;
+	uint8_t *tilemap = make_animated_tilemap(tiles, tiles_size, species->width * species->width, false, &tilemap_size);
+	make_frames(tilemap, tilemap_size, species->width, &species->frames, &species->bitmasks, arena);
+
+	free(tilemap);
+	free(tiles);
+	free(filename);
+}
+
+// Returns the slot holding `bitmask` in the pool, or the empty slot where it would go
+int *find_pool_slot(struct Pool *pool, const uint8_t *bitmask) {
+	int size = bitmask_size(pool->width);
+	int mask = COUNTOF(pool->slots) - 1;
+	for (int i = hash_bytes(bitmask, size) & mask;; i = (i + 1) & mask) {
+		int *slot = &pool->slots[i];
+		if (*slot == -1 || !memcmp(bitmask, pool->bitmasks[*slot], size)) {
+			return slot;
+		}
+	}
+}
+
+int count_new_bitmasks(struct Pool *pool, const struct Species *species) {
+	int count = 0;
+	for (int i = 0; i < species->bitmasks.num_bitmasks; i++) {
+		count += *find_pool_slot(pool, species->bitmasks.bitmasks[i].data) == -1;
+	}
+	return count;
+}
+
+struct Pool *new_pool(struct Packer *packer, int width) {
+	packer->pools = xrealloc(packer->pools, (packer->num_pools + 1) * sizeof(*packer->pools));
+	struct Pool *pool = &packer->pools[packer->num_pools++];
+	pool->width = width;
+	pool->num_bitmasks = 0;
+	pool->num_species = 0;
+	memset(pool->slots, 0xff, sizeof(pool->slots));
+	return pool;
+}
+
+// Gives each species an ID in a pool of bitmasks shared by species of the same dimensions:
+// the pool it adds the fewest new bitmasks to without outgrowing one-byte IDs, or else a new one
+void pool_bitmasks(struct Packer *packer) {
+	for (int s = 0; s < packer->num_species; s++) {
+		struct Species *species = &packer->species[s];
+		int p = -1, best_count = 0;
+		for (int i = 0; i < packer->num_pools; i++) {
+			struct Pool *candidate = &packer->pools[i];
+			if (candidate->width != species->width) {
+				continue;
+			}
+			int count = count_new_bitmasks(candidate, species);
+			if (candidate->num_bitmasks + count <= MAX_POOL_SIZE && (p == -1 || count < best_count)) {
+				p = i;
+				best_count = count;
+			}
+		}
+		if (p == -1) {
+			new_pool(packer, species->width);
+			p = packer->num_pools - 1;
+		}
+		struct Pool *pool = &packer->pools[p];
+		species->pool = p;
+		pool->num_species++;
+		species->pool_ids = xmalloc(species->bitmasks.num_bitmasks ? species->bitmasks.num_bitmasks : 1);
+		for (int i = 0; i < species->bitmasks.num_bitmasks; i++) {
+			const uint8_t *bitmask = species->bitmasks.bitmasks[i].data;
+			int *slot = find_pool_slot(pool, bitmask);
+			if (*slot == -1) {
+				*slot = pool->num_bitmasks;
+				pool->bitmasks[pool->num_bitmasks++] = bitmask;
+			}
+			species->pool_ids[i] = *slot;
+		}
+	}
+}
+
+// A frame's bytes as frames.asm has them: its bitmask ID, then each changed tile
+int encode_frame(const struct Frames *frames, const struct Frame *frame, int bitmask_id, uint8_t *output) {
+	output[0] = bitmask_id;
+	for (int i = 0; i < frame->size; i++) {
+		output[i + 1] = frame_tile_offset(frames, frame->data[i]);
+	}
+	return frame->size + 1;
+}
+
+struct FrameString {
+	uint8_t bytes[MAX_FRAME_SIZE];
+	int size;
+	int container; // the longer unique frame holding this one, or -1 if it is stored itself
+};
+
+struct FrameSet {
+	struct FrameString *strings;
+	int num_strings;
+	int *slots;
+	int capacity;
+};
+
+int *find_frame_slot(const struct FrameSet *set, const uint8_t *bytes, int size) {
+	int mask = set->capacity - 1;
+	for (int i = hash_bytes(bytes, size) & mask;; i = (i + 1) & mask) {
+		int *slot = &set->slots[i];
+		if (*slot == -1 || (set->strings[*slot].size == size && !memcmp(bytes, set->strings[*slot].bytes, size))) {
+			return slot;
+		}
+	}
+}
+
+// Returns the ID of the unique frame with these bytes, adding it if it is new
+int add_frame_string(struct FrameSet *set, const uint8_t *bytes, int size) {
+	int *slot = find_frame_slot(set, bytes, size);
+	if (*slot == -1) {
+		*slot = set->num_strings;
+		struct FrameString *string = &set->strings[set->num_strings++];
+		memcpy(string->bytes, bytes, size);
+		string->size = size;
+		string->container = -1;
+	}
+	return *slot;
+}
+
+bool contains_bytes(const struct FrameString *haystack, const struct FrameString *needle) {
+	for (int i = 0; i + needle->size <= haystack->size; i++) {
+		if (!memcmp(&haystack->bytes[i], needle->bytes, needle->size)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+struct BankReport {
+	int num_species;
+	int num_frames;
+	long old_bytes;
+	int num_unique;
+	int num_contained;
+	long frame_bytes;
+	int num_shared_tables;
+	long table_bytes;
+};
+
+// Stores a frame once per bank no matter how many species use it, and not at all if its bytes
+// occur inside a longer frame; species whose frame pointer tables are equal (or a prefix of
+// another's) share one table
+void pack_bank(const struct Packer *packer, enum Bank bank, struct BankReport *report) {
+	int max_frames = 0;
+	for (int s = 0; s < packer->num_species; s++) {
+		const struct Species *species = &packer->species[s];
+		if (species->bank != bank) {
+			continue;
+		}
+		report->num_species++;
+		max_frames += species->frames.num_frames;
+		report->old_bytes += species->frames.num_frames * 2;
+		for (int i = 0; i < species->frames.num_frames; i++) {
+			report->old_bytes += species->frames.frames[i].size + 1;
+		}
+	}
+	report->num_frames = max_frames;
+
+	struct FrameSet set = {0};
+	set.strings = xmalloc((max_frames ? max_frames : 1) * sizeof(*set.strings));
+	set.capacity = 16;
+	while (set.capacity < max_frames * 2) {
+		set.capacity *= 2;
+	}
+	set.slots = xmalloc(set.capacity * sizeof(*set.slots));
+	memset(set.slots, 0xff, set.capacity * sizeof(*set.slots));
+
+	int **tables = xcalloc(packer->num_species * sizeof(*tables));
+	for (int s = 0; s < packer->num_species; s++) {
+		const struct Species *species = &packer->species[s];
+		if (species->bank != bank) {
+			continue;
+		}
+		tables[s] = xmalloc((species->frames.num_frames ? species->frames.num_frames : 1) * sizeof(**tables));
+		for (int i = 0; i < species->frames.num_frames; i++) {
+			const struct Frame *frame = &species->frames.frames[i];
+			uint8_t bytes[MAX_FRAME_SIZE];
+			int size = encode_frame(&species->frames, frame, species->pool_ids[frame->bitmask], bytes);
+			tables[s][i] = add_frame_string(&set, bytes, size);
+		}
+	}
+	report->num_unique = set.num_strings;
+
+	// Longest first, so each frame only needs checking against the frames that are stored
+	int *order = xmalloc((set.num_strings ? set.num_strings : 1) * sizeof(*order));
+	for (int i = 0; i < set.num_strings; i++) {
+		order[i] = i;
+	}
+	for (int i = 1; i < set.num_strings; i++) {
+		int id = order[i], j = i;
+		for (; j > 0 && set.strings[order[j - 1]].size < set.strings[id].size; j--) {
+			order[j] = order[j - 1];
+		}
+		order[j] = id;
+	}
+	for (int i = 0; i < set.num_strings; i++) {
+		struct FrameString *string = &set.strings[order[i]];
+		for (int j = 0; j < i && string->container == -1; j++) {
+			const struct FrameString *stored = &set.strings[order[j]];
+			if (stored->container == -1 && stored->size > string->size && contains_bytes(stored, string)) {
+				string->container = order[j];
+			}
+		}
+		if (string->container == -1) {
+			report->frame_bytes += string->size;
+		} else {
+			report->num_contained++;
+		}
+	}
+
+	for (int s = 0; s < packer->num_species; s++) {
+		const struct Species *species = &packer->species[s];
+		if (species->bank != bank) {
+			continue;
+		}
+		bool shared = false;
+		for (int t = 0; t < packer->num_species && !shared; t++) {
+			const struct Species *other = &packer->species[t];
+			if (t == s || other->bank != bank || other->frames.num_frames < species->frames.num_frames
+				|| (other->frames.num_frames == species->frames.num_frames && t > s)) {
+				continue;
+			}
+			shared = !memcmp(tables[s], tables[t], species->frames.num_frames * sizeof(**tables));
+		}
+		if (shared) {
+			report->num_shared_tables++;
+		} else {
+			report->table_bytes += species->frames.num_frames * 2;
+		}
+	}
+
+	for (int s = 0; s < packer->num_species; s++) {
+		free(tables[s]);
+	}
+	free(tables);
+	free(order);
+	free(set.slots);
+	free(set.strings);
+}
+
+int main(int argc, char *argv[]) {
+	struct Options options = {0};
+	parse_args(argc, argv, &options);
+
+	argc -= optind;
+	argv += optind;
+	if (argc) {
+		usage_exit(1);
+	}
+
+	struct Packer packer = {0};
+	read_frames_bank(&packer, KANTO_FRAMES_FILE, KANTO_BANK);
+	read_frames_bank(&packer, JOHTO_FRAMES_FILE, JOHTO_BANK);
+	for (int s = 0; s < packer.num_species; s++) {
+		load_species(&packer.species[s], &packer.arena);
+	}
+	pool_bitmasks(&packer);
+
+	long old_bitmask_bytes = 0, new_bitmask_bytes = 0;
+	int old_num_bitmasks = 0;
+	for (int s = 0; s < packer.num_species; s++) {
+		const struct Species *species = &packer.species[s];
+		old_num_bitmasks += species->bitmasks.num_bitmasks;
+		old_bitmask_bytes += species->bitmasks.num_bitmasks * bitmask_size(species->width);
+	}
+	printf("%s: %d species, %d bitmasks, %ld bytes\n", BITMASKS_FILE, packer.num_species, old_num_bitmasks, old_bitmask_bytes);
+	for (int p = 0; p < packer.num_pools; p++) {
+		const struct Pool *pool = &packer.pools[p];
+		long bytes = pool->num_bitmasks * bitmask_size(pool->width);
+		new_bitmask_bytes += bytes;
+		printf("\tpool %d: %dx%d, %d species share %d bitmasks, %ld bytes\n",
+			p, pool->width, pool->width, pool->num_species, pool->num_bitmasks, bytes);
+		if (options.verbose) {
+			for (int s = 0; s < packer.num_species; s++) {
+				if (packer.species[s].pool == p) {
+					printf("\t\t%s\n", packer.species[s].dir);
+				}
+			}
+		}
+	}
+	printf("\tpooled: %ld bytes, saves %ld\n\n", new_bitmask_bytes, old_bitmask_bytes - new_bitmask_bytes);
+
+	long old_frames_bytes = 0, new_frames_bytes = 0;
+	for (enum Bank bank = 0; bank < NUM_BANKS; bank++) {
+		struct BankReport report = {0};
+		pack_bank(&packer, bank, &report);
+		long bytes = report.frame_bytes + report.table_bytes;
+		old_frames_bytes += report.old_bytes;
+		new_frames_bytes += bytes;
+		printf("%s: %d species, %d frames, %ld bytes\n", bank_names[bank], report.num_species, report.num_frames, report.old_bytes);
+		printf("\t%d unique frames, %d of them inside longer ones: %ld bytes\n",
+			report.num_unique, report.num_contained, report.frame_bytes);
+		printf("\t%d frame pointer tables reuse another's: %ld bytes\n", report.num_shared_tables, report.table_bytes);
+		printf("\tshared: %ld bytes, saves %ld\n\n", bytes, report.old_bytes - bytes);
+	}
+
+	long old_total = old_bitmask_bytes + old_frames_bytes, new_total = new_bitmask_bytes + new_frames_bytes;
+	printf("total: %ld -> %ld bytes, saves %ld bytes of ROM\n", old_total, new_total, old_total - new_total);
+
+	for (int s = 0; s < packer.num_species; s++) {
+		free(packer.species[s].dir);
+		free(packer.species[s].pool_ids);
+	}
+	free(packer.species);
+	free(packer.pools);
+	arena_free(&packer.arena);
+	return 0;
+}
@@ -0,0 +1,508 @@
+#define PROGRAM_NAME "pack_vram"
+#define USAGE_OPTS "[-h|--help] [-d|--outdir dir] [-p|--pin slot[,slot...]] usage.bin [tileset...]"
+
+#include "common.h"
+#include "mapdata.h"
+#include "tilepng.h"
+
+struct Options {
+	const char *outdir;
+	uint8_t pinned[NUM_VRAM_SLOTS / 8];
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"outdir", required_argument, 0, 'd'},
+		{"pin", required_argument, 0, 'p'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "d:p:h", long_options)) != -1;) {
+		switch (opt) {
+		case 'd':
+			options->outdir = optarg;
+			break;
+		case 'p':
+			for (char *token = strtok(optarg, ","); token; token = strtok(NULL, ",")) {
+				unsigned long slot = strtoul(token, NULL, 0);
+				if (slot >= NUM_VRAM_SLOTS) {
+					error_exit("Invalid VRAM slot: %s\n", token);
+				}
+				BIT_SET(options->pinned, slot);
+			}
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+// Every map load decompresses and transfers each non-empty group (see _LoadTilesetGFX in home/map.asm);
+// GFX0 goes to VRAM bank 0, and GFX1 and GFX2 to bank 1
+#define GROUP_BANK(g) ((g) != GFX0)
+
+// Tilesets that load the same files into the same groups are packed together
+struct Class {
+	int tilesets[0x40];
+	int num_tilesets;
+	int num_maps;
+	uint8_t used[NUM_VRAM_SLOTS / 8];
+	uint8_t pinned[NUM_VRAM_SLOTS / 8];
+	bool movable[NUM_GFX]; // the group's file is loaded only by this class
+	bool loaded[NUM_GFX]; // currently non-empty
+	bool forced[NUM_GFX]; // has to stay loaded
+	int num_used[NUM_GFX]; // tiles that metatiles use, not counting pinned ones
+	int num_free[NUM_GFX]; // slots that can take another group's tiles
+	int chosen; // bitmask of the groups to load after packing
+	int remap[NUM_VRAM_SLOTS];
+};
+
+struct Packer {
+	struct MapData data;
+	struct Options options;
+	struct TilesetUsage *usage;
+	uint8_t (*pinned)[NUM_VRAM_SLOTS / 8]; // per tileset
+	bool *selected; // per tileset
+	struct Class *classes;
+	int num_classes;
+};
+
+bool same_gfx(const struct Tileset *a, const struct Tileset *b) {
+	for (int g = 0; g < NUM_GFX; g++) {
+		const struct TilesetGFX *x = &a->gfx[g], *y = &b->gfx[g];
+		if (!x->filename != !y->filename || (x->filename && (strcmp(x->filename, y->filename) || x->first_tile != y->first_tile))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool loads_file(const struct Tileset *tileset, const char *filename) {
+	for (int g = 0; g < NUM_GFX; g++) {
+		if (tileset->gfx[g].filename && !strcmp(tileset->gfx[g].filename, filename)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool in_class(const struct Class *class, int t) {
+	for (int i = 0; i < class->num_tilesets; i++) {
+		if (class->tilesets[i] == t) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void collect_classes(struct Packer *packer) {
+	const struct MapData *data = &packer->data;
+	for (int t = 0; t < data->num_tilesets; t++) {
+		int c = 0;
+		while (c < packer->num_classes && !same_gfx(&data->tilesets[packer->classes[c].tilesets[0]], &data->tilesets[t])) {
+			c++;
+		}
+		if (c == packer->num_classes) {
+			packer->classes = xrealloc(packer->classes, ++packer->num_classes * sizeof(*packer->classes));
+			memset(&packer->classes[c], 0, sizeof(*packer->classes));
+		}
+		struct Class *class = &packer->classes[c];
+		if (class->num_tilesets == (int)COUNTOF(class->tilesets)) {
+			error_exit("Too many tilesets load the same graphics as %s\n", data->tilesets[t].name);
+		}
+		class->tilesets[class->num_tilesets++] = t;
+		for (int m = 0; m < data->num_maps; m++) {
+			class->num_maps += data->maps[m].tileset == t;
+		}
+		for (int i = 0; i < NUM_VRAM_SLOTS / 8; i++) {
+			class->used[i] |= packer->usage[t].slots[i];
+			class->pinned[i] |= packer->pinned[t][i];
+		}
+	}
+}
+
+// A group can be packed if nothing outside the class loads its file,
+// and no tileset outside the class shares the class's metatiles
+bool is_movable(const struct Packer *packer, const struct Class *class, int g) {
+	const struct MapData *data = &packer->data;
+	const struct Tileset *tileset = &data->tilesets[class->tilesets[0]];
+	if (!tileset->gfx[g].filename) {
+		return false;
+	}
+	for (int t = 0; t < data->num_tilesets; t++) {
+		if (in_class(class, t)) {
+			if (!packer->selected[t]) {
+				return false;
+			}
+			continue;
+		}
+		for (int i = 0; i < class->num_tilesets; i++) {
+			if (shares_metatiles(&data->tilesets[t], &data->tilesets[class->tilesets[i]])) {
+				return false;
+			}
+		}
+		if (loads_file(&data->tilesets[t], tileset->gfx[g].filename)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Another group of the same file that starts later, or -1
+int next_slice(const struct Tileset *tileset, int g) {
+	int next = -1;
+	for (int h = 0; h < NUM_GFX; h++) {
+		const struct TilesetGFX *a = &tileset->gfx[g], *b = &tileset->gfx[h];
+		if (b->filename && !strcmp(a->filename, b->filename) && b->first_tile > a->first_tile
+			&& (next == -1 || b->first_tile < tileset->gfx[next].first_tile)) {
+			next = h;
+		}
+	}
+	return next;
+}
+
+bool is_first_slice(const struct Tileset *tileset, int g) {
+	for (int h = 0; h < NUM_GFX; h++) {
+		const struct TilesetGFX *a = &tileset->gfx[g], *b = &tileset->gfx[h];
+		if (b->filename && !strcmp(a->filename, b->filename) && b->first_tile < a->first_tile) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int count_groups(int loaded, int *num_banks) {
+	int num_groups = 0;
+	bool banks[2] = {false, false};
+	for (int g = 0; g < NUM_GFX; g++) {
+		if (loaded & (1 << g)) {
+			num_groups++;
+			banks[GROUP_BANK(g)] = true;
+		}
+	}
+	*num_banks = banks[0] + banks[1];
+	return num_groups;
+}
+
+int loaded_mask(const struct Class *class) {
+	int mask = 0;
+	for (int g = 0; g < NUM_GFX; g++) {
+		mask |= class->loaded[g] << g;
+	}
+	return mask;
+}
+
+// Picks the groups to load: fewest groups, then fewest VRAM banks, then fewest moved tiles.
+// Tiles stay in their slots unless their group is dropped; a file can only lose its last slices,
+// since the "%.2bpp.vramN" slices are cut at fixed offsets.
+void plan_class(const struct Packer *packer, struct Class *class) {
+	const struct Tileset *tileset = &packer->data.tilesets[class->tilesets[0]];
+	int movable = 0, fixed = 0;
+	for (int g = 0; g < NUM_GFX; g++) {
+		const struct TilesetGFX *gfx = &tileset->gfx[g];
+		class->loaded[g] = count_gfx_group_tiles(gfx) > 0;
+		class->movable[g] = is_movable(packer, class, g);
+		if (!class->movable[g]) {
+			fixed |= class->loaded[g] << g;
+			continue;
+		}
+		movable |= 1 << g;
+		int num_tiles = count_gfx_tiles(gfx->filename);
+		int next = next_slice(tileset, g);
+		// The last slice of a file can grow; earlier ones end where the next one starts
+		int end = next == -1 ? gfx->first_tile + GFX_GROUP_TILES : tileset->gfx[next].first_tile;
+		class->forced[g] = is_first_slice(tileset, g);
+		for (int i = 0; i < GFX_GROUP_TILES && gfx->first_tile + i < end; i++) {
+			int slot = gfx_group_slots[g] + i;
+			bool used = BIT_TEST(class->used, slot);
+			if (BIT_TEST(class->pinned, slot)) {
+				class->forced[g] |= used;
+			} else if (!used) {
+				class->num_free[g]++;
+			} else if (gfx->first_tile + i < num_tiles) {
+				class->num_used[g]++;
+			}
+		}
+	}
+
+	int best = loaded_mask(class), best_groups, best_banks, best_moved = 0;
+	best_groups = count_groups(best, &best_banks);
+	for (int mask = 0; mask < 1 << NUM_GFX; mask++) {
+		if (mask & ~movable) {
+			continue;
+		}
+		int capacity = 0, needed = 0;
+		bool valid = true;
+		for (int g = 0; g < NUM_GFX; g++) {
+			if (!(movable & (1 << g))) {
+				continue;
+			}
+			if (mask & (1 << g)) {
+				capacity += class->num_free[g];
+				// Keeping a slice keeps every slice before it
+				for (int h = 0; h < NUM_GFX; h++) {
+					if ((movable & (1 << h)) && next_slice(tileset, h) == g && !(mask & (1 << h))) {
+						valid = false;
+					}
+				}
+			} else {
+				needed += class->num_used[g];
+				valid &= !class->forced[g];
+			}
+		}
+		if (!valid || needed > capacity) {
+			continue;
+		}
+		int banks, groups = count_groups(mask | fixed, &banks);
+		if (groups < best_groups || (groups == best_groups
+			&& (banks < best_banks || (banks == best_banks && needed < best_moved)))) {
+			best = mask | fixed;
+			best_groups = groups;
+			best_banks = banks;
+			best_moved = needed;
+		}
+	}
+	class->chosen = best;
+
+	// Tiles of dropped groups fill the free slots of kept groups, in slot order
+	for (int slot = 0; slot < NUM_VRAM_SLOTS; slot++) {
+		class->remap[slot] = slot;
+	}
+	int target_group = 0, target = 0;
+	for (int g = 0; g < NUM_GFX; g++) {
+		if (!(movable & (1 << g)) || (class->chosen & (1 << g))) {
+			continue;
+		}
+		const struct TilesetGFX *gfx = &tileset->gfx[g];
+		int num_tiles = count_gfx_tiles(gfx->filename);
+		for (int i = 0; i < GFX_GROUP_TILES && gfx->first_tile + i < num_tiles; i++) {
+			int slot = gfx_group_slots[g] + i;
+			if (!BIT_TEST(class->used, slot) || BIT_TEST(class->pinned, slot)) {
+				continue;
+			}
+			for (;; target++) {
+				if (target == GFX_GROUP_TILES) {
+					target_group++;
+					target = 0;
+				}
+				if (target_group == NUM_GFX) {
+					error_exit("%s: ran out of free slots\n", tileset->name);
+				}
+				int free_slot = gfx_group_slots[target_group] + target;
+				if ((class->chosen & (1 << target_group)) && (movable & (1 << target_group))
+					&& !BIT_TEST(class->used, free_slot) && !BIT_TEST(class->pinned, free_slot)
+					&& !(next_slice(tileset, target_group) != -1
+						&& tileset->gfx[target_group].first_tile + target >= tileset->gfx[next_slice(tileset, target_group)].first_tile)) {
+					break;
+				}
+			}
+			class->remap[slot] = gfx_group_slots[target_group] + target++;
+		}
+	}
+}
+
+struct PackedFile {
+	const char *filename; // .2bpp
+	uint8_t *tiles;
+	int num_tiles;
+	int new_num_tiles;
+};
+
+struct PackedFile *find_packed_file(struct PackedFile *files, int num_files, const char *filename) {
+	for (int i = 0; i < num_files; i++) {
+		if (!strcmp(files[i].filename, filename)) {
+			return &files[i];
+		}
+	}
+	return NULL;
+}
+
+// Rewrites the class's graphics files: moved tiles go to their new slots,
+// and files lose the slices of dropped groups
+void write_graphics(const struct Packer *packer, const struct Class *class) {
+	const struct Tileset *tileset = &packer->data.tilesets[class->tilesets[0]];
+	struct PackedFile files[NUM_GFX];
+	int num_files = 0;
+	for (int g = 0; g < NUM_GFX; g++) {
+		const struct TilesetGFX *gfx = &tileset->gfx[g];
+		if (!class->movable[g] || find_packed_file(files, num_files, gfx->filename)) {
+			continue;
+		}
+		struct PackedFile *file = &files[num_files++];
+		file->filename = gfx->filename;
+		char *png_filename = replace_extension(gfx->filename, ".2bpp", ".png");
+		uint8_t *tiles = read_png_tiles(png_filename, &file->num_tiles);
+		free(png_filename);
+		// Room for a full slice past every group's start
+		file->tiles = xcalloc((file->num_tiles + NUM_GFX * (GFX_GROUP_TILES + 1)) * TILE_SIZE);
+		memcpy(file->tiles, tiles, file->num_tiles * TILE_SIZE);
+		free(tiles);
+		file->new_num_tiles = file->num_tiles;
+	}
+	for (int g = 0; g < NUM_GFX; g++) {
+		const struct TilesetGFX *gfx = &tileset->gfx[g];
+		if (class->movable[g] && !(class->chosen & (1 << g))) {
+			struct PackedFile *file = find_packed_file(files, num_files, gfx->filename);
+			if (file && file->new_num_tiles > gfx->first_tile) {
+				file->new_num_tiles = gfx->first_tile;
+			}
+		}
+	}
+	for (int slot = 0; slot < NUM_VRAM_SLOTS; slot++) {
+		int new_slot = class->remap[slot];
+		if (new_slot == slot) {
+			continue;
+		}
+		const struct TilesetGFX *from = &tileset->gfx[slot_group(slot)], *to = &tileset->gfx[slot_group(new_slot)];
+		const struct PackedFile *src = find_packed_file(files, num_files, from->filename);
+		struct PackedFile *dst = find_packed_file(files, num_files, to->filename);
+		int src_tile = from->first_tile + slot - gfx_group_slots[slot_group(slot)];
+		int dst_tile = to->first_tile + new_slot - gfx_group_slots[slot_group(new_slot)];
+		memcpy(&dst->tiles[dst_tile * TILE_SIZE], &src->tiles[src_tile * TILE_SIZE], TILE_SIZE);
+		if (dst->new_num_tiles <= dst_tile) {
+			dst->new_num_tiles = dst_tile + 1;
+		}
+	}
+	for (int i = 0; i < num_files; i++) {
+		struct PackedFile *file = &files[i];
+		char *bpp_filename = output_path(packer->options.outdir, file->filename);
+		write_u8(bpp_filename, file->tiles, file->new_num_tiles * TILE_SIZE);
+		char *png_filename = replace_extension(bpp_filename, ".2bpp", ".png");
+		write_png_tiles(png_filename, file->tiles, file->new_num_tiles);
+		printf("\t%s: %d -> %d tiles\n", file->filename, file->num_tiles, file->new_num_tiles);
+		free(bpp_filename);
+		free(png_filename);
+		free(file->tiles);
+	}
+}
+
+// Points metatiles at the moved tiles, switching their VRAM bank attribute as needed
+void write_metatiles(const struct Packer *packer, const struct Class *class) {
+	for (int i = 0; i < class->num_tilesets; i++) {
+		const struct Tileset *tileset = &packer->data.tilesets[class->tilesets[i]];
+		bool first = true;
+		for (int j = 0; j < i; j++) {
+			first &= !shares_metatiles(&packer->data.tilesets[class->tilesets[j]], tileset);
+		}
+		if (!first) {
+			continue;
+		}
+		long metatiles_size, attributes_size;
+		uint8_t *metatiles = read_u8(tileset->metatiles_filename, &metatiles_size);
+		uint8_t *attributes = read_u8(tileset->attributes_filename, &attributes_size);
+		if (metatiles_size != attributes_size) {
+			error_exit("%s: metatiles and attributes do not match\n", tileset->name);
+		}
+		for (long j = 0; j < metatiles_size; j++) {
+			int slot = class->remap[VRAM_SLOT(metatiles[j], attributes[j])];
+			metatiles[j] = slot & 0xff;
+			attributes[j] = (attributes[j] & ~ATTR_BANK1) | (slot >= 0x100 ? ATTR_BANK1 : 0);
+		}
+		char *path = output_path(packer->options.outdir, tileset->metatiles_filename);
+		write_u8(path, metatiles, metatiles_size);
+		free(path);
+		path = output_path(packer->options.outdir, tileset->attributes_filename);
+		write_u8(path, attributes, attributes_size);
+		free(path);
+		free(metatiles);
+		free(attributes);
+	}
+}
+
+void print_groups(int mask) {
+	static const char *names[NUM_GFX] = {"GFX0", "GFX1", "GFX2"};
+	bool any = false;
+	for (int g = 0; g < NUM_GFX; g++) {
+		if (mask & (1 << g)) {
+			printf("%s%s", any ? " " : "", names[g]);
+			any = true;
+		}
+	}
+	if (!any) {
+		printf("none");
+	}
+}
+
+int main(int argc, char *argv[]) {
+	struct Packer packer = {0};
+	parse_args(argc, argv, &packer.options);
+
+	argc -= optind;
+	argv += optind;
+	if (argc < 1) {
+		usage_exit(1);
+	}
+
+	load_map_data(&packer.data);
+	int num_tilesets = packer.data.num_tilesets;
+	packer.usage = read_tileset_usage(argv[0], num_tilesets);
+	packer.pinned = xcalloc(num_tilesets * sizeof(*packer.pinned));
+	packer.selected = xcalloc(num_tilesets * sizeof(*packer.selected));
+	for (int i = 1; i < argc; i++) {
+		bool found = false;
+		for (int t = 0; t < num_tilesets; t++) {
+			if (!strcmp(argv[i], packer.data.tilesets[t].name)) {
+				packer.selected[t] = found = true;
+			}
+		}
+		if (!found) {
+			error_exit("Unknown tileset: \"%s\"\n", argv[i]);
+		}
+	}
+	if (argc == 1) {
+		for (int t = 0; t < num_tilesets; t++) {
+			packer.selected[t] = true;
+		}
+	}
+
+	read_tileset_pins(&packer.data, packer.pinned, packer.options.pinned);
+	collect_classes(&packer);
+
+	long loads_before = 0, loads_after = 0, banks_before = 0, banks_after = 0;
+	for (int c = 0; c < packer.num_classes; c++) {
+		struct Class *class = &packer.classes[c];
+		plan_class(&packer, class);
+		int before_banks, after_banks;
+		int before = count_groups(loaded_mask(class), &before_banks);
+		int after = count_groups(class->chosen, &after_banks);
+		// Weighed by how many maps use the tileset, as a rough count of map loads
+		loads_before += (long)before * class->num_maps;
+		loads_after += (long)after * class->num_maps;
+		banks_before += (long)before_banks * class->num_maps;
+		banks_after += (long)after_banks * class->num_maps;
+		if (class->chosen == loaded_mask(class)) {
+			continue;
+		}
+
+		int moved = 0;
+		for (int slot = 0; slot < NUM_VRAM_SLOTS; slot++) {
+			moved += class->remap[slot] != slot;
+		}
+		for (int i = 0; i < class->num_tilesets; i++) {
+			printf("%s%s", i ? ", " : "", packer.data.tilesets[class->tilesets[i]].name);
+		}
+		printf(": ");
+		print_groups(loaded_mask(class));
+		printf(" -> ");
+		print_groups(class->chosen);
+		printf(", %d tiles moved, %d -> %d VRAM banks, %d maps\n", moved, before_banks, after_banks, class->num_maps);
+		for (int slot = 0; slot < NUM_VRAM_SLOTS; slot++) {
+			if (class->remap[slot] != slot) {
+				printf("\tslot $%03x -> $%03x\n", slot, class->remap[slot]);
+			}
+		}
+		write_graphics(&packer, class);
+		write_metatiles(&packer, class);
+	}
+	printf("group loads over all maps: %ld -> %ld; VRAM banks touched: %ld -> %ld\n",
+		loads_before, loads_after, banks_before, banks_after);
+
+	free(packer.classes);
+	free(packer.usage);
+	free(packer.pinned);
+	free(packer.selected);
+	return 0;
+}
@@ -0,0 +1,71 @@
+#ifndef GUARD_PARALLEL_H
+#define GUARD_PARALLEL_H
+
+// Include common.h before this header, and build with -pthread
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#define MAX_THREADS 64
+
+struct ParallelJob {
+	void (*function)(int index, int thread, void *arg);
+	void *arg;
+	int count;
+	atomic_int next_index;
+};
+
+struct ParallelWorker {
+	struct ParallelJob *job;
+	int thread;
+};
+
+void *parallel_worker(void *arg) {
+	struct ParallelWorker *worker = arg;
+	struct ParallelJob *job = worker->job;
+	// Each idle thread claims the next unprocessed item, so uneven items balance out
+	for (int i; (i = atomic_fetch_add(&job->next_index, 1)) < job->count;) {
+		job->function(i, worker->thread, job->arg);
+	}
+	return NULL;
+}
+
+int parallel_num_threads(int requested) {
+	if (requested > 0) {
+		return requested < MAX_THREADS ? requested : MAX_THREADS;
+	}
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return n < 1 ? 1 : n < MAX_THREADS ? (int)n : MAX_THREADS;
+}
+
+// Calls function(i, thread, arg) for each i in [0, count) on up to num_threads threads;
+// `thread` is in [0, num_threads), so callers can keep per-thread state without locking
+void parallel_for(int count, int num_threads, void (*function)(int, int, void *), void *arg) {
+	struct ParallelJob job = {.function = function, .arg = arg, .count = count};
+	atomic_init(&job.next_index, 0);
+	if (num_threads > count) {
+		num_threads = count;
+	}
+	if (num_threads <= 1) {
+		struct ParallelWorker worker = {&job, 0};
+		parallel_worker(&worker);
+		return;
+	}
+
+	pthread_t threads[MAX_THREADS];
+	struct ParallelWorker workers[MAX_THREADS];
+	for (int i = 1; i < num_threads; i++) {
+		workers[i] = (struct ParallelWorker){&job, i};
+		if (pthread_create(&threads[i], NULL, parallel_worker, &workers[i])) {
+			error_exit("Could not create thread %d\n", i);
+		}
+	}
+	workers[0] = (struct ParallelWorker){&job, 0};
+	parallel_worker(&workers[0]);
+	for (int i = 1; i < num_threads; i++) {
+		pthread_join(threads[i], NULL);
+	}
+}
+
+#endif // GUARD_PARALLEL_H
@@ -1,21 +1,33 @@
 #define PROGRAM_NAME "pokemon_animation"
-#define USAGE_OPTS "[-h|--help] [-b|--bitmasks] [-f|--frames] front.animated.tilemap front.dimensions"
+#define USAGE_OPTS "[-h|--help] [-b|--bitmasks] [-f|--frames] [-B|--binary] [-s|--stub frames.bin] [-d|--directory gfx/pokemon] [-m|--manifest species.txt] [-j|--jobs n] [front.animated.tilemap front.dimensions]"
 
 #include "common.h"
+#include "parallel.h"
+#include "pokemon_animation.h"
 
 struct Options {
 	bool use_bitmasks;
 	bool use_frames;
+	bool binary;
+	const char *stub_filename;
+	const char *directory;
+	const char *manifest;
+	int jobs;
 };
 
 void parse_args(int argc, char *argv[], struct Options *options) {
 	struct option long_options[] = {
 		{"bitmasks", no_argument, 0, 'b'},
 		{"frames", no_argument, 0, 'f'},
+		{"binary", no_argument, 0, 'B'},
+		{"stub", required_argument, 0, 's'},
+		{"directory", required_argument, 0, 'd'},
+		{"manifest", required_argument, 0, 'm'},
+		{"jobs", required_argument, 0, 'j'},
 		{"help", no_argument, 0, 'h'},
 		{0}
 	};
-	for (int opt; (opt = getopt_long(argc, argv, "bfh", long_options)) != -1;) {
+	for (int opt; (opt = getopt_long(argc, argv, "bfBs:d:m:j:h", long_options)) != -1;) {
 		switch (opt) {
 		case 'b':
 			options->use_bitmasks = true;
@@ -23,6 +35,21 @@ void parse_args(int argc, char *argv[], struct Options *options) {
 		case 'f':
 			options->use_frames = true;
 			break;
+		case 'B':
+			options->binary = true;
+			break;
+		case 's':
+			options->stub_filename = optarg;
+			break;
+		case 'd':
+			options->directory = optarg;
+			break;
+		case 'm':
+			options->manifest = optarg;
+			break;
+		case 'j':
+			options->jobs = (int)strtoul(optarg, NULL, 0);
+			break;
 		case 'h':
 			usage_exit(0);
 			break;
@@ -32,143 +59,34 @@ void parse_args(int argc, char *argv[], struct Options *options) {
 	}
 }
 
-struct Frame {
-	uint8_t *data;
-	int size;
-	int bitmask;
-};
-
-struct Frames {
-	struct Frame *frames;
-	int num_frames;
-	int num_tiles_per_frame;
-};
-
-struct Bitmask {
-	uint8_t *data;
-	int bitlength;
+struct Batch {
+	const struct Options *options;
+	const struct SpeciesList *species;
+	struct Arena *arenas; // one per thread, reset after each species
 };
 
-struct Bitmasks {
-	struct Bitmask *bitmasks;
-	int num_bitmasks;
-};
+// Writes the bitmask and frames outputs for one species directory
+void process_species(int index, int thread, void *arg) {
+	const struct Batch *batch = arg;
+	const char *dir = batch->species->dirs[index];
+	char *map_filename = species_path(dir, "front.animated.tilemap");
+	char *dimensions_filename = species_path(dir, "front.dimensions");
 
-int bitmask_exists(const struct Bitmask *bitmask, const struct Bitmasks *bitmasks) {
-	for (int i = 0; i < bitmasks->num_bitmasks; i++) {
-		struct Bitmask existing = bitmasks->bitmasks[i];
-		if (bitmask->bitlength != existing.bitlength) {
-			continue;
-		}
-		bool match = true;
-		int length = (bitmask->bitlength + 7) / 8;
-		for (int j = 0; j < length; j++) {
-			if (bitmask->data[j] != existing.data[j]) {
-				match = false;
-				break;
-			}
-		}
-		if (match) {
-			return i;
-		}
-	}
-	return -1;
-}
-
-void make_frames(const uint8_t *tilemap, long tilemap_size, int width, struct Frames *frames, struct Bitmasks *bitmasks) {
-	int num_tiles_per_frame = width * width;
-	int num_frames = tilemap_size / num_tiles_per_frame - 1;
-
-	frames->frames = xmalloc((sizeof *frames->frames) * num_frames);
-	frames->num_frames = num_frames;
-	frames->num_tiles_per_frame = num_tiles_per_frame;
-
-	bitmasks->bitmasks = xmalloc((sizeof *bitmasks->bitmasks) * num_frames);
-	bitmasks->num_bitmasks = 0;
-
-	const uint8_t *first_frame = &tilemap[0];
-	const uint8_t *this_frame = &tilemap[num_tiles_per_frame];
-	for (int i = 0; i < num_frames; i++) {
-		struct Frame *frame = xmalloc(sizeof *frame);
-		frame->data = xmalloc(num_tiles_per_frame);
-		frame->size = 0;
-
-		struct Bitmask *bitmask = xmalloc(sizeof *bitmask);
-		bitmask->data = xcalloc((num_tiles_per_frame + 7) / 8);
-		bitmask->bitlength = 0;
-
-		for (int j = 0; j < num_tiles_per_frame; j++) {
-			if (bitmask->bitlength % 8 == 0) {
-				bitmask->data[bitmask->bitlength / 8] = 0;
-			}
-			bitmask->data[bitmask->bitlength / 8] >>= 1;
-			if (this_frame[j] != first_frame[j]) {
-				frame->data[frame->size] = this_frame[j];
-				frame->size++;
-				bitmask->data[bitmask->bitlength / 8] |= (1 << 7);
-			}
-			bitmask->bitlength++;
-		}
-		// tile order ABCDEFGHIJKLMNOP... becomes db order %HGFEDCBA %PONMLKJI ...
-		int last = bitmask->bitlength - 1;
-		bitmask->data[last / 8] >>= (7 - (last % 8));
-
-		frame->bitmask = bitmask_exists(bitmask, bitmasks);
-		if (frame->bitmask == -1) {
-			frame->bitmask = bitmasks->num_bitmasks;
-			bitmasks->bitmasks[bitmasks->num_bitmasks] = *bitmask;
-			bitmasks->num_bitmasks++;
-		} else {
-			free(bitmask->data);
-			free(bitmask);
-		}
-		frames->frames[i] = *frame;
-		this_frame += num_tiles_per_frame;
-	}
-}
+	int width;
+	read_dimensions(dimensions_filename, &width);
+	long tilemap_size;
+	uint8_t *tilemap = read_u8(map_filename, &tilemap_size);
 
-void print_frames(struct Frames *frames) {
-	uint8_t limit = 0x7f - (7 * 7 - frames->num_tiles_per_frame);
-	for (int i = 0; i < frames->num_frames; i++) {
-		printf("\tdw .frame%d\n", i + 1);
-	}
-	for (int i = 0; i < frames->num_frames; i++) {
-		const struct Frame *frame = &frames->frames[i];
-		printf(".frame%d\n", i + 1);
-		printf("\tdb $%02x ; bitmask\n", frame->bitmask);
-		if (frame->size > 0) {
-			for (int j = 0; j < frame->size; j++) {
-				uint8_t offset = frame->data[j];
-				if (offset >= limit) {
-					offset++;
-				}
-				if (j % 12 == 0) {
-					if (j) {
-						putchar('\n');
-					}
-					printf("\tdb $%02x", offset);
-				} else {
-					printf(", $%02x", offset);
-				}
-			}
-			putchar('\n');
-		}
-	}
-}
+	struct Frames frames = {0};
+	struct Bitmasks bitmasks = {0};
+	struct Arena *arena = &batch->arenas[thread];
+	make_frames(tilemap, tilemap_size, width, &frames, &bitmasks, arena);
+	write_species_animation(dir, &frames, &bitmasks, batch->options->binary);
+	arena_reset(arena);
 
-void print_bitmasks(const struct Bitmasks *bitmasks) {
-	for (int i = 0; i < bitmasks->num_bitmasks; i++) {
-		struct Bitmask bitmask = bitmasks->bitmasks[i];
-		printf("; %d\n", i);
-		int length = (bitmask.bitlength + 7) / 8;
-		for (int j = 0; j < length; j++) {
-			printf("\tdb %%");
-			for (int k = 0; k < 8; k++) {
-				putchar(((bitmask.data[j] >> (7 - k)) & 1) ? '1' : '0');
-			}
-			putchar('\n');
-		}
-	}
+	free(tilemap);
+	free(map_filename);
+	free(dimensions_filename);
 }
 
 int main(int argc, char *argv[]) {
@@ -177,6 +95,29 @@ int main(int argc, char *argv[]) {
 
 	argc -= optind;
 	argv += optind;
+
+	if (options.directory || options.manifest) {
+		if (argc) {
+			usage_exit(1);
+		}
+		struct SpeciesList species = {0};
+		if (options.directory) {
+			list_species_dirs(&species, options.directory, "front.animated.tilemap");
+		}
+		if (options.manifest) {
+			read_species_manifest(&species, options.manifest);
+		}
+		int num_threads = parallel_num_threads(options.jobs);
+		struct Batch batch = {&options, &species, xcalloc(num_threads * sizeof(struct Arena))};
+		parallel_for(species.num_dirs, num_threads, process_species, &batch);
+		for (int i = 0; i < num_threads; i++) {
+			arena_free(&batch.arenas[i]);
+		}
+		free(batch.arenas);
+		free_species_list(&species);
+		return 0;
+	}
+
 	if (argc < 2) {
 		usage_exit(1);
 	}
@@ -188,15 +129,28 @@ int main(int argc, char *argv[]) {
 
 	struct Frames frames = {0};
 	struct Bitmasks bitmasks = {0};
-	make_frames(tilemap, tilemap_size, width, &frames, &bitmasks);
+	struct Arena arena = {0};
+	make_frames(tilemap, tilemap_size, width, &frames, &bitmasks, &arena);
 
 	if (options.use_frames) {
-		print_frames(&frames);
+		if (options.binary) {
+			write_frames_bin(stdout, &frames);
+		} else {
+			print_frames(stdout, &frames);
+		}
 	}
 	if (options.use_bitmasks) {
-		print_bitmasks(&bitmasks);
+		if (options.binary) {
+			write_bitmasks_bin(stdout, &bitmasks);
+		} else {
+			print_bitmasks(stdout, &bitmasks);
+		}
+	}
+	if (options.stub_filename) {
+		print_frames_stub(stdout, &frames, options.stub_filename);
 	}
 
+	arena_free(&arena);
 	free(tilemap);
 	return 0;
 }
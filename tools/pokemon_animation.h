@@ -0,0 +1,473 @@
+#ifndef GUARD_POKEMON_ANIMATION_H
+#define GUARD_POKEMON_ANIMATION_H
+
+// Include common.h before this header
+
+#include <dirent.h>
+
+#include "arena.h"
+
+#define TILE_SIZE 16
+
+void transpose_tiles(uint8_t *tiles, int width, int size) {
+	uint8_t *new_tiles = xmalloc(size);
+	for (int i = 0; i < size; i++) {
+		int j = i / TILE_SIZE * width * TILE_SIZE;
+		j = (j / size) * TILE_SIZE + j % size + i % TILE_SIZE;
+		new_tiles[j] = tiles[i];
+	}
+	memcpy(tiles, new_tiles, size);
+	free(new_tiles);
+}
+
+// Reorders each width x width frame of row-major tiles (as rgbgfx outputs them) into column-major order
+void transpose_frames(uint8_t *tiles, long tiles_size, int width, const char *filename) {
+	int frame_size = width * width * TILE_SIZE;
+	if (!tiles_size) {
+		error_exit("%s: empty file\n", filename);
+	} else if (tiles_size % TILE_SIZE) {
+		error_exit("%s: not divisible into 8x8-px 2bpp tiles\n", filename);
+	} else if (tiles_size % frame_size) {
+		error_exit("%s: not divisible into %dx%d-tile frames\n", filename, width, width);
+	}
+
+	int num_frames = tiles_size / frame_size;
+	for (int i = 0; i < num_frames; i++) {
+		transpose_tiles(&tiles[i * frame_size], width, frame_size);
+	}
+}
+
+// Maps tile contents to the first index of each distinct tile, so lookups do not scan every earlier tile
+struct TileTable {
+	const uint8_t *tiles;
+	int *slots; // tile indexes, or -1 for empty
+	int capacity; // a power of two, at least twice the number of tiles
+};
+
+uint32_t hash_bytes(const uint8_t *data, int size) {
+	uint32_t hash = 2166136261u; // FNV-1a
+	for (int i = 0; i < size; i++) {
+		hash = (hash ^ data[i]) * 16777619u;
+	}
+	return hash;
+}
+
+void init_tile_table(struct TileTable *table, const uint8_t *tiles, int max_num_tiles) {
+	table->tiles = tiles;
+	table->capacity = 16;
+	while (table->capacity < max_num_tiles * 2) {
+		table->capacity *= 2;
+	}
+	table->slots = xmalloc(table->capacity * sizeof(*table->slots));
+	memset(table->slots, 0xff, table->capacity * sizeof(*table->slots));
+}
+
+// Returns the slot holding a tile equal to `tile`, or the empty slot where it would go
+int *find_tile_slot(const struct TileTable *table, const uint8_t *tile) {
+	int mask = table->capacity - 1;
+	for (int i = hash_bytes(tile, TILE_SIZE) & mask;; i = (i + 1) & mask) {
+		int *slot = &table->slots[i];
+		if (*slot == -1 || !memcmp(tile, &table->tiles[*slot * TILE_SIZE], TILE_SIZE)) {
+			return slot;
+		}
+	}
+}
+
+// Adds tile `index` of the table's tiles, unless an earlier tile has the same contents
+void add_tile(struct TileTable *table, int index) {
+	int *slot = find_tile_slot(table, &table->tiles[index * TILE_SIZE]);
+	if (*slot == -1) {
+		*slot = index;
+	}
+}
+
+// The table must hold exactly the first `num_tiles` of its tiles
+int get_tile_index(const uint8_t *tile, const struct TileTable *table, int num_tiles, int preferred_tile_id) {
+	if (preferred_tile_id >= 0 && preferred_tile_id < num_tiles) {
+		if (!memcmp(tile, &table->tiles[preferred_tile_id * TILE_SIZE], TILE_SIZE)) {
+			return preferred_tile_id;
+		}
+	}
+	return *find_tile_slot(table, tile);
+}
+
+// Returns the first frame followed by each new tile of the animated frames (front.animated.2bpp)
+uint8_t *make_animated_graphics(const uint8_t *tiles, long tiles_size, int num_tiles_per_frame, bool girafarig, long *data_size) {
+	int max_size = tiles_size;
+	int max_num_tiles = max_size / TILE_SIZE;
+	if (girafarig) {
+		// Ensure space for a duplicate of tile 0 at the end
+		max_size += TILE_SIZE;
+	}
+	uint8_t *data = xmalloc(max_size);
+
+	struct TileTable table;
+	init_tile_table(&table, data, max_num_tiles);
+
+	int num_tiles = 0;
+#define DATA_APPEND_TILES(tile, length) do { \
+	memcpy(&data[num_tiles * TILE_SIZE], &tiles[(tile) * TILE_SIZE], (length) * TILE_SIZE); \
+	for (int k = 0; k < (length); k++) { \
+		add_tile(&table, num_tiles++); \
+	} \
+} while (0)
+	// Copy the first frame directly
+	DATA_APPEND_TILES(0, num_tiles_per_frame);
+	// Skip redundant tiles in the animated frames
+	for (int i = num_tiles_per_frame; i < max_num_tiles; i++) {
+		int index = get_tile_index(&tiles[i * TILE_SIZE], &table, num_tiles, i % num_tiles_per_frame);
+		if (index == -1) {
+			DATA_APPEND_TILES(i, 1);
+		}
+	}
+	if (girafarig) {
+		// Add a duplicate of tile 0 to the end
+		DATA_APPEND_TILES(0, 1);
+	}
+#undef DATA_APPEND_TILES
+
+	free(table.slots);
+	*data_size = num_tiles * TILE_SIZE;
+	return data;
+}
+
+// Returns the front.animated.2bpp tile ID of every tile in every frame (front.animated.tilemap)
+uint8_t *make_animated_tilemap(const uint8_t *tiles, long tiles_size, int num_tiles_per_frame, bool girafarig, long *data_size) {
+	int size = tiles_size / TILE_SIZE;
+	uint8_t *data = xmalloc(size);
+
+	struct TileTable table;
+	init_tile_table(&table, tiles, size);
+
+	int num_tiles = num_tiles_per_frame;
+	// Copy the first frame directly
+	for (int i = 0; i < num_tiles_per_frame; i++) {
+		data[i] = i;
+		add_tile(&table, i);
+	}
+	// Skip redundant tiles in the animated frames
+	for (int i = num_tiles_per_frame; i < size; i++) {
+		int index = get_tile_index(&tiles[i * TILE_SIZE], &table, i, i % num_tiles_per_frame);
+		int tile;
+		if (girafarig && index == 0) {
+			tile = num_tiles;
+		} else if (index == -1) {
+			tile = num_tiles++;
+		} else {
+			tile = data[index];
+		}
+		data[i] = tile;
+		add_tile(&table, i);
+	}
+
+	free(table.slots);
+	*data_size = size;
+	return data;
+}
+
+struct Frame {
+	uint8_t *data;
+	int size;
+	int bitmask;
+};
+
+struct Frames {
+	struct Frame *frames;
+	int num_frames;
+	int num_tiles_per_frame;
+};
+
+struct Bitmask {
+	uint8_t *data;
+	int bitlength;
+};
+
+struct Bitmasks {
+	struct Bitmask *bitmasks;
+	int num_bitmasks;
+};
+
+// Builds the frames and their distinct bitmasks out of one arena: frame tiles and bitmask bits
+// are packed back to back in two flat buffers, and the Frame/Bitmask arrays point into them
+void make_frames(const uint8_t *tilemap, long tilemap_size, int width, struct Frames *frames, struct Bitmasks *bitmasks, struct Arena *arena) {
+	int num_tiles_per_frame = width * width;
+	int num_frames = tilemap_size / num_tiles_per_frame - 1;
+	int bitmask_length = (num_tiles_per_frame + 7) / 8;
+
+	frames->frames = arena_alloc(arena, (sizeof *frames->frames) * num_frames);
+	frames->num_frames = num_frames;
+	frames->num_tiles_per_frame = num_tiles_per_frame;
+	uint8_t *frame_data = arena_alloc(arena, num_frames * num_tiles_per_frame);
+
+	bitmasks->bitmasks = arena_alloc(arena, (sizeof *bitmasks->bitmasks) * num_frames);
+	bitmasks->num_bitmasks = 0;
+	uint8_t *bitmask_data = arena_calloc(arena, num_frames * bitmask_length);
+
+	// Open-addressed indexes into bitmasks, or -1 for empty
+	int capacity = 16;
+	while (capacity < num_frames * 2) {
+		capacity *= 2;
+	}
+	int *slots = arena_alloc(arena, capacity * sizeof(*slots));
+	memset(slots, 0xff, capacity * sizeof(*slots));
+
+	const uint8_t *first_frame = &tilemap[0];
+	const uint8_t *this_frame = &tilemap[num_tiles_per_frame];
+	for (int i = 0; i < num_frames; i++) {
+		struct Frame *frame = &frames->frames[i];
+		frame->data = &frame_data[i * num_tiles_per_frame];
+		frame->size = 0;
+
+		// Build each bitmask in the next unused spot, which it keeps only if it is new
+		uint8_t *data = &bitmask_data[bitmasks->num_bitmasks * bitmask_length];
+		int bitlength = 0;
+		for (int j = 0; j < num_tiles_per_frame; j++) {
+			if (bitlength % 8 == 0) {
+				data[bitlength / 8] = 0;
+			}
+			data[bitlength / 8] >>= 1;
+			if (this_frame[j] != first_frame[j]) {
+				frame->data[frame->size] = this_frame[j];
+				frame->size++;
+				data[bitlength / 8] |= (1 << 7);
+			}
+			bitlength++;
+		}
+		// tile order ABCDEFGHIJKLMNOP... becomes db order %HGFEDCBA %PONMLKJI ...
+		int last = bitlength - 1;
+		data[last / 8] >>= (7 - (last % 8));
+
+		int mask = capacity - 1;
+		int *slot;
+		for (int j = hash_bytes(data, bitmask_length) & mask;; j = (j + 1) & mask) {
+			slot = &slots[j];
+			if (*slot == -1 || !memcmp(data, bitmasks->bitmasks[*slot].data, bitmask_length)) {
+				break;
+			}
+		}
+		if (*slot == -1) {
+			*slot = bitmasks->num_bitmasks;
+			bitmasks->bitmasks[*slot] = (struct Bitmask){data, bitlength};
+			bitmasks->num_bitmasks++;
+		}
+		frame->bitmask = *slot;
+		this_frame += num_tiles_per_frame;
+	}
+}
+
+// Frame tile IDs at or past this one are shifted up by one
+uint8_t frame_tile_offset(const struct Frames *frames, uint8_t tile) {
+	uint8_t limit = 0x7f - (7 * 7 - frames->num_tiles_per_frame);
+	return tile >= limit ? tile + 1 : tile;
+}
+
+void print_frames(FILE *f, const struct Frames *frames) {
+	for (int i = 0; i < frames->num_frames; i++) {
+		fprintf(f, "\tdw .frame%d\n", i + 1);
+	}
+	for (int i = 0; i < frames->num_frames; i++) {
+		const struct Frame *frame = &frames->frames[i];
+		fprintf(f, ".frame%d\n", i + 1);
+		fprintf(f, "\tdb $%02x ; bitmask\n", frame->bitmask);
+		if (frame->size > 0) {
+			for (int j = 0; j < frame->size; j++) {
+				uint8_t offset = frame_tile_offset(frames, frame->data[j]);
+				if (j % 12 == 0) {
+					if (j) {
+						putc('\n', f);
+					}
+					fprintf(f, "\tdb $%02x", offset);
+				} else {
+					fprintf(f, ", $%02x", offset);
+				}
+			}
+			putc('\n', f);
+		}
+	}
+}
+
+// The bytes that print_frames has after its "dw" table: each frame's bitmask, then its tiles
+void write_frames_bin(FILE *f, const struct Frames *frames) {
+	for (int i = 0; i < frames->num_frames; i++) {
+		const struct Frame *frame = &frames->frames[i];
+		putc(frame->bitmask, f);
+		for (int j = 0; j < frame->size; j++) {
+			putc(frame_tile_offset(frames, frame->data[j]), f);
+		}
+	}
+}
+
+// The "dw" table of print_frames, pointing into `bin_filename` from write_frames_bin at fixed offsets
+void print_frames_stub(FILE *f, const struct Frames *frames, const char *bin_filename) {
+	int offset = 0;
+	for (int i = 0; i < frames->num_frames; i++) {
+		fprintf(f, "\tdw .frames + %d\n", offset);
+		offset += 1 + frames->frames[i].size;
+	}
+	if (offset) {
+		fprintf(f, ".frames\n\tINCBIN \"%s\"\n", bin_filename);
+	}
+}
+
+void print_bitmasks(FILE *f, const struct Bitmasks *bitmasks) {
+	for (int i = 0; i < bitmasks->num_bitmasks; i++) {
+		struct Bitmask bitmask = bitmasks->bitmasks[i];
+		fprintf(f, "; %d\n", i);
+		int length = (bitmask.bitlength + 7) / 8;
+		for (int j = 0; j < length; j++) {
+			fputs("\tdb %", f);
+			for (int k = 0; k < 8; k++) {
+				putc(((bitmask.data[j] >> (7 - k)) & 1) ? '1' : '0', f);
+			}
+			putc('\n', f);
+		}
+	}
+}
+
+// The bytes that print_bitmasks has as "db" lines
+void write_bitmasks_bin(FILE *f, const struct Bitmasks *bitmasks) {
+	for (int i = 0; i < bitmasks->num_bitmasks; i++) {
+		const struct Bitmask *bitmask = &bitmasks->bitmasks[i];
+		int length = (bitmask->bitlength + 7) / 8;
+		for (int j = 0; j < length; j++) {
+			putc(bitmask->data[j], f);
+		}
+	}
+}
+
+// Batch mode: one run handles every species directory, e.g. all of gfx/pokemon/*/
+
+struct SpeciesList {
+	char **dirs;
+	int num_dirs;
+};
+
+char *species_path(const char *dir, const char *name) {
+	char *path = xmalloc(strlen(dir) + strlen(name) + 2);
+	sprintf(path, "%s/%s", dir, name);
+	return path;
+}
+
+bool species_file_exists(const char *dir, const char *name) {
+	char *path = species_path(dir, name);
+	FILE *f = fopen(path, "rb");
+	free(path);
+	if (f) {
+		fclose(f);
+	}
+	return f != NULL;
+}
+
+void add_species_dir(struct SpeciesList *list, const char *dir, size_t len) {
+	while (len > 1 && dir[len - 1] == '/') {
+		len--;
+	}
+	list->dirs = xrealloc(list->dirs, (list->num_dirs + 1) * sizeof(*list->dirs));
+	char *copy = xmalloc(len + 1);
+	memcpy(copy, dir, len);
+	copy[len] = '\0';
+	list->dirs[list->num_dirs++] = copy;
+}
+
+int compare_species_dirs(const void *a, const void *b) {
+	return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+// Adds each subdirectory of `directory` that contains `input_name`, in sorted order
+void list_species_dirs(struct SpeciesList *list, const char *directory, const char *input_name) {
+	errno = 0;
+	DIR *dir = opendir(directory);
+	if (!dir) {
+		error_exit("Could not open directory \"%s\": %s\n", directory, strerror(errno));
+	}
+	int first = list->num_dirs;
+	for (struct dirent *entry; (entry = readdir(dir));) {
+		if (entry->d_name[0] == '.') {
+			continue;
+		}
+		char *path = species_path(directory, entry->d_name);
+		if (species_file_exists(path, input_name)) {
+			add_species_dir(list, path, strlen(path));
+		}
+		free(path);
+	}
+	closedir(dir);
+	qsort(&list->dirs[first], list->num_dirs - first, sizeof(*list->dirs), compare_species_dirs);
+}
+
+// Adds each species directory listed in `manifest`, one per line
+void read_species_manifest(struct SpeciesList *list, const char *manifest) {
+	long size;
+	uint8_t *text = read_u8(manifest, &size);
+	for (long i = 0; i < size;) {
+		long len = 0;
+		while (i + len < size && text[i + len] != '\n' && text[i + len] != '\r') {
+			len++;
+		}
+		if (len) {
+			add_species_dir(list, (const char *)&text[i], len);
+		}
+		i += len + 1;
+	}
+	free(text);
+}
+
+void free_species_list(struct SpeciesList *list) {
+	for (int i = 0; i < list->num_dirs; i++) {
+		free(list->dirs[i]);
+	}
+	free(list->dirs);
+}
+
+FILE *xtmpfile(void) {
+	errno = 0;
+	FILE *f = tmpfile();
+	if (!f) {
+		error_exit("Could not create a temporary file: %s\n", strerror(errno));
+	}
+	return f;
+}
+
+// Writes out everything printed to a tmpfile() if it differs from `filename`, and closes it
+void write_tmpfile_if_changed(const char *filename, FILE *f) {
+	long size = xfsize(filename, f);
+	uint8_t *data = xmalloc(size ? size : 1);
+	xfread(data, size, filename, f);
+	fclose(f);
+	write_if_changed(filename, data, size);
+	free(data);
+}
+
+// Writes a species directory's bitmask.asm and frames.asm, or with `binary`, its bitmask.bin and frames.bin
+// with a frames.asm stub that INCBINs frames.bin
+void write_species_animation(const char *dir, const struct Frames *frames, const struct Bitmasks *bitmasks, bool binary) {
+	char *bitmask_filename = species_path(dir, binary ? "bitmask.bin" : "bitmask.asm");
+	char *frames_filename = species_path(dir, "frames.asm");
+	char *frames_bin_filename = species_path(dir, "frames.bin");
+
+	FILE *f = xtmpfile();
+	if (binary) {
+		write_bitmasks_bin(f, bitmasks);
+	} else {
+		print_bitmasks(f, bitmasks);
+	}
+	write_tmpfile_if_changed(bitmask_filename, f);
+	if (binary) {
+		f = xtmpfile();
+		write_frames_bin(f, frames);
+		write_tmpfile_if_changed(frames_bin_filename, f);
+	}
+	f = xtmpfile();
+	if (binary) {
+		print_frames_stub(f, frames, frames_bin_filename);
+	} else {
+		print_frames(f, frames);
+	}
+	write_tmpfile_if_changed(frames_filename, f);
+
+	free(bitmask_filename);
+	free(frames_filename);
+	free(frames_bin_filename);
+}
+
+#endif // GUARD_POKEMON_ANIMATION_H
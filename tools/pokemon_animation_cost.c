@@ -0,0 +1,393 @@
+#define PROGRAM_NAME "pokemon_animation_cost"
+#define USAGE_OPTS "[-h|--help] [-b|--budget bytes] [-t|--top n] [-v|--verbose]"
+
+#include "common.h"
+#include "mapdata.h"
+#include "tilepng.h"
+#include "pokemon_animation.h"
+
+// Simulates the pic animation scripts the way engine/gfx/pic_animation.asm plays them, and reports how many
+// tilemap entries each frame transition changes. PokeAnim_GetFrame redraws the base pic and then applies the
+// frame's bitmask in WRAM; every animation tick then copies the whole tilemap to VRAM, so a transition costs
+// one byte of VRAM per changed entry at the least, and HDMA_TILEMAP_BYTES as the engine does it.
+
+#define ANIM_POINTERS_FILE "gfx/pokemon/anim_pointers.asm"
+#define EXTRA_POINTERS_FILE "gfx/pokemon/extra_pointers.asm"
+#define FRAME_POINTERS_FILE "gfx/pokemon/frame_pointers.asm"
+#define ANIMS_FILE "gfx/pokemon/anims.asm"
+#define EXTRAS_FILE "gfx/pokemon/extras.asm"
+#define KANTO_FRAMES_FILE "gfx/pokemon/kanto_frames.asm"
+#define JOHTO_FRAMES_FILE "gfx/pokemon/johto_frames.asm"
+
+#define HDMA_TILEMAP_BYTES ((0x23 + 1) * 16) // HDMATransferTileMapToWRAMBank3 copies $23 + 1 blocks
+#define DEFAULT_BUDGET 32 // bytes per VBlank: two 16-byte HDMA blocks
+#define DEFAULT_TOP 20
+#define MAX_ANIM_STEPS 10000 // guards against scripts that never reach endanim
+
+struct Options {
+	int budget;
+	int top;
+	bool verbose;
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"budget", required_argument, 0, 'b'},
+		{"top", required_argument, 0, 't'},
+		{"verbose", no_argument, 0, 'v'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "b:t:vh", long_options)) != -1;) {
+		switch (opt) {
+		case 'b':
+			options->budget = (int)strtoul(optarg, NULL, 0);
+			break;
+		case 't':
+			options->top = (int)strtoul(optarg, NULL, 0);
+			break;
+		case 'v':
+			options->verbose = true;
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+struct Label {
+	char *name;
+	char *filename;
+};
+
+struct Labels {
+	struct Label *labels;
+	int num_labels;
+};
+
+// Reads "Label: INCLUDE "file"" lines, where any labels on lines of their own also mark the next INCLUDE
+void read_included_labels(struct Labels *labels, const char *filename) {
+	char *text = read_text(filename);
+	char *cursor = text;
+	int first_pending = labels->num_labels;
+	for (char *line; (line = next_line(&cursor));) {
+		char *colon = strchr(line, ':');
+		if (colon && colon > line && !strchr(" \t", *line)) {
+			labels->labels = xrealloc(labels->labels, (labels->num_labels + 1) * sizeof(*labels->labels));
+			labels->labels[labels->num_labels++] = (struct Label){.name = xstrndup(line, colon - line)};
+		}
+		char *include = strstr(line, "INCLUDE \"");
+		if (include) {
+			include += strlen("INCLUDE \"");
+			char *end = strchr(include, '"');
+			if (!end) {
+				error_exit("%s: invalid INCLUDE: %s\n", filename, line);
+			}
+			for (int i = first_pending; i < labels->num_labels; i++) {
+				labels->labels[i].filename = xstrndup(include, end - include);
+			}
+			first_pending = labels->num_labels;
+		}
+	}
+	free(text);
+}
+
+const char *find_label_file(const struct Labels *labels, const char *name) {
+	for (int i = 0; i < labels->num_labels; i++) {
+		if (!strcmp(labels->labels[i].name, name) && labels->labels[i].filename) {
+			return labels->labels[i].filename;
+		}
+	}
+	return NULL;
+}
+
+// Returns the files that the "dw" entries of a pointer table point to
+const char **read_pointer_table(const struct Labels *labels, const char *filename, int *count) {
+	char *text = read_text(filename);
+	char *cursor = text;
+	const char **files = NULL;
+	*count = 0;
+	for (char *line; (line = next_line(&cursor));) {
+		char *args = macro_args(line, "dw");
+		if (!args) {
+			continue;
+		}
+		const char *file = find_label_file(labels, args);
+		if (!file) {
+			error_exit("%s: no INCLUDE for %s\n", filename, args);
+		}
+		files = xrealloc(files, (*count + 1) * sizeof(*files));
+		files[(*count)++] = file;
+	}
+	free(text);
+	return files;
+}
+
+enum AnimCommandType { ANIM_FRAME, ANIM_SETREPEAT, ANIM_DOREPEAT, ANIM_END };
+
+struct AnimCommand {
+	enum AnimCommandType type;
+	int index;
+	int param;
+};
+
+struct AnimCommand *read_anim_script(const char *filename, int *num_commands) {
+	char *text = read_text(filename);
+	char *cursor = text;
+	struct AnimCommand *commands = NULL;
+	*num_commands = 0;
+	int lineno = 0;
+	for (char *line; (line = next_line(&cursor));) {
+		lineno++;
+		struct AnimCommand command = {0};
+		char *args;
+		if ((args = macro_args(line, "frame"))) {
+			char *argv[3];
+			if (split_args(args, argv, COUNTOF(argv)) != 2) {
+				error_exit("%s:%d: unsupported frame command: %s\n", filename, lineno, line);
+			}
+			command = (struct AnimCommand){ANIM_FRAME, parse_asm_number(argv[0]), 0};
+		} else if ((args = macro_args(line, "setrepeat"))) {
+			command = (struct AnimCommand){ANIM_SETREPEAT, 0, parse_asm_number(args)};
+		} else if ((args = macro_args(line, "dorepeat"))) {
+			command = (struct AnimCommand){ANIM_DOREPEAT, 0, parse_asm_number(args)};
+		} else if (!strcmp(line + strspn(line, " \t"), "endanim")) {
+			command.type = ANIM_END;
+		} else if (line[strspn(line, " \t")]) {
+			error_exit("%s:%d: unsupported line: %s\n", filename, lineno, line);
+		} else {
+			continue;
+		}
+		commands = xrealloc(commands, (*num_commands + 1) * sizeof(*commands));
+		commands[(*num_commands)++] = command;
+	}
+	free(text);
+	return commands;
+}
+
+struct Transition {
+	const char *species;
+	const char *script;
+	int from, to;
+	int changed;
+	int count; // times the script plays it
+};
+
+struct Report {
+	struct Transition *transitions;
+	int num_transitions;
+	int num_scripts;
+};
+
+// Fills `tilemap` with what PokeAnim_GetFrame leaves on screen for frame `index` (0 is the base pic)
+void draw_frame(const struct Frames *frames, const struct Bitmasks *bitmasks, int index, uint8_t *tilemap,
+	const char *filename) {
+	for (int i = 0; i < frames->num_tiles_per_frame; i++) {
+		tilemap[i] = i;
+	}
+	if (!index) {
+		return;
+	}
+	if (index > frames->num_frames) {
+		error_exit("%s: frame %d does not exist\n", filename, index);
+	}
+	const struct Frame *frame = &frames->frames[index - 1];
+	const struct Bitmask *bitmask = &bitmasks->bitmasks[frame->bitmask];
+	for (int i = 0, j = 0; i < bitmask->bitlength; i++) {
+		if ((bitmask->data[i / 8] >> (i % 8)) & 1) {
+			tilemap[i] = frame->data[j++];
+		}
+	}
+}
+
+// Steps through a script like PokeAnim_DoAnimScript, recording each frame change
+void simulate_script(struct Report *report, const char *species, const char *filename,
+	const struct Frames *frames, const struct Bitmasks *bitmasks) {
+	int num_commands;
+	struct AnimCommand *commands = read_anim_script(filename, &num_commands);
+	uint8_t shown[7 * 7], next[7 * 7];
+	int shown_index = 0;
+	int first = report->num_transitions;
+	draw_frame(frames, bitmasks, 0, shown, filename);
+
+	int repeat = 0;
+	for (int pc = 0, steps = 0; pc < num_commands; steps++) {
+		if (steps > MAX_ANIM_STEPS) {
+			error_exit("%s: never reaches endanim\n", filename);
+		}
+		const struct AnimCommand *command = &commands[pc++];
+		if (command->type == ANIM_END) {
+			break;
+		} else if (command->type == ANIM_SETREPEAT) {
+			repeat = command->param;
+		} else if (command->type == ANIM_DOREPEAT) {
+			if (repeat && --repeat) {
+				pc = command->param;
+			}
+		} else {
+			draw_frame(frames, bitmasks, command->index, next, filename);
+			int changed = 0;
+			for (int i = 0; i < frames->num_tiles_per_frame; i++) {
+				changed += next[i] != shown[i];
+			}
+			struct Transition *transition = NULL;
+			for (int i = first; i < report->num_transitions && !transition; i++) {
+				if (report->transitions[i].from == shown_index && report->transitions[i].to == command->index) {
+					transition = &report->transitions[i];
+				}
+			}
+			if (!transition) {
+				report->transitions = xrealloc(report->transitions, (report->num_transitions + 1) * sizeof(*report->transitions));
+				transition = &report->transitions[report->num_transitions++];
+				*transition = (struct Transition){species, filename, shown_index, command->index, changed, 0};
+			}
+			transition->count++;
+			memcpy(shown, next, sizeof(shown));
+			shown_index = command->index;
+		}
+	}
+	report->num_scripts++;
+	free(commands);
+}
+
+void load_frames(const char *dir, struct Frames *frames, struct Bitmasks *bitmasks, struct Arena *arena) {
+	char *filename = species_path(dir, "front.png");
+	uint32_t width_px = read_png_width(filename);
+	if (width_px != 40 && width_px != 48 && width_px != 56) {
+		error_exit("Not a valid width for \"%s\": %" PRIu32 " px\n", filename, width_px);
+	}
+	int width = width_px / 8;
+
+	int num_tiles;
+	uint8_t *tiles = read_png_tiles(filename, &num_tiles);
+	long tiles_size = num_tiles * TILE_SIZE;
+	transpose_frames(tiles, tiles_size, width, filename);
+	long tilemap_size;
+	uint8_t *tilemap = make_animated_tilemap(tiles, tiles_size, width * width, false, &tilemap_size);
+	make_frames(tilemap, tilemap_size, width, frames, bitmasks, arena);
+
+	free(tilemap);
+	free(tiles);
+	free(filename);
+}
+
+struct SpeciesCost {
+	const char *species;
+	int worst;
+	int num_over; // transitions played that go over budget
+};
+
+int compare_transitions(const void *a, const void *b) {
+	const struct Transition *x = a, *y = b;
+	return x->changed != y->changed ? y->changed - x->changed : y->count - x->count;
+}
+
+int compare_species_costs(const void *a, const void *b) {
+	const struct SpeciesCost *x = a, *y = b;
+	return x->worst != y->worst ? y->worst - x->worst : y->num_over - x->num_over;
+}
+
+int main(int argc, char *argv[]) {
+	struct Options options = {.budget = DEFAULT_BUDGET, .top = DEFAULT_TOP};
+	parse_args(argc, argv, &options);
+
+	argc -= optind;
+	argv += optind;
+	if (argc) {
+		usage_exit(1);
+	}
+
+	struct Labels labels = {0};
+	read_included_labels(&labels, ANIMS_FILE);
+	read_included_labels(&labels, EXTRAS_FILE);
+	read_included_labels(&labels, KANTO_FRAMES_FILE);
+	read_included_labels(&labels, JOHTO_FRAMES_FILE);
+	int num_anims, num_extras, num_frames;
+	const char **anim_files = read_pointer_table(&labels, ANIM_POINTERS_FILE, &num_anims);
+	const char **extra_files = read_pointer_table(&labels, EXTRA_POINTERS_FILE, &num_extras);
+	const char **frames_files = read_pointer_table(&labels, FRAME_POINTERS_FILE, &num_frames);
+	if (num_anims != num_frames || num_extras != num_frames) {
+		error_exit("Pointer tables differ in length: %d animations, %d extras, %d frames\n", num_anims, num_extras, num_frames);
+	}
+
+	struct Report report = {0};
+	struct Arena arena = {0};
+	char **dirs = xmalloc(num_frames * sizeof(*dirs));
+	for (int i = 0; i < num_frames; i++) {
+		const char *end = strrchr(frames_files[i], '/');
+		dirs[i] = xstrndup(frames_files[i], end ? end - frames_files[i] : 0);
+		struct Frames frames = {0};
+		struct Bitmasks bitmasks = {0};
+		load_frames(dirs[i], &frames, &bitmasks, &arena);
+		simulate_script(&report, dirs[i], anim_files[i], &frames, &bitmasks);
+		simulate_script(&report, dirs[i], extra_files[i], &frames, &bitmasks);
+		arena_reset(&arena);
+	}
+
+	struct SpeciesCost *costs = xcalloc(num_frames * sizeof(*costs));
+	int num_costs = 0, num_played = 0, num_over = 0, max_changed = 0;
+	long total_changed = 0;
+	for (int i = 0; i < report.num_transitions; i++) {
+		const struct Transition *transition = &report.transitions[i];
+		num_played += transition->count;
+		total_changed += (long)transition->changed * transition->count;
+		if (transition->changed > max_changed) {
+			max_changed = transition->changed;
+		}
+		if (options.verbose) {
+			printf("%s: frame %d -> %d: %d tiles, played %d times\n",
+				transition->script, transition->from, transition->to, transition->changed, transition->count);
+		}
+		if (transition->changed <= options.budget) {
+			continue;
+		}
+		num_over += transition->count;
+		if (!num_costs || costs[num_costs - 1].species != transition->species) {
+			costs[num_costs++].species = transition->species;
+		}
+		struct SpeciesCost *cost = &costs[num_costs - 1];
+		cost->num_over += transition->count;
+		if (transition->changed > cost->worst) {
+			cost->worst = transition->changed;
+		}
+	}
+	if (options.verbose) {
+		putchar('\n');
+	}
+
+	printf("%d scripts for %d entries play %d frame transitions (%d distinct)\n",
+		report.num_scripts, num_frames, num_played, report.num_transitions);
+	printf("changed tilemap entries per transition: %.1f average, %d at most\n",
+		num_played ? (double)total_changed / num_played : 0.0, max_changed);
+	printf("the engine copies %d bytes of tilemap per tick, whatever changed\n", HDMA_TILEMAP_BYTES);
+	printf("%d transitions played by %d entries change more than %d bytes per VBlank\n\n", num_over, num_costs, options.budget);
+
+	qsort(costs, num_costs, sizeof(*costs), compare_species_costs);
+	printf("entries, worst first:\n");
+	for (int i = 0; i < num_costs && i < options.top; i++) {
+		printf("\t%s: %d bytes at worst, %d transitions over budget\n", costs[i].species, costs[i].worst, costs[i].num_over);
+	}
+
+	qsort(report.transitions, report.num_transitions, sizeof(*report.transitions), compare_transitions);
+	printf("\ntransitions, worst first:\n");
+	for (int i = 0; i < report.num_transitions && i < options.top && report.transitions[i].changed > options.budget; i++) {
+		const struct Transition *transition = &report.transitions[i];
+		printf("\t%s: frame %d -> %d, %d bytes, played %d times\n",
+			transition->script, transition->from, transition->to, transition->changed, transition->count);
+	}
+
+	for (int i = 0; i < num_frames; i++) {
+		free(dirs[i]);
+	}
+	arena_free(&arena);
+	free(dirs);
+	free(costs);
+	free(report.transitions);
+	free(anim_files);
+	free(extra_files);
+	free(frames_files);
+	return 0;
+}
@@ -0,0 +1,135 @@
+#define PROGRAM_NAME "pokemon_front"
+#define USAGE_OPTS "[-h|--help] [-d|--directory gfx/pokemon] [-m|--manifest species.txt] [-j|--jobs n] [--girafarig] [front.png...]"
+
+#include "common.h"
+#include "parallel.h"
+#include "tilepng.h"
+#include "pokemon_animation.h"
+
+struct Options {
+	const char *directory;
+	const char *manifest;
+	int jobs;
+	bool girafarig;
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"directory", required_argument, 0, 'd'},
+		{"manifest", required_argument, 0, 'm'},
+		{"jobs", required_argument, 0, 'j'},
+		{"girafarig", no_argument, 0, 'g'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "d:m:j:h", long_options)) != -1;) {
+		switch (opt) {
+		case 'd':
+			options->directory = optarg;
+			break;
+		case 'm':
+			options->manifest = optarg;
+			break;
+		case 'j':
+			options->jobs = (int)strtoul(optarg, NULL, 0);
+			break;
+		case 'g':
+			options->girafarig = true;
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+void write_species_file(const char *dir, const char *name, uint8_t *data, long size) {
+	char *path = species_path(dir, name);
+	write_if_changed(path, data, size);
+	free(path);
+}
+
+// Does the work of png_dimensions, rgbgfx, pokemon_animation_graphics, and pokemon_animation
+// with a single decode of front.png; unchanged outputs keep their timestamps
+void make_front(const char *dir, bool girafarig, struct Arena *arena) {
+	char *filename = species_path(dir, "front.png");
+	uint32_t width_px = read_png_width(filename);
+	if (width_px != 40 && width_px != 48 && width_px != 56) {
+		error_exit("Not a valid width for \"%s\": %" PRIu32 " px\n", filename, width_px);
+	}
+	int width = width_px / 8;
+	uint8_t dimensions = (width << 4) | width;
+	write_species_file(dir, "front.dimensions", &dimensions, 1);
+
+	int num_tiles;
+	uint8_t *tiles = read_png_tiles(filename, &num_tiles);
+	long tiles_size = num_tiles * TILE_SIZE;
+	transpose_frames(tiles, tiles_size, width, filename);
+
+	long size;
+	uint8_t *graphics = make_animated_graphics(tiles, tiles_size, width * width, girafarig, &size);
+	write_species_file(dir, "front.animated.2bpp", graphics, size);
+	free(graphics);
+
+	uint8_t *tilemap = make_animated_tilemap(tiles, tiles_size, width * width, girafarig, &size);
+	write_species_file(dir, "front.animated.tilemap", tilemap, size);
+
+	struct Frames frames = {0};
+	struct Bitmasks bitmasks = {0};
+	make_frames(tilemap, size, width, &frames, &bitmasks, arena);
+	write_species_animation(dir, &frames, &bitmasks, true);
+	arena_reset(arena);
+
+	free(tilemap);
+	free(tiles);
+	free(filename);
+}
+
+struct Batch {
+	const struct Options *options;
+	const struct SpeciesList *species;
+	struct Arena *arenas; // one per thread, reset after each species
+};
+
+void process_species(int index, int thread, void *arg) {
+	const struct Batch *batch = arg;
+	make_front(batch->species->dirs[index], batch->options->girafarig, &batch->arenas[thread]);
+}
+
+int main(int argc, char *argv[]) {
+	struct Options options = {0};
+	parse_args(argc, argv, &options);
+
+	argc -= optind;
+	argv += optind;
+	if (argc < 1 && !options.directory && !options.manifest) {
+		usage_exit(1);
+	}
+
+	struct SpeciesList species = {0};
+	if (options.directory) {
+		list_species_dirs(&species, options.directory, "front.png");
+	}
+	if (options.manifest) {
+		read_species_manifest(&species, options.manifest);
+	}
+	for (int i = 0; i < argc; i++) {
+		size_t len = strlen(argv[i]);
+		if (len < 9 || strcmp(argv[i] + len - 9, "front.png") || (len > 9 && argv[i][len - 10] != '/')) {
+			error_exit("%s: expected a front.png file\n", argv[i]);
+		}
+		add_species_dir(&species, len > 9 ? argv[i] : ".", len > 9 ? len - 10 : 1);
+	}
+
+	int num_threads = parallel_num_threads(options.jobs);
+	struct Batch batch = {&options, &species, xcalloc(num_threads * sizeof(struct Arena))};
+	parallel_for(species.num_dirs, num_threads, process_species, &batch);
+	for (int i = 0; i < num_threads; i++) {
+		arena_free(&batch.arenas[i]);
+	}
+	free(batch.arenas);
+	free_species_list(&species);
+	return 0;
+}
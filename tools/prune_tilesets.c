@@ -0,0 +1,555 @@
+#define PROGRAM_NAME "prune_tilesets"
+#define USAGE_OPTS "[-h|--help] [-b|--blocks] [-d|--outdir dir] [-p|--pin slot[,slot...]] usage.bin [tileset...]"
+
+#include "common.h"
+#include "mapdata.h"
+#include "tilepng.h"
+
+struct Options {
+	bool prune_blocks;
+	const char *outdir;
+	uint8_t pinned[NUM_VRAM_SLOTS / 8];
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"blocks", no_argument, 0, 'b'},
+		{"outdir", required_argument, 0, 'd'},
+		{"pin", required_argument, 0, 'p'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "bd:p:h", long_options)) != -1;) {
+		switch (opt) {
+		case 'b':
+			options->prune_blocks = true;
+			break;
+		case 'd':
+			options->outdir = optarg;
+			break;
+		case 'p':
+			for (char *token = strtok(optarg, ","); token; token = strtok(NULL, ",")) {
+				unsigned long slot = strtoul(token, NULL, 0);
+				if (slot >= NUM_VRAM_SLOTS) {
+					error_exit("Invalid VRAM slot: %s\n", token);
+				}
+				BIT_SET(options->pinned, slot);
+			}
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+#define SLICE_TILES 0x80 // tiles per "%.2bpp.vramN" slice (see Makefile)
+
+struct Graphics {
+	char *filename; // the .2bpp that groups load from; its .png is the source
+	uint8_t *tiles;
+	int num_tiles;
+	bool keep[0x400];
+	bool pinned[0x400];
+	int remap[0x400]; // new index of each tile, or -1
+	int new_num_tiles;
+	bool selected;
+};
+
+struct Pruner {
+	struct MapData data;
+	struct Options options;
+	struct TilesetUsage *usage;
+	struct TilesetUsage *field_move_usage; // blocks in the field move tables, per tileset
+	uint8_t (*pinned)[NUM_VRAM_SLOTS / 8]; // per tileset
+	struct Graphics *graphics;
+	int num_graphics;
+	bool *selected; // per tileset
+};
+
+int find_graphics(const struct Pruner *pruner, const char *filename) {
+	for (int i = 0; i < pruner->num_graphics; i++) {
+		if (!strcmp(pruner->graphics[i].filename, filename)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void collect_graphics(struct Pruner *pruner) {
+	for (int t = 0; t < pruner->data.num_tilesets; t++) {
+		for (int g = 0; g < NUM_GFX; g++) {
+			const struct TilesetGFX *gfx = &pruner->data.tilesets[t].gfx[g];
+			if (!gfx->filename || find_graphics(pruner, gfx->filename) != -1) {
+				continue;
+			}
+			pruner->graphics = xrealloc(pruner->graphics, (pruner->num_graphics + 1) * sizeof(*pruner->graphics));
+			struct Graphics *graphics = &pruner->graphics[pruner->num_graphics++];
+			memset(graphics, 0, sizeof(*graphics));
+			graphics->filename = gfx->filename;
+		}
+	}
+
+	// Selecting a tileset selects everything that shares its graphics or metatiles
+	for (bool changed = true; changed;) {
+		changed = false;
+		for (int t = 0; t < pruner->data.num_tilesets; t++) {
+			for (int u = 0; u < pruner->data.num_tilesets; u++) {
+				if (pruner->selected[u] && !pruner->selected[t]
+					&& shares_metatiles(&pruner->data.tilesets[t], &pruner->data.tilesets[u])) {
+					pruner->selected[t] = changed = true;
+				}
+			}
+			for (int g = 0; g < NUM_GFX; g++) {
+				const struct TilesetGFX *gfx = &pruner->data.tilesets[t].gfx[g];
+				if (!gfx->filename) {
+					continue;
+				}
+				struct Graphics *graphics = &pruner->graphics[find_graphics(pruner, gfx->filename)];
+				if (pruner->selected[t] != graphics->selected) {
+					pruner->selected[t] = graphics->selected = true;
+					changed = true;
+				}
+			}
+		}
+	}
+}
+
+bool has_metatile_partner(const struct Pruner *pruner, const struct Graphics *graphics) {
+	for (int t = 0; t < pruner->data.num_tilesets; t++) {
+		const struct Tileset *tileset = &pruner->data.tilesets[t];
+		for (int u = 0; u < pruner->data.num_tilesets; u++) {
+			const struct Tileset *other = &pruner->data.tilesets[u];
+			if (u == t || !shares_metatiles(tileset, other)) {
+				continue;
+			}
+			for (int g = 0; g < NUM_GFX; g++) {
+				const struct TilesetGFX *a = &tileset->gfx[g], *b = &other->gfx[g];
+				if (a->filename && !strcmp(a->filename, graphics->filename)
+					&& (!b->filename || strcmp(b->filename, a->filename) || b->first_tile != a->first_tile)) {
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+void plan_graphics(struct Pruner *pruner, struct Graphics *graphics) {
+	char *png_filename = replace_extension(graphics->filename, ".2bpp", ".png");
+	graphics->tiles = read_png_tiles(png_filename, &graphics->num_tiles);
+	free(png_filename);
+	if (graphics->num_tiles > (int)COUNTOF(graphics->keep)) {
+		error_exit("%s: too many tiles: %d\n", graphics->filename, graphics->num_tiles);
+	}
+
+	// Gather used and pinned tiles from every tileset that loads this file
+	bool loaded[COUNTOF(graphics->keep)] = {0};
+	int region_starts[NUM_GFX * 0x10];
+	int num_regions = 0;
+	for (int t = 0; t < pruner->data.num_tilesets; t++) {
+		const struct TilesetUsage *usage = &pruner->usage[t];
+		for (int g = 0; g < NUM_GFX; g++) {
+			const struct TilesetGFX *gfx = &pruner->data.tilesets[t].gfx[g];
+			if (!gfx->filename || strcmp(gfx->filename, graphics->filename)) {
+				continue;
+			}
+			bool known = false;
+			for (int r = 0; r < num_regions; r++) {
+				known |= region_starts[r] == gfx->first_tile;
+			}
+			if (!known) {
+				region_starts[num_regions++] = gfx->first_tile;
+			}
+			for (int i = 0; i < GFX_GROUP_TILES && gfx->first_tile + i < graphics->num_tiles; i++) {
+				int tile = gfx->first_tile + i, slot = gfx_group_slots[g] + i;
+				loaded[tile] = true;
+				if (BIT_TEST(usage->slots, slot)) {
+					graphics->keep[tile] = true;
+				}
+				if (BIT_TEST(pruner->pinned[t], slot)) {
+					graphics->keep[tile] = graphics->pinned[tile] = true;
+				}
+			}
+		}
+	}
+	// Tilesets in this repository slice every file at multiples of SLICE_TILES
+	for (int r = 0; r < num_regions; r++) {
+		if (region_starts[r] % SLICE_TILES) {
+			error_exit("%s: unsupported slice at tile %d\n", graphics->filename, region_starts[r]);
+		}
+	}
+
+	// Shared metatiles with different graphics need the same layout in both files, so keep this one as is
+	if (has_metatile_partner(pruner, graphics)) {
+		for (int i = 0; i < graphics->num_tiles; i++) {
+			graphics->remap[i] = i;
+		}
+		graphics->new_num_tiles = graphics->num_tiles;
+		return;
+	}
+
+	// Compact each slice: pinned tiles stay put, other kept tiles fill free positions in order
+	for (int i = 0; i < graphics->num_tiles; i++) {
+		graphics->remap[i] = -1;
+	}
+	graphics->new_num_tiles = 0;
+	for (int start = 0; start < graphics->num_tiles; start += SLICE_TILES) {
+		int end = start + SLICE_TILES < graphics->num_tiles ? start + SLICE_TILES : graphics->num_tiles;
+		bool taken[SLICE_TILES] = {0};
+		for (int i = start; i < end; i++) {
+			if (graphics->pinned[i]) {
+				graphics->remap[i] = i;
+				taken[i - start] = true;
+			}
+		}
+		int next = 0;
+		for (int i = start; i < end; i++) {
+			if (!graphics->keep[i] || graphics->pinned[i] || !loaded[i]) {
+				continue;
+			}
+			while (taken[next]) {
+				next++;
+			}
+			graphics->remap[i] = start + next;
+			taken[next] = true;
+		}
+		// Earlier slices keep their full size, so later "%.2bpp.vramN" slices still line up
+		for (int i = 0; i < end - start; i++) {
+			if (taken[i]) {
+				graphics->new_num_tiles = start + i + 1;
+			}
+		}
+	}
+}
+
+void write_graphics(const struct Pruner *pruner, const struct Graphics *graphics) {
+	uint8_t *tiles = xcalloc((graphics->new_num_tiles + 1) * TILE_SIZE);
+	for (int i = 0; i < graphics->num_tiles; i++) {
+		if (graphics->remap[i] != -1) {
+			memcpy(&tiles[graphics->remap[i] * TILE_SIZE], &graphics->tiles[i * TILE_SIZE], TILE_SIZE);
+		}
+	}
+	char *bpp_filename = output_path(pruner->options.outdir, graphics->filename);
+	write_u8(bpp_filename, tiles, graphics->new_num_tiles * TILE_SIZE);
+	char *png_filename = replace_extension(bpp_filename, ".2bpp", ".png");
+	write_png_tiles(png_filename, tiles, graphics->new_num_tiles);
+	printf("%s: %d -> %d tiles\n", graphics->filename, graphics->num_tiles, graphics->new_num_tiles);
+	free(bpp_filename);
+	free(png_filename);
+	free(tiles);
+}
+
+// New slot for a metatile's tile, or -1 if its tile was pruned
+int remap_slot(const struct Pruner *pruner, const struct Tileset *tileset, int slot) {
+	int g = slot_group(slot);
+	if (g == -1 || !tileset->gfx[g].filename) {
+		return slot;
+	}
+	const struct Graphics *graphics = &pruner->graphics[find_graphics(pruner, tileset->gfx[g].filename)];
+	int tile = tileset->gfx[g].first_tile + slot - gfx_group_slots[g];
+	if (tile >= graphics->num_tiles) {
+		return slot;
+	}
+	if (graphics->remap[tile] == -1) {
+		return -1;
+	}
+	return gfx_group_slots[g] + graphics->remap[tile] - tileset->gfx[g].first_tile;
+}
+
+// Blocks that asm refers to by ID: map border blocks, "changeblock" blocks, and field move blocks.
+// These are not rewritten, so they must keep their IDs.
+void mark_asm_blocks(const struct Pruner *pruner, int t, uint8_t *blocks) {
+	const struct Tileset *tileset = &pruner->data.tilesets[t];
+	for (int m = 0; m < pruner->data.num_maps; m++) {
+		const struct Map *map = &pruner->data.maps[m];
+		if (!shares_metatiles(&pruner->data.tilesets[map->tileset], tileset)) {
+			continue;
+		}
+		if (map->border_block >= 0 && map->border_block < MAX_BLOCKS) {
+			BIT_SET(blocks, map->border_block);
+		}
+		if (mark_script_blocks(map->name, blocks)) {
+			error_exit("maps/%s.asm: \"changeblock\" uses an unknown block; cannot prune blocks of %s\n",
+				map->name, tileset->name);
+		}
+	}
+	for (int u = 0; u < pruner->data.num_tilesets; u++) {
+		if (shares_metatiles(&pruner->data.tilesets[u], tileset)) {
+			for (int i = 0; i < MAX_BLOCKS / 8; i++) {
+				blocks[i] |= pruner->field_move_usage[u].blocks[i];
+			}
+		}
+	}
+}
+
+// Which blocks to keep, and where; returns the new block count.
+// Blocks referred to from asm stay put, and other kept blocks fill free IDs in order.
+int plan_blocks(const struct Pruner *pruner, int t, int num_blocks, int *block_remap) {
+	if (!pruner->options.prune_blocks) {
+		for (int b = 0; b < num_blocks; b++) {
+			block_remap[b] = b;
+		}
+		return num_blocks;
+	}
+	uint8_t fixed[MAX_BLOCKS / 8] = {0};
+	mark_asm_blocks(pruner, t, fixed);
+	bool taken[MAX_BLOCKS] = {0};
+	for (int b = 0; b < num_blocks; b++) {
+		taken[b] = BIT_TEST(fixed, b);
+		block_remap[b] = taken[b] ? b : -1;
+	}
+	int new_num_blocks = 0, next = 0;
+	for (int b = 0; b < num_blocks; b++) {
+		bool used = false;
+		for (int u = 0; u < pruner->data.num_tilesets; u++) {
+			if (shares_metatiles(&pruner->data.tilesets[t], &pruner->data.tilesets[u])) {
+				used |= BIT_TEST(pruner->usage[u].blocks, b);
+			}
+		}
+		if (used && block_remap[b] == -1) {
+			while (taken[next]) {
+				next++;
+			}
+			block_remap[b] = next;
+			taken[next] = true;
+		}
+		if (block_remap[b] >= new_num_blocks) {
+			new_num_blocks = block_remap[b] + 1;
+		}
+	}
+	return new_num_blocks;
+}
+
+void rewrite_collision(const struct Pruner *pruner, const struct Tileset *tileset, const int *source, int new_num_blocks, int num_blocks) {
+	if (!tileset->collision_filename) {
+		return;
+	}
+	// Collision is compiled from "*_collision.asm", one "tilecoll" per block
+	char *asm_filename = replace_extension(tileset->collision_filename, ".bin", ".asm");
+	char *text = read_text(asm_filename);
+	const char *lines[MAX_BLOCKS];
+	size_t lengths[MAX_BLOCKS];
+	int block = 0;
+	const char *header_end = text, *trailer = text;
+	for (char *cursor = text, *end; cursor && *cursor && block < num_blocks; cursor = end) {
+		end = strchr(cursor, '\n');
+		size_t len = end ? (size_t)(++end - cursor) : strlen(cursor);
+		const char *tilecoll = strstr(cursor, "tilecoll");
+		if (!tilecoll || (end && tilecoll >= end)) {
+			continue;
+		}
+		if (!block) {
+			header_end = cursor;
+		}
+		lines[block] = cursor;
+		lengths[block++] = len;
+		trailer = cursor + len;
+	}
+	if (block < num_blocks) {
+		error_exit("%s: expected %d \"tilecoll\" lines\n", asm_filename, num_blocks);
+	}
+
+	char *path = output_path(pruner->options.outdir, asm_filename);
+	FILE *f = xfopen(path, 'w');
+	fwrite(text, 1, header_end - text, f);
+	for (int b = 0; b < new_num_blocks; b++) {
+		const char *line = lines[source[b]];
+		size_t len = lengths[source[b]];
+		const char *comment = memchr(line, ';', len);
+		if (comment && source[b] != b) {
+			// Renumber the "; xx" block comment
+			fwrite(line, 1, comment - line, f);
+			fprintf(f, "; %02x\n", b);
+		} else {
+			fwrite(line, 1, len, f);
+			if (line[len - 1] != '\n') {
+				putc('\n', f);
+			}
+		}
+	}
+	fputs(trailer, f);
+	fclose(f);
+	free(path);
+	free(text);
+	free(asm_filename);
+}
+
+void rewrite_block_data(const struct Pruner *pruner, int t, const int *block_remap, int num_blocks) {
+	for (int i = 0; i < pruner->data.num_block_data; i++) {
+		const struct BlockData *block_data = &pruner->data.block_data[i];
+		bool ours = false, theirs = false;
+		for (int m = 0; m < pruner->data.num_maps; m++) {
+			const struct Map *map = &pruner->data.maps[m];
+			if (map->block_data == i || (block_data->map == m && map->block_data != i)) {
+				bool same = shares_metatiles(&pruner->data.tilesets[map->tileset], &pruner->data.tilesets[t]);
+				ours |= same;
+				theirs |= !same;
+			}
+		}
+		if (!ours) {
+			continue;
+		}
+		if (theirs) {
+			error_exit("%s: shared by maps with other tilesets; cannot prune blocks of %s\n",
+				block_data->filename, pruner->data.tilesets[t].name);
+		}
+		struct MappedFile file = map_file(block_data->filename);
+		uint8_t *blocks = xmalloc(file.size + 1);
+		bool moved = false;
+		for (size_t j = 0; j < file.size; j++) {
+			int block = file.data[j] < num_blocks ? block_remap[file.data[j]] : file.data[j];
+			if (block == -1) {
+				error_exit("%s: uses block $%02x, which is not in the usage data for %s\n",
+					block_data->filename, file.data[j], pruner->data.tilesets[t].name);
+			}
+			blocks[j] = (uint8_t)block;
+			moved |= block != file.data[j];
+		}
+		if (moved) {
+			char *path = output_path(pruner->options.outdir, block_data->filename);
+			write_u8(path, blocks, file.size);
+			free(path);
+		}
+		free(blocks);
+		unmap_file(&file);
+	}
+}
+
+void prune_tileset(const struct Pruner *pruner, int t) {
+	const struct Tileset *tileset = &pruner->data.tilesets[t];
+	long metatiles_size, attributes_size;
+	uint8_t *metatiles = read_u8(tileset->metatiles_filename, &metatiles_size);
+	uint8_t *attributes = read_u8(tileset->attributes_filename, &attributes_size);
+	if (metatiles_size % METATILE_SIZE || metatiles_size != attributes_size) {
+		error_exit("%s: metatiles and attributes do not match\n", tileset->name);
+	}
+	int num_blocks = (int)(metatiles_size / METATILE_SIZE);
+	if (num_blocks > MAX_BLOCKS) {
+		error_exit("%s: %d blocks; at most %d are supported\n", tileset->name, num_blocks, MAX_BLOCKS);
+	}
+	int block_remap[MAX_BLOCKS];
+	int new_num_blocks = plan_blocks(pruner, t, num_blocks, block_remap);
+	// The old block at each new ID; IDs left free around pinned blocks keep their unused old block
+	int source[MAX_BLOCKS];
+	for (int b = 0; b < num_blocks; b++) {
+		source[b] = b;
+	}
+	for (int b = 0; b < num_blocks; b++) {
+		if (block_remap[b] != -1) {
+			source[block_remap[b]] = b;
+		}
+	}
+
+	int dropped_tiles = 0;
+	uint8_t *new_metatiles = xmalloc(metatiles_size + 1);
+	uint8_t *new_attributes = xmalloc(attributes_size + 1);
+	for (int b = 0; b < new_num_blocks; b++) {
+		for (int i = 0; i < METATILE_SIZE; i++) {
+			int src = source[b] * METATILE_SIZE + i, dst = b * METATILE_SIZE + i;
+			int slot = remap_slot(pruner, tileset, VRAM_SLOT(metatiles[src], attributes[src]));
+			if (slot == -1) {
+				// Only unused blocks can refer to pruned tiles; point them at their group's first slot
+				slot = gfx_group_slots[slot_group(VRAM_SLOT(metatiles[src], attributes[src]))];
+				dropped_tiles++;
+			}
+			new_metatiles[dst] = slot & 0xff;
+			new_attributes[dst] = (attributes[src] & ~ATTR_BANK1) | (slot >= 0x100 ? ATTR_BANK1 : 0);
+		}
+	}
+
+	char *path = output_path(pruner->options.outdir, tileset->metatiles_filename);
+	write_u8(path, new_metatiles, new_num_blocks * METATILE_SIZE);
+	free(path);
+	path = output_path(pruner->options.outdir, tileset->attributes_filename);
+	write_u8(path, new_attributes, new_num_blocks * METATILE_SIZE);
+	free(path);
+
+	if (new_num_blocks != num_blocks) {
+		rewrite_collision(pruner, tileset, source, new_num_blocks, num_blocks);
+		rewrite_block_data(pruner, t, block_remap, num_blocks);
+		// Blocks referred to from asm kept their IDs, so only .ablk files and collision refer to these
+		for (int b = 0; b < num_blocks; b++) {
+			if (block_remap[b] != -1 && block_remap[b] != b) {
+				printf("%s: block $%02x -> $%02x\n", tileset->name, b, block_remap[b]);
+			}
+		}
+	}
+	printf("%s: %d -> %d blocks", tileset->name, num_blocks, new_num_blocks);
+	if (dropped_tiles) {
+		printf(", %d unused block tiles cleared", dropped_tiles);
+	}
+	putchar('\n');
+
+	free(metatiles);
+	free(attributes);
+	free(new_metatiles);
+	free(new_attributes);
+}
+
+int main(int argc, char *argv[]) {
+	struct Pruner pruner = {0};
+	parse_args(argc, argv, &pruner.options);
+
+	argc -= optind;
+	argv += optind;
+	if (argc < 1) {
+		usage_exit(1);
+	}
+
+	load_map_data(&pruner.data);
+	int num_tilesets = pruner.data.num_tilesets;
+	pruner.usage = read_tileset_usage(argv[0], num_tilesets);
+	pruner.pinned = xcalloc(num_tilesets * sizeof(*pruner.pinned));
+	pruner.field_move_usage = xcalloc(num_tilesets * sizeof(*pruner.field_move_usage));
+	mark_field_move_blocks(&pruner.data, pruner.field_move_usage);
+	pruner.selected = xcalloc(num_tilesets * sizeof(*pruner.selected));
+	for (int i = 1; i < argc; i++) {
+		bool found = false;
+		for (int t = 0; t < num_tilesets; t++) {
+			if (!strcmp(argv[i], pruner.data.tilesets[t].name)) {
+				pruner.selected[t] = found = true;
+			}
+		}
+		if (!found) {
+			error_exit("Unknown tileset: \"%s\"\n", argv[i]);
+		}
+	}
+	if (argc == 1) {
+		for (int t = 0; t < num_tilesets; t++) {
+			pruner.selected[t] = true;
+		}
+	}
+
+	read_tileset_pins(&pruner.data, pruner.pinned, pruner.options.pinned);
+	collect_graphics(&pruner);
+	// Files and tilesets are processed in the order data/tilesets.asm lists them, so output is stable
+	for (int i = 0; i < pruner.num_graphics; i++) {
+		if (pruner.graphics[i].selected) {
+			plan_graphics(&pruner, &pruner.graphics[i]);
+			write_graphics(&pruner, &pruner.graphics[i]);
+		}
+	}
+	for (int t = 0; t < num_tilesets; t++) {
+		// Shared metatiles are pruned once, for the first tileset that uses them
+		int first = 0;
+		while (!shares_metatiles(&pruner.data.tilesets[first], &pruner.data.tilesets[t])) {
+			first++;
+		}
+		if (pruner.selected[t] && first == t) {
+			prune_tileset(&pruner, t);
+		}
+	}
+
+	for (int i = 0; i < pruner.num_graphics; i++) {
+		free(pruner.graphics[i].tiles);
+	}
+	free(pruner.graphics);
+	free(pruner.usage);
+	free(pruner.field_move_usage);
+	free(pruner.pinned);
+	free(pruner.selected);
+	return 0;
+}
@@ -0,0 +1,551 @@
+#define PROGRAM_NAME "render_maps"
+#define USAGE_OPTS "[-h|--help] [-j|--jobs n] [-d|--outdir dir] [-m|--metatiles] [-q|--quiet] [tileset|map...]"
+
+#include "common.h"
+#include "mapdata.h"
+#include "parallel.h"
+#include "tilepng.h"
+
+struct Options {
+	int jobs;
+	const char *outdir;
+	bool metatiles;
+	bool quiet;
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"jobs", required_argument, 0, 'j'},
+		{"outdir", required_argument, 0, 'd'},
+		{"metatiles", no_argument, 0, 'm'},
+		{"quiet", no_argument, 0, 'q'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "j:d:mqh", long_options)) != -1;) {
+		switch (opt) {
+		case 'j':
+			options->jobs = (int)strtoul(optarg, NULL, 0);
+			break;
+		case 'd':
+			options->outdir = optarg;
+			break;
+		case 'm':
+			options->metatiles = true;
+			break;
+		case 'q':
+			options->quiet = true;
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+#define BG_TILES_PAL_FILE "gfx/tilesets/bg_tiles.pal"
+#define NUM_PALETTES 8
+#define BLOCK_PX (METATILE_WIDTH * 8)
+#define BLOCK_BYTES (BLOCK_PX * BLOCK_PX) // one palette index per pixel
+#define DEFAULT_COLOR (NUM_PALETTES * 4) // index of default_rgb
+#define SHEET_WIDTH_BLOCKS 4
+
+typedef uint8_t Palette[4][3];
+
+enum PaletteKind { PAL_DAY, PAL_NITE, PAL_INDOOR, PAL_FILE };
+
+struct PaletteSource {
+	const char *key; // block data or tileset name
+	enum PaletteKind kind;
+	const char *filename;
+	int first; // first palette used from filename
+};
+
+// Maps with palettes of their own
+static const struct PaletteSource map_palettes[] = {
+	{"BellchimeTrail",             PAL_FILE,   "maps/BellchimeTrail.pal",                  8},
+	{"BrunosRoom",                 PAL_FILE,   "maps/BrunosRoom.pal",                      0},
+	{"CeladonHomeDecorStore4F",    PAL_FILE,   "maps/CeladonHomeDecorStore4F.pal",         0},
+	{"CeladonMansionRoof",         PAL_FILE,   "maps/CeladonMansionRoof.pal",              8},
+	{"CeruleanCave1F",             PAL_FILE,   "gfx/tilesets/cerulean_cave.pal",           0},
+	{"CeruleanCave2F",             PAL_FILE,   "gfx/tilesets/cerulean_cave.pal",           0},
+	{"CeruleanCaveB1F",            PAL_FILE,   "gfx/tilesets/cerulean_cave.pal",           0},
+	{"CeruleanGym",                PAL_FILE,   "maps/CeruleanGym.pal",                     0},
+	{"CinnabarLab",                PAL_FILE,   "maps/CinnabarLab.pal",                     0},
+	{"CinnabarVolcano1F",          PAL_FILE,   "gfx/tilesets/cinnabar_volcano.pal",        0},
+	{"CinnabarVolcanoB1F",         PAL_FILE,   "gfx/tilesets/cinnabar_volcano.pal",        0},
+	{"CinnabarVolcanoB2F",         PAL_FILE,   "gfx/tilesets/cinnabar_volcano.pal",        0},
+	{"CliffEdgeGate",              PAL_DAY, NULL, 0},
+	{"DarkCaveBlackthornEntrance", PAL_FILE,   "gfx/tilesets/dark_cave.pal",               0},
+	{"DarkCaveVioletEntrance",     PAL_FILE,   "gfx/tilesets/dark_cave.pal",               0},
+	{"DimCave1F",                  PAL_FILE,   "gfx/tilesets/dim_cave.pal",                0},
+	{"DimCave2F",                  PAL_FILE,   "gfx/tilesets/dim_cave.pal",                0},
+	{"DimCave3F",                  PAL_FILE,   "gfx/tilesets/dim_cave.pal",                0},
+	{"DimCave4F",                  PAL_FILE,   "gfx/tilesets/dim_cave.pal",                0},
+	{"DimCave5F",                  PAL_FILE,   "gfx/tilesets/dim_cave.pal",                0},
+	{"DragonsDenB1F",              PAL_NITE, NULL, 0},
+	{"DragonShrine",               PAL_FILE,   "maps/DragonShrine.pal",                    0},
+	{"EcruteakCity",               PAL_FILE,   "gfx/tilesets/violet_ecruteak.pal",         8},
+	{"EmbeddedTower",              PAL_FILE,   "maps/EmbeddedTower.pal",                   0},
+	{"FuchsiaGym",                 PAL_FILE,   "maps/FuchsiaGym.pal",                      0},
+	{"GoldenrodDeptStoreRoof",     PAL_FILE,   "maps/GoldenrodDeptStoreRoof.pal",          8},
+	{"HallOfFame",                 PAL_FILE,   "maps/HallOfFame.pal",                      0},
+	{"HauntedRadioTower2F",        PAL_FILE,   "gfx/tilesets/haunted_radio_tower.pal",     0},
+	{"HauntedRadioTower3F",        PAL_FILE,   "gfx/tilesets/haunted_radio_tower.pal",     0},
+	{"HauntedRadioTower4F",        PAL_FILE,   "gfx/tilesets/haunted_pokemon_tower.pal",   0},
+	{"HauntedRadioTower5F",        PAL_FILE,   "gfx/tilesets/haunted_pokemon_tower.pal",   0},
+	{"HauntedRadioTower6F",        PAL_FILE,   "gfx/tilesets/haunted_pokemon_tower.pal",   0},
+	{"HiddenCaveGrotto",           PAL_FILE,   "maps/HiddenCaveGrotto.pal",                0},
+	{"HiddenTreeGrotto",           PAL_FILE,   "maps/HiddenTreeGrotto.pal",                0},
+	{"IvysLab",                    PAL_FILE,   "maps/IvysLab.pal",                         0},
+	{"KarensRoom",                 PAL_FILE,   "maps/KarensRoom.pal",                      0},
+	{"KogasRoom",                  PAL_FILE,   "maps/KogasRoom.pal",                       0},
+	{"LancesRoom",                 PAL_FILE,   "maps/LancesRoom.pal",                      0},
+	{"LightningIsland",            PAL_FILE,   "maps/LightningIsland.pal",                 0},
+	{"MountMortar1FInside",        PAL_FILE,   "gfx/tilesets/dark_cave.pal",               0},
+	{"MountMortar1FOutside",       PAL_FILE,   "gfx/tilesets/dark_cave.pal",               0},
+	{"MountMortar2FInside",        PAL_FILE,   "gfx/tilesets/dark_cave.pal",               0},
+	{"MountMortarB1F",             PAL_FILE,   "gfx/tilesets/dark_cave.pal",               0},
+	{"MurkySwamp",                 PAL_FILE,   "maps/MurkySwamp.pal",                      0},
+	{"MystriStage",                PAL_FILE,   "maps/MystriStage.pal",                     0},
+	{"NavelRockInside",            PAL_FILE,   "gfx/tilesets/navel_rock.pal",              8},
+	{"NavelRockRoof",              PAL_FILE,   "gfx/tilesets/navel_rock.pal",              8},
+	{"NoisyForest",                PAL_FILE,   "gfx/tilesets/shamouti_island.pal",        16},
+	{"OaksLab",                    PAL_FILE,   "maps/OaksLab.pal",                         0},
+	{"OlivineLighthouseRoof",      PAL_FILE,   "maps/GoldenrodDeptStoreRoof.pal",          8},
+	{"SaffronGym",                 PAL_FILE,   "maps/SaffronGym.pal",                      0},
+	{"ScaryCave1F",                PAL_FILE,   "gfx/tilesets/scary_cave.pal",              0},
+	{"ScaryCaveB1F",               PAL_FILE,   "gfx/tilesets/scary_cave.pal",              0},
+	{"ScaryCaveShipwreck",         PAL_FILE,   "gfx/tilesets/scary_cave.pal",              0},
+	{"SeafoamGym",                 PAL_DAY, NULL, 0},
+	{"SilverCaveRoom1",            PAL_FILE,   "gfx/tilesets/silver_cave.pal",             0},
+	{"SilverCaveRoom2",            PAL_FILE,   "gfx/tilesets/silver_cave.pal",             0},
+	{"SilverCaveRoom3",            PAL_FILE,   "gfx/tilesets/silver_cave.pal",             0},
+	{"SinjohRuins",                PAL_FILE,   "maps/SinjohRuins.pal",                     8},
+	{"TinTowerRoof",               PAL_FILE,   "maps/TinTowerRoof.pal",                    8},
+	{"VioletCity",                 PAL_FILE,   "gfx/tilesets/violet_ecruteak.pal",         8},
+	{"ViridianGym",                PAL_FILE,   "maps/ViridianGym.pal",                     0},
+	{"WhirlIslandB1F",             PAL_FILE,   "gfx/tilesets/whirl_islands.pal",           0},
+	{"WhirlIslandB2F",             PAL_FILE,   "gfx/tilesets/whirl_islands.pal",           0},
+	{"WhirlIslandLugiaChamber",    PAL_FILE,   "gfx/tilesets/whirl_islands.pal",           0},
+	{"WhirlIslandNE",              PAL_FILE,   "gfx/tilesets/whirl_islands.pal",           0},
+	{"WhirlIslandSE",              PAL_FILE,   "gfx/tilesets/whirl_islands.pal",           0},
+	{"WhirlIslandSW",              PAL_FILE,   "gfx/tilesets/whirl_islands.pal",           0},
+	{"WillsRoom",                  PAL_FILE,   "maps/WillsRoom.pal",                       0},
+	{"YellowForest",               PAL_FILE,   "maps/YellowForest.pal",                    8},
+};
+
+// Tilesets that do not use the indoor palettes; any others do
+static const struct PaletteSource tileset_palettes[] = {
+	{"johto_traditional",    PAL_DAY, NULL, 0},
+	{"johto_modern",         PAL_DAY, NULL, 0},
+	{"battle_tower_outside", PAL_DAY, NULL, 0},
+	{"johto_overcast",       PAL_DAY, NULL, 0},
+	{"kanto",                PAL_DAY, NULL, 0},
+	{"indigo_plateau",       PAL_DAY, NULL, 0},
+	{"park",                 PAL_DAY, NULL, 0},
+	{"forest",               PAL_NITE, NULL, 0},
+	{"cave",                 PAL_NITE, NULL, 0},
+	{"tunnel",               PAL_NITE, NULL, 0},
+	{"alph_word_room",       PAL_FILE,   "gfx/tilesets/ruins_of_alph.pal",           0},
+	{"battle_tower_inside",  PAL_FILE,   "gfx/tilesets/battle_tower_inside.pal",     0},
+	{"faraway_island",       PAL_FILE,   "gfx/tilesets/faraway_island.pal",          8},
+	{"game_corner",          PAL_FILE,   "gfx/tilesets/game_corner.pal",             0},
+	{"gate",                 PAL_FILE,   "gfx/tilesets/gate.pal",                    0},
+	{"hotel",                PAL_FILE,   "gfx/tilesets/hotel.pal",                   0},
+	{"ice_path",             PAL_FILE,   "gfx/tilesets/ice_path.pal",                0},
+	{"mart",                 PAL_FILE,   "gfx/tilesets/mart.pal",                    0},
+	{"pokecenter",           PAL_FILE,   "gfx/tilesets/pokecenter.pal",              0},
+	{"pokecom_center",       PAL_FILE,   "gfx/tilesets/pokecom_center.pal",          0},
+	{"quiet_cave",           PAL_FILE,   "gfx/tilesets/quiet_cave.pal",              0},
+	{"radio_tower",          PAL_FILE,   "gfx/tilesets/radio_tower.pal",             0},
+	{"ruins_of_alph",        PAL_FILE,   "gfx/tilesets/ruins_of_alph.pal",           0},
+	{"safari_zone",          PAL_FILE,   "gfx/tilesets/safari_zone.pal",             8},
+	{"shamouti_island",      PAL_FILE,   "gfx/tilesets/shamouti_island.pal",         8},
+	{"valencia_island",      PAL_FILE,   "gfx/tilesets/valencia_island.pal",         8},
+};
+
+static const struct PaletteSource indoor_palette = {NULL, PAL_INDOOR, NULL, 0};
+
+static const uint8_t default_rgb[3] = {0xab, 0xcd, 0xef};
+
+// Reads the colors of a .pal file, skipping any MONOCHROME alternative
+int read_pal_file(const char *filename, Palette **palettes) {
+	char *text = read_text(filename);
+	char *cursor = text;
+	int num_colors = 0;
+	uint8_t (*colors)[3] = NULL;
+	for (char *line; (line = next_line(&cursor));) {
+		char *args = macro_args(line, "RGB");
+		if (!args) {
+			if (!strcmp(line + strspn(line, " \t"), "else")) {
+				break;
+			}
+			continue;
+		}
+		char *argv[12];
+		int argc = split_args(args, argv, 12);
+		for (int i = 0; i + 2 < argc; i += 3) {
+			colors = xrealloc(colors, (num_colors + 1) * sizeof(*colors));
+			for (int c = 0; c < 3; c++) {
+				int x = parse_asm_number(argv[i + c]);
+#define RGB5_TO_RGB8(x) (uint8_t)(((x) << 3) | ((x) >> 2))
+				colors[num_colors][c] = RGB5_TO_RGB8(x & 0x1f);
+			}
+			num_colors++;
+		}
+	}
+	free(text);
+	*palettes = (Palette *)colors;
+	return num_colors / 4;
+}
+
+void load_palettes(const struct PaletteSource *source, Palette *palettes) {
+	static const int day[NUM_PALETTES] = {8, 9, 10, 0x29, 12, 13, 14, 15};
+	static const int nite[NUM_PALETTES] = {16, 17, 18, 0x2a, 20, 21, 22, 23};
+	static const int indoor[NUM_PALETTES] = {32, 33, 34, 35, 36, 37, 38, 39};
+	const int *indexes = source->kind == PAL_DAY ? day : source->kind == PAL_NITE ? nite : indoor;
+
+	Palette *file_palettes;
+	int num_palettes;
+	if (source->kind == PAL_FILE && file_exists(source->filename)) {
+		num_palettes = read_pal_file(source->filename, &file_palettes);
+		if (num_palettes >= source->first + NUM_PALETTES) {
+			memcpy(palettes, &file_palettes[source->first], NUM_PALETTES * sizeof(Palette));
+			free(file_palettes);
+			return;
+		}
+		free(file_palettes);
+		indexes = indoor;
+	}
+	num_palettes = read_pal_file(BG_TILES_PAL_FILE, &file_palettes);
+	for (int i = 0; i < NUM_PALETTES; i++) {
+		if (indexes[i] >= num_palettes) {
+			error_exit("%s: missing palette %d\n", BG_TILES_PAL_FILE, indexes[i]);
+		}
+		memcpy(palettes[i], file_palettes[indexes[i]], sizeof(Palette));
+	}
+	free(file_palettes);
+}
+
+const struct PaletteSource *find_palette_source(const struct PaletteSource *sources, int count, const char *key) {
+	for (int i = 0; i < count; i++) {
+		if (!strcmp(sources[i].key, key)) {
+			return &sources[i];
+		}
+	}
+	return NULL;
+}
+
+// Each tileset and palette pair is decoded once into 32x32-px RGB blocks
+struct BlockCache {
+	int tileset;
+	const struct PaletteSource *palette;
+	Palette colors[NUM_PALETTES];
+	uint8_t *blocks; // palette indexes into colors
+	int num_blocks;
+};
+
+// An image to render: a map's block data, or a tileset's metatiles
+struct RenderJob {
+	int block_data; // -1 for a metatile sheet
+	int tileset;
+	int cache;
+	char *filename;
+};
+
+struct Renderer {
+	struct MapData data;
+	struct Options options;
+	const char *gfx_files[NUM_GFX * 0x100];
+	uint8_t *gfx_tiles[NUM_GFX * 0x100];
+	int gfx_num_tiles[NUM_GFX * 0x100];
+	int num_gfx_files;
+	struct BlockCache *caches;
+	int num_caches;
+	struct RenderJob *jobs;
+	int num_jobs;
+};
+
+int find_gfx_file(const struct Renderer *renderer, const char *filename) {
+	for (int i = 0; i < renderer->num_gfx_files; i++) {
+		if (!strcmp(renderer->gfx_files[i], filename)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void decode_gfx_file(int index, int thread, void *arg) {
+	(void)thread;
+	struct Renderer *renderer = arg;
+	const char *filename = renderer->gfx_files[index];
+	char *png_filename = xmalloc(strlen(filename) + 1);
+	strcpy(png_filename, filename);
+	strcpy(strrchr(png_filename, '.'), ".png");
+	renderer->gfx_tiles[index] = read_png_tiles(png_filename, &renderer->gfx_num_tiles[index]);
+	free(png_filename);
+}
+
+// The 2bpp data that a tileset loads into a VRAM slot, or NULL
+const uint8_t *slot_tile(const struct Renderer *renderer, const struct Tileset *tileset, int slot) {
+	for (int g = 0; g < NUM_GFX; g++) {
+		const struct TilesetGFX *gfx = &tileset->gfx[g];
+		if (!gfx->filename || slot < gfx_group_slots[g] || slot >= gfx_group_slots[g] + GFX_GROUP_TILES) {
+			continue;
+		}
+		int f = find_gfx_file(renderer, gfx->filename);
+		int tile = gfx->first_tile + slot - gfx_group_slots[g];
+		return tile < renderer->gfx_num_tiles[f] ? &renderer->gfx_tiles[f][tile * TILE_SIZE] : NULL;
+	}
+	return NULL;
+}
+
+void draw_tile(uint8_t *block, int x, int y, const uint8_t *tile, uint8_t attr) {
+	int palette = (attr & ATTR_PALETTE) * 4;
+	for (int row = 0; row < 8; row++) {
+		uint8_t *px = &block[(y * 8 + row) * BLOCK_PX + x * 8];
+		int ty = attr & ATTR_YFLIP ? 7 - row : row;
+		for (int col = 0; col < 8; col++) {
+			if (!tile) {
+				px[col] = DEFAULT_COLOR;
+				continue;
+			}
+			int tx = attr & ATTR_XFLIP ? col : 7 - col;
+			uint8_t lo = tile[ty * 2], hi = tile[ty * 2 + 1];
+			px[col] = (uint8_t)(palette + (((lo >> tx) & 1) | (((hi >> tx) & 1) << 1)));
+		}
+	}
+}
+
+void build_block_cache(int index, int thread, void *arg) {
+	(void)thread;
+	struct Renderer *renderer = arg;
+	struct BlockCache *cache = &renderer->caches[index];
+	const struct Tileset *tileset = &renderer->data.tilesets[cache->tileset];
+
+	load_palettes(cache->palette, cache->colors);
+
+	struct MappedFile metatiles = map_file(tileset->metatiles_filename);
+	struct MappedFile attributes = map_file(tileset->attributes_filename);
+	if (metatiles.size % METATILE_SIZE || metatiles.size != attributes.size) {
+		error_exit("%s: metatiles and attributes do not match\n", tileset->name);
+	}
+	cache->num_blocks = (int)(metatiles.size / METATILE_SIZE);
+	cache->blocks = xmalloc((cache->num_blocks + 1) * BLOCK_BYTES);
+	for (int b = 0; b < cache->num_blocks; b++) {
+		for (int i = 0; i < METATILE_SIZE; i++) {
+			uint8_t tile_id = metatiles.data[b * METATILE_SIZE + i];
+			uint8_t attr = attributes.data[b * METATILE_SIZE + i];
+			const uint8_t *tile = slot_tile(renderer, tileset, VRAM_SLOT(tile_id, attr));
+			draw_tile(&cache->blocks[b * BLOCK_BYTES], i % METATILE_WIDTH, i / METATILE_WIDTH, tile, attr);
+		}
+	}
+	unmap_file(&metatiles);
+	unmap_file(&attributes);
+}
+
+void draw_block(uint8_t *image, int width_blocks, int bx, int by, const struct BlockCache *cache, int block) {
+	for (int row = 0; row < BLOCK_PX; row++) {
+		uint8_t *dest = &image[(by * BLOCK_PX + row) * width_blocks * BLOCK_PX + bx * BLOCK_PX];
+		if (block < cache->num_blocks) {
+			memcpy(dest, &cache->blocks[block * BLOCK_BYTES + row * BLOCK_PX], BLOCK_PX);
+		} else {
+			memset(dest, DEFAULT_COLOR, BLOCK_PX);
+		}
+	}
+}
+
+// Writes an image of palette indexes as is; converting colors would cost more than compressing
+unsigned int write_indexed_png(const char *filename, const uint8_t *image, unsigned int width, unsigned int height,
+	const Palette *colors) {
+	LodePNGState state;
+	lodepng_state_init(&state);
+	state.encoder.auto_convert = 0;
+	state.encoder.zlibsettings.windowsize = 512; // a smaller window compresses a little worse, but much faster
+	state.info_raw.colortype = state.info_png.color.colortype = LCT_PALETTE;
+	state.info_raw.bitdepth = state.info_png.color.bitdepth = 8;
+	for (int i = 0; i <= DEFAULT_COLOR; i++) {
+		const uint8_t *color = i == DEFAULT_COLOR ? default_rgb : colors[i / 4][i % 4];
+		lodepng_palette_add(&state.info_raw, color[0], color[1], color[2], 0xff);
+		lodepng_palette_add(&state.info_png.color, color[0], color[1], color[2], 0xff);
+	}
+	unsigned char *buffer;
+	size_t buffer_size;
+	lodepng_encode(&buffer, &buffer_size, image, width, height, &state);
+	unsigned int error = state.error;
+	lodepng_state_cleanup(&state);
+	if (!error) {
+		error = lodepng_save_file(buffer, buffer_size, filename);
+	}
+	free(buffer);
+	return error;
+}
+
+void render_job(int index, int thread, void *arg) {
+	(void)thread;
+	struct Renderer *renderer = arg;
+	const struct RenderJob *job = &renderer->jobs[index];
+	const struct BlockCache *cache = &renderer->caches[job->cache];
+
+	uint8_t *blocks;
+	int num_blocks, width;
+	struct MappedFile file = {0};
+	if (job->block_data == -1) {
+		num_blocks = (cache->num_blocks + SHEET_WIDTH_BLOCKS - 1) / SHEET_WIDTH_BLOCKS * SHEET_WIDTH_BLOCKS;
+		blocks = xmalloc(num_blocks);
+		for (int i = 0; i < num_blocks; i++) {
+			blocks[i] = (uint8_t)i;
+		}
+		width = SHEET_WIDTH_BLOCKS;
+	} else {
+		const struct BlockData *block_data = &renderer->data.block_data[job->block_data];
+		file = map_file(block_data->filename);
+		blocks = file.data;
+		num_blocks = (int)file.size;
+		width = renderer->data.maps[block_data->map].width;
+	}
+	int height = num_blocks / width;
+
+	uint8_t *image = xmalloc((size_t)width * height * BLOCK_BYTES + 1);
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			int i = y * width + x;
+			// Sheet padding past the last block is left blank
+			int block = job->block_data == -1 && i >= cache->num_blocks ? MAX_BLOCKS : blocks[i];
+			draw_block(image, width, x, y, cache, block);
+		}
+	}
+	unsigned int error = write_indexed_png(job->filename, image, width * BLOCK_PX, height * BLOCK_PX,
+		cache->colors);
+	if (error) {
+		error_exit("Could not write to file \"%s\": %s\n", job->filename, lodepng_error_text(error));
+	}
+
+	free(image);
+	if (job->block_data == -1) {
+		free(blocks);
+	} else {
+		unmap_file(&file);
+	}
+}
+
+int find_block_cache(struct Renderer *renderer, int tileset, const struct PaletteSource *palette) {
+	for (int i = 0; i < renderer->num_caches; i++) {
+		if (renderer->caches[i].tileset == tileset && renderer->caches[i].palette == palette) {
+			return i;
+		}
+	}
+	renderer->caches = xrealloc(renderer->caches, (renderer->num_caches + 1) * sizeof(*renderer->caches));
+	renderer->caches[renderer->num_caches] = (struct BlockCache){.tileset = tileset, .palette = palette};
+	return renderer->num_caches++;
+}
+
+void add_job(struct Renderer *renderer, int block_data, int tileset, const char *key, const char *filename) {
+	const struct PaletteSource *palette = NULL;
+	if (block_data != -1) {
+		palette = find_palette_source(map_palettes, COUNTOF(map_palettes), key);
+	}
+	if (!palette) {
+		palette = find_palette_source(tileset_palettes, COUNTOF(tileset_palettes), renderer->data.tilesets[tileset].name);
+	}
+	if (!palette) {
+		palette = &indoor_palette;
+	}
+	renderer->jobs = xrealloc(renderer->jobs, (renderer->num_jobs + 1) * sizeof(*renderer->jobs));
+	renderer->jobs[renderer->num_jobs++] = (struct RenderJob){
+		.block_data = block_data,
+		.tileset = tileset,
+		.cache = find_block_cache(renderer, tileset, palette),
+		.filename = output_path(renderer->options.outdir, filename),
+	};
+}
+
+bool is_selected(int argc, char *argv[], const char *tileset_name, const char *map_name) {
+	for (int i = 0; i < argc; i++) {
+		if (!strcmp(argv[i], tileset_name) || (map_name && !strcmp(argv[i], map_name))) {
+			return true;
+		}
+	}
+	return !argc;
+}
+
+void plan_jobs(struct Renderer *renderer, int argc, char *argv[]) {
+	// Every block data file is drawn once, with the width and tileset of the map that uses it
+	for (int i = 0; i < renderer->data.num_block_data; i++) {
+		struct BlockData *block_data = &renderer->data.block_data[i];
+		if (block_data->map == -1) {
+			continue;
+		}
+		int tileset = renderer->data.maps[block_data->map].tileset;
+		char *name = xstrdup(block_data->filename + strlen("maps/"));
+		*strrchr(name, '.') = '\0';
+		if (is_selected(argc, argv, renderer->data.tilesets[tileset].name, name)) {
+			char filename[0x100];
+			snprintf(filename, sizeof(filename), "maps/%s.png", name);
+			add_job(renderer, i, tileset, name, filename);
+		}
+		free(name);
+	}
+	if (!renderer->options.metatiles) {
+		return;
+	}
+	for (int t = 0; t < renderer->data.num_tilesets; t++) {
+		const struct Tileset *tileset = &renderer->data.tilesets[t];
+		if (is_selected(argc, argv, tileset->name, NULL)) {
+			char filename[0x100];
+			snprintf(filename, sizeof(filename), "data/tilesets/%s_metatiles.png", tileset->name);
+			add_job(renderer, -1, t, NULL, filename);
+		}
+	}
+}
+
+int main(int argc, char *argv[]) {
+	struct Renderer renderer = {0};
+	parse_args(argc, argv, &renderer.options);
+
+	argc -= optind;
+	argv += optind;
+
+	load_map_data(&renderer.data);
+	// Alternate block data has no map of its own; use the map it belongs to
+	for (int m = 0; m < renderer.data.num_maps; m++) {
+		int i = renderer.data.maps[m].block_data;
+		if (i != -1 && renderer.data.block_data[i].map == -1) {
+			renderer.data.block_data[i].map = m;
+		}
+	}
+	plan_jobs(&renderer, argc, argv);
+
+	for (int c = 0; c < renderer.num_caches; c++) {
+		const struct Tileset *tileset = &renderer.data.tilesets[renderer.caches[c].tileset];
+		for (int g = 0; g < NUM_GFX; g++) {
+			if (tileset->gfx[g].filename && find_gfx_file(&renderer, tileset->gfx[g].filename) == -1) {
+				renderer.gfx_files[renderer.num_gfx_files++] = tileset->gfx[g].filename;
+			}
+		}
+	}
+
+	int num_threads = parallel_num_threads(renderer.options.jobs);
+	parallel_for(renderer.num_gfx_files, num_threads, decode_gfx_file, &renderer);
+	parallel_for(renderer.num_caches, num_threads, build_block_cache, &renderer);
+	parallel_for(renderer.num_jobs, num_threads, render_job, &renderer);
+
+	for (int i = 0; i < renderer.num_jobs; i++) {
+		if (!renderer.options.quiet) {
+			printf("Exported %s\n", renderer.jobs[i].filename);
+		}
+		free(renderer.jobs[i].filename);
+	}
+	for (int i = 0; i < renderer.num_caches; i++) {
+		free(renderer.caches[i].blocks);
+	}
+	for (int i = 0; i < renderer.num_gfx_files; i++) {
+		free(renderer.gfx_tiles[i]);
+	}
+	free(renderer.caches);
+	free(renderer.jobs);
+	return 0;
+}
@@ -0,0 +1,280 @@
+#define PROGRAM_NAME "rom_diff"
+#define USAGE_OPTS "[-h|--help] [-q|--quiet] old.gbc old.symdb new.gbc new.symdb"
+
+#include "common.h"
+#include "mapdata.h"
+#include "parsemap.h"
+#include "symdb.h"
+
+#define BANK_SIZE 0x4000
+#define DIFF_BLOCK_SIZE 0x1000
+
+struct Options {
+	bool quiet;
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"quiet", no_argument, 0, 'q'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "qh", long_options)) != -1;) {
+		switch (opt) {
+		case 'q':
+			options->quiet = true;
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+// One linked build: its ROM and its symbol database
+struct Build {
+	struct MappedFile rom;
+	struct SymDB db;
+	const struct SymDBSection **sections; // ROM sections sorted by name, then by address
+	int num_sections;
+};
+
+size_t rom_offset(int bank, int address) {
+	return bank > 0 ? address + (bank - 1) * BANK_SIZE : address;
+}
+
+// The qsort comparators have no context argument
+static const struct SymDB *sort_db;
+
+int compare_section_names(const void *a, const void *b) {
+	const struct SymDBSection *x = *(const struct SymDBSection *const *)a, *y = *(const struct SymDBSection *const *)b;
+	int cmp = strcmp(symdb_name(sort_db, x->name), symdb_name(sort_db, y->name));
+	return cmp ? cmp : x->bank != y->bank ? x->bank - y->bank : x->address - y->address;
+}
+
+void load_build(struct Build *build, const char *rom_filename, const char *db_filename) {
+	build->rom = map_file(rom_filename);
+	symdb_load(&build->db, db_filename);
+	const struct SymDB *db = &build->db;
+	build->sections = xmalloc(db->header->num_sections * sizeof(*build->sections));
+	build->num_sections = 0;
+	for (uint32_t i = 0; i < db->header->num_sections; i++) {
+		const struct SymDBSection *section = &db->sections[i];
+		if (section->type == SECTION_ROM && section->length) {
+			if (rom_offset(section->bank, section->address) + section->length > build->rom.size) {
+				error_exit("%s: section \"%s\" is outside \"%s\"\n", db_filename, symdb_name(db, section->name), rom_filename);
+			}
+			build->sections[build->num_sections++] = section;
+		}
+	}
+	sort_db = db;
+	qsort(build->sections, build->num_sections, sizeof(*build->sections), compare_section_names);
+}
+
+void free_build(struct Build *build) {
+	free(build->sections);
+	symdb_free(&build->db);
+	unmap_file(&build->rom);
+}
+
+// Returns the first offset in [start, end) where the two spans differ, or `end` if there is none
+size_t find_difference(const uint8_t *a, const uint8_t *b, size_t start, size_t end) {
+	// memcmp skips equal blocks with vector compares; a differing block is halved until one byte is left
+	size_t block_size = DIFF_BLOCK_SIZE;
+	while (start < end) {
+		size_t size = end - start < block_size ? end - start : block_size;
+		if (!memcmp(&a[start], &b[start], size)) {
+			start += size;
+		} else if (size == 1) {
+			return start;
+		} else {
+			block_size = size / 2;
+		}
+	}
+	return end;
+}
+
+size_t find_same(const uint8_t *a, const uint8_t *b, size_t start, size_t end) {
+	while (start < end && a[start] != b[start]) {
+		start++;
+	}
+	return start;
+}
+
+struct Totals {
+	int unchanged, moved, modified, added, removed;
+	long old_size, new_size;
+	long changed_bytes; // within modified sections
+	long unattributed_bytes;
+};
+
+// Prints how many bytes changed in each symbol of a section, comparing it to its old copy
+long diff_section(const struct Build *old, const struct SymDBSection *old_section, const struct Build *new, const struct SymDBSection *new_section, bool quiet) {
+	const uint8_t *old_data = &old->rom.data[rom_offset(old_section->bank, old_section->address)];
+	const uint8_t *new_data = &new->rom.data[rom_offset(new_section->bank, new_section->address)];
+	size_t size = old_section->length < new_section->length ? old_section->length : new_section->length;
+	const struct SymDB *db = &new->db;
+
+	long total = 0;
+	const struct SymDBSymbol *current = NULL;
+	long current_bytes = 0;
+	for (size_t pos = 0; (pos = find_difference(old_data, new_data, pos, size)) < size;) {
+		size_t end = find_same(old_data, new_data, pos, size);
+		while (pos < end) {
+			// Split the changed range at symbol boundaries
+			uint32_t i = symdb_upper_bound(db, new_section->bank, new_section->address + pos);
+			const struct SymDBSymbol *symbol = i ? &db->symbols[i - 1] : NULL;
+			if (symbol && (symbol->bank != new_section->bank || symbol->address < new_section->address)) {
+				symbol = NULL; // before the section's first label
+			}
+			size_t symbol_end = end;
+			if (i < db->header->num_symbols && db->symbols[i].bank == new_section->bank
+				&& db->symbols[i].address < new_section->address + end) {
+				symbol_end = db->symbols[i].address - new_section->address;
+			}
+			if (symbol != current && current_bytes) {
+				if (!quiet) {
+					printf("    %s: %ld bytes\n", current ? symdb_name(db, current->name) : "(section start)", current_bytes);
+				}
+				current_bytes = 0;
+			}
+			current = symbol;
+			current_bytes += symbol_end - pos;
+			total += symbol_end - pos;
+			pos = symbol_end;
+		}
+	}
+	if (current_bytes && !quiet) {
+		printf("    %s: %ld bytes\n", current ? symdb_name(db, current->name) : "(section start)", current_bytes);
+	}
+	return total;
+}
+
+void print_location(const struct SymDBSection *section) {
+	printf("%02x:%04x", section->bank, section->address);
+}
+
+void diff_sections(const struct Build *old, const struct Build *new, struct Totals *totals, bool quiet) {
+	// Both section lists are sorted by name, so same-named sections pair up in one merge pass
+	int i = 0, j = 0;
+	while (i < old->num_sections || j < new->num_sections) {
+		int cmp = i == old->num_sections ? 1 : j == new->num_sections ? -1
+			: strcmp(symdb_name(&old->db, old->sections[i]->name), symdb_name(&new->db, new->sections[j]->name));
+		if (cmp < 0) {
+			const struct SymDBSection *old_section = old->sections[i++];
+			printf("removed  %s (", symdb_name(&old->db, old_section->name));
+			print_location(old_section);
+			printf(", %u bytes)\n", old_section->length);
+			totals->removed++;
+			totals->old_size += old_section->length;
+			continue;
+		}
+		if (cmp > 0) {
+			const struct SymDBSection *new_section = new->sections[j++];
+			printf("added    %s (", symdb_name(&new->db, new_section->name));
+			print_location(new_section);
+			printf(", %u bytes)\n", new_section->length);
+			totals->added++;
+			totals->new_size += new_section->length;
+			continue;
+		}
+		const struct SymDBSection *old_section = old->sections[i++];
+		const struct SymDBSection *new_section = new->sections[j++];
+		totals->old_size += old_section->length;
+		totals->new_size += new_section->length;
+		bool moved = old_section->bank != new_section->bank || old_section->address != new_section->address;
+		bool resized = old_section->length != new_section->length;
+		const uint8_t *old_data = &old->rom.data[rom_offset(old_section->bank, old_section->address)];
+		const uint8_t *new_data = &new->rom.data[rom_offset(new_section->bank, new_section->address)];
+		bool same = !resized && !memcmp(old_data, new_data, new_section->length);
+		if (same && !moved) {
+			totals->unchanged++;
+		} else {
+			printf("%s %s (", same ? "moved   " : "modified", symdb_name(&new->db, new_section->name));
+			if (moved) {
+				print_location(old_section);
+				printf(" -> ");
+			}
+			print_location(new_section);
+			if (resized) {
+				printf(", %u -> %u bytes)\n", old_section->length, new_section->length);
+			} else {
+				printf(", %u bytes)\n", new_section->length);
+			}
+			if (same) {
+				totals->moved++;
+			} else {
+				totals->modified++;
+				totals->changed_bytes += diff_section(old, old_section, new, new_section, quiet);
+			}
+		}
+	}
+}
+
+// Reports same-offset differences that no new ROM section covers, like the header checksum or filler
+void diff_unattributed(const struct Build *old, const struct Build *new, struct Totals *totals, bool quiet) {
+	size_t size = old->rom.size < new->rom.size ? old->rom.size : new->rom.size;
+	for (size_t pos = 0; (pos = find_difference(old->rom.data, new->rom.data, pos, size)) < size;) {
+		size_t end = find_same(old->rom.data, new->rom.data, pos, size);
+		for (size_t offset = pos; offset < end;) {
+			int bank = (int)(offset / BANK_SIZE);
+			int address = (int)(bank ? offset % BANK_SIZE + BANK_SIZE : offset);
+			const struct SymDBSection *section = symdb_find_section(&new->db, SECTION_ROM, bank, address);
+			size_t span_end = bank ? (size_t)(bank + 1) * BANK_SIZE : BANK_SIZE;
+			span_end = span_end < end ? span_end : end;
+			if (section) {
+				size_t section_end = rom_offset(section->bank, section->address) + section->length;
+				offset = section_end < span_end ? section_end : span_end;
+				continue;
+			}
+			// Stop at the next section start in this bank
+			size_t next = offset + 1;
+			while (next < span_end && !symdb_find_section(&new->db, SECTION_ROM, bank, address + (int)(next - offset))) {
+				next++;
+			}
+			if (!quiet) {
+				printf("unattributed %02x:%04x (%zu bytes)\n", bank, address, next - offset);
+			}
+			totals->unattributed_bytes += next - offset;
+			offset = next;
+		}
+		pos = end;
+	}
+	if (old->rom.size != new->rom.size) {
+		printf("ROM size: %zu -> %zu bytes\n", old->rom.size, new->rom.size);
+	}
+}
+
+int main(int argc, char *argv[]) {
+	struct Options options = {0};
+	parse_args(argc, argv, &options);
+
+	argc -= optind;
+	argv += optind;
+	if (argc != 4) {
+		usage_exit(1);
+	}
+
+	struct Build old, new;
+	load_build(&old, argv[0], argv[1]);
+	load_build(&new, argv[2], argv[3]);
+
+	struct Totals totals = {0};
+	diff_sections(&old, &new, &totals, options.quiet);
+	diff_unattributed(&old, &new, &totals, options.quiet);
+
+	printf("%d sections unchanged, %d moved, %d modified (%ld bytes), %d added, %d removed\n",
+		totals.unchanged, totals.moved, totals.modified, totals.changed_bytes, totals.added, totals.removed);
+	printf("ROM section bytes: %ld -> %ld (%+ld)\n", totals.old_size, totals.new_size, totals.new_size - totals.old_size);
+	if (totals.unattributed_bytes) {
+		printf("%ld changed bytes outside any section\n", totals.unattributed_bytes);
+	}
+
+	bool differ = old.rom.size != new.rom.size || memcmp(old.rom.data, new.rom.data, old.rom.size);
+	free_build(&old);
+	free_build(&new);
+	// Like cmp, exit with 1 if the ROMs differ
+	return differ;
+}
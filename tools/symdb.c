@@ -0,0 +1,232 @@
+#define PROGRAM_NAME "symdb"
+#define USAGE_OPTS "[-h|--help] -o|--output out.symdb values.sym [layout.map]"
+
+#include "common.h"
+#include "mapdata.h"
+#include "parsemap.h"
+#include "symdb.h"
+
+struct Options {
+	const char *output;
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"output", required_argument, 0, 'o'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "o:h", long_options)) != -1;) {
+		switch (opt) {
+		case 'o':
+			options->output = optarg;
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+struct Symbol {
+	uint32_t name; // offset into the strings
+	int bank;
+	int address;
+	int order; // line order in the .sym file
+};
+
+struct Strings {
+	char *data;
+	uint32_t size;
+	uint32_t capacity;
+};
+
+uint32_t add_string(struct Strings *strings, const char *s) {
+	uint32_t len = strlen(s) + 1;
+	if (strings->size + len > strings->capacity) {
+		strings->capacity = (strings->size + len) * 2;
+		strings->data = xrealloc(strings->data, strings->capacity);
+	}
+	uint32_t offset = strings->size;
+	memcpy(&strings->data[offset], s, len);
+	strings->size += len;
+	return offset;
+}
+
+int parse_hex(const char *s, const char *filename, int line_num) {
+	char *end;
+	long n = strtol(s, &end, 16);
+	if (end == s || *end || n < 0 || n > 0xffff) {
+		error_exit("%s:%d: invalid symbol value: \"%s\"\n", filename, line_num, s);
+	}
+	return (int)n;
+}
+
+// Reads "bank:address Name" lines, like rgblink writes them
+struct Symbol *read_symbols(const char *filename, struct Strings *strings, int *num_symbols) {
+	char *text = read_text(filename);
+	struct Symbol *symbols = NULL;
+	int count = 0;
+	int line_num = 0;
+	for (char *rest = text, *line; (line = next_line(&rest));) {
+		line_num++;
+		char *value = line + strspn(line, " \t");
+		char *name = value + strcspn(value, " \t");
+		if (!*name) {
+			continue;
+		}
+		*name++ = '\0';
+		name += strspn(name, " \t");
+		name[strcspn(name, " \t")] = '\0';
+		if (!*name) {
+			continue;
+		}
+		char *colon = strchr(value, ':');
+		int bank = 0;
+		if (colon) {
+			*colon++ = '\0';
+			bank = parse_hex(value, filename, line_num);
+			value = colon;
+		}
+		symbols = xrealloc(symbols, (count + 1) * sizeof(*symbols));
+		symbols[count] = (struct Symbol){add_string(strings, name), bank, parse_hex(value, filename, line_num), count};
+		count++;
+	}
+	free(text);
+	*num_symbols = count;
+	return symbols;
+}
+
+int compare_symbols(const void *a, const void *b) {
+	const struct Symbol *x = a, *y = b;
+	return x->bank != y->bank ? x->bank - y->bank : x->address != y->address ? x->address - y->address : x->order - y->order;
+}
+
+uint32_t hash_capacity(int count) {
+	uint32_t capacity = 0x10;
+	while (capacity < (uint32_t)count * 2) {
+		capacity *= 2;
+	}
+	return capacity;
+}
+
+void add_slot(struct SymDBSlot *slots, uint32_t capacity, const struct Strings *strings, uint32_t key, uint32_t symbol) {
+	uint32_t mask = capacity - 1;
+	for (uint32_t i = symdb_hash(&strings->data[key]) & mask;; i = (i + 1) & mask) {
+		if (!slots[i].symbol) {
+			slots[i] = (struct SymDBSlot){symbol + 1, key};
+			return;
+		}
+		if (!strcmp(&strings->data[slots[i].key], &strings->data[key])) {
+			// Symbols are added from last to first defined, and the last one wins
+			return;
+		}
+	}
+}
+
+int main(int argc, char *argv[]) {
+	struct Options options = {0};
+	parse_args(argc, argv, &options);
+
+	argc -= optind;
+	argv += optind;
+	if (!options.output || argc < 1 || argc > 2) {
+		usage_exit(1);
+	}
+
+	struct Strings strings = {0};
+	int num_symbols;
+	struct Symbol *symbols = read_symbols(argv[0], &strings, &num_symbols);
+
+	MapSection *map_sections = NULL;
+	int num_sections = 0;
+	if (argc > 1) {
+		map_sections = get_sections_from_map_file(argv[1]);
+		if (!map_sections) {
+			error_exit("Could not read sections from \"%s\"\n", argv[1]);
+		}
+		while (map_sections[num_sections].type) {
+			num_sections++;
+		}
+	}
+	struct SymDBSection *sections = xcalloc(num_sections * sizeof(*sections));
+	for (int i = 0; i < num_sections; i++) {
+		const MapSection *section = &map_sections[i];
+		sections[i] = (struct SymDBSection){
+			.name = add_string(&strings, section->name ? section->name : ""),
+			.type = section->type,
+			.flags = section->flags,
+			.bank = section->bank,
+			.address = section->address,
+			.length = section->length,
+		};
+	}
+	if (map_sections) {
+		destroy_section_array(map_sections);
+	}
+
+	// The address index is the symbols themselves, sorted by bank and address
+	qsort(symbols, num_symbols, sizeof(*symbols), compare_symbols);
+	int *by_order = xmalloc(num_symbols * sizeof(*by_order));
+	int num_locals = 0;
+	for (int i = 0; i < num_symbols; i++) {
+		by_order[symbols[i].order] = i;
+		for (const char *dot = strchr(&strings.data[symbols[i].name], '.'); dot; dot = strchr(dot + 1, '.')) {
+			num_locals++;
+		}
+	}
+
+	uint32_t names_capacity = hash_capacity(num_symbols);
+	uint32_t locals_capacity = hash_capacity(num_locals);
+	struct SymDBSlot *names = xcalloc(names_capacity * sizeof(*names));
+	struct SymDBSlot *locals = xcalloc(locals_capacity * sizeof(*locals));
+	for (int order = num_symbols - 1; order >= 0; order--) {
+		int i = by_order[order];
+		uint32_t name = symbols[i].name;
+		add_slot(names, names_capacity, &strings, name, i);
+		for (const char *dot = strchr(&strings.data[name], '.'); dot; dot = strchr(dot + 1, '.')) {
+			add_slot(locals, locals_capacity, &strings, name + (dot - &strings.data[name]), i);
+		}
+	}
+
+	struct SymDBSymbol *db_symbols = xmalloc(num_symbols * sizeof(*db_symbols));
+	for (int i = 0; i < num_symbols; i++) {
+		db_symbols[i] = (struct SymDBSymbol){symbols[i].name, symbols[i].bank, symbols[i].address};
+	}
+
+	struct SymDBHeader header = {
+		.magic = SYMDB_MAGIC,
+		.version = SYMDB_VERSION,
+		.num_symbols = num_symbols,
+		.num_sections = num_sections,
+		.names_capacity = names_capacity,
+		.locals_capacity = locals_capacity,
+	};
+	header.symbols_offset = sizeof(header);
+	header.names_offset = header.symbols_offset + num_symbols * sizeof(*db_symbols);
+	header.locals_offset = header.names_offset + names_capacity * sizeof(*names);
+	header.sections_offset = header.locals_offset + locals_capacity * sizeof(*locals);
+	header.strings_offset = header.sections_offset + num_sections * sizeof(*sections);
+	header.strings_size = strings.size;
+
+	// Every record size is a multiple of 4, so each part stays aligned when mapped
+	FILE *f = xfopen(options.output, 'w');
+	xfwrite((const uint8_t *)&header, sizeof(header), options.output, f);
+	xfwrite((const uint8_t *)db_symbols, num_symbols * sizeof(*db_symbols), options.output, f);
+	xfwrite((const uint8_t *)names, names_capacity * sizeof(*names), options.output, f);
+	xfwrite((const uint8_t *)locals, locals_capacity * sizeof(*locals), options.output, f);
+	xfwrite((const uint8_t *)sections, num_sections * sizeof(*sections), options.output, f);
+	xfwrite((const uint8_t *)strings.data, strings.size, options.output, f);
+	fclose(f);
+
+	free(db_symbols);
+	free(names);
+	free(locals);
+	free(by_order);
+	free(sections);
+	free(symbols);
+	free(strings.data);
+	return 0;
+}
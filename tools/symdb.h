@@ -0,0 +1,214 @@
+#ifndef GUARD_SYMDB_H
+#define GUARD_SYMDB_H
+
+// Include common.h and mapdata.h before this header
+
+// A symbol database, as written by tools/symdb from a linked ROM's .sym and .map files.
+// It is memory-mapped as-is, so it uses the native byte order; the magic number catches a mismatch.
+// Layout: header, symbols sorted by bank and address, name and local-label hash slots,
+// sections sorted by type, bank, and address, then NUL-terminated names.
+
+#define SYMDB_MAGIC 0x42445953 // "SYDB"
+#define SYMDB_VERSION 1
+
+struct SymDBHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t num_symbols;
+	uint32_t num_sections;
+	uint32_t names_capacity; // a power of two
+	uint32_t locals_capacity; // a power of two
+	uint32_t symbols_offset;
+	uint32_t names_offset;
+	uint32_t locals_offset;
+	uint32_t sections_offset;
+	uint32_t strings_offset;
+	uint32_t strings_size;
+};
+
+struct SymDBSymbol {
+	uint32_t name; // offset into the strings
+	uint16_t bank;
+	uint16_t address;
+};
+
+struct SymDBSlot {
+	uint32_t symbol; // symbol index + 1, or 0 for an empty slot
+	uint32_t key; // offset into the strings: a whole name, or the ".local" suffix of one
+};
+
+struct SymDBSection {
+	uint32_t name; // offset into the strings
+	uint8_t type; // a SECTION_* value from parsemap.h
+	uint8_t flags;
+	uint16_t bank;
+	uint16_t address;
+	uint16_t length;
+};
+
+struct SymDB {
+	struct MappedFile file;
+	const struct SymDBHeader *header;
+	const struct SymDBSymbol *symbols;
+	const struct SymDBSlot *names;
+	const struct SymDBSlot *locals;
+	const struct SymDBSection *sections;
+	const char *strings;
+};
+
+uint32_t symdb_hash(const char *name) {
+	uint32_t hash = 2166136261u; // FNV-1a
+	for (; *name; name++) {
+		hash = (hash ^ (uint8_t)*name) * 16777619u;
+	}
+	return hash;
+}
+
+// Checks that `count` records of `size` bytes at `offset` lie within the file and are 4-byte aligned
+bool symdb_part_fits(const struct MappedFile *file, uint32_t offset, uint32_t count, size_t size) {
+	return offset % 4 == 0 && offset <= file->size && count <= (file->size - offset) / size;
+}
+
+bool is_power_of_two(uint32_t n) {
+	return n && !(n & (n - 1));
+}
+
+// Checks that each used slot points inside the database, and that a probe always ends at an empty slot
+bool symdb_slots_valid(const struct SymDBSlot *slots, uint32_t capacity, const struct SymDBHeader *header) {
+	bool has_empty = false;
+	for (uint32_t i = 0; i < capacity; i++) {
+		if (!slots[i].symbol) {
+			has_empty = true;
+		} else if (slots[i].symbol > header->num_symbols || slots[i].key >= header->strings_size) {
+			return false;
+		}
+	}
+	return has_empty;
+}
+
+// Checks that every name offset and slot index points inside the database
+bool symdb_records_valid(const struct MappedFile *file, const struct SymDBHeader *header) {
+	const char *strings = (const char *)&file->data[header->strings_offset];
+	if (header->strings_size && strings[header->strings_size - 1]) {
+		return false;
+	}
+	const struct SymDBSymbol *symbols = (const struct SymDBSymbol *)&file->data[header->symbols_offset];
+	for (uint32_t i = 0; i < header->num_symbols; i++) {
+		if (symbols[i].name >= header->strings_size) {
+			return false;
+		}
+	}
+	const struct SymDBSection *sections = (const struct SymDBSection *)&file->data[header->sections_offset];
+	for (uint32_t i = 0; i < header->num_sections; i++) {
+		if (sections[i].name >= header->strings_size) {
+			return false;
+		}
+	}
+	return symdb_slots_valid((const struct SymDBSlot *)&file->data[header->names_offset], header->names_capacity, header)
+		&& symdb_slots_valid((const struct SymDBSlot *)&file->data[header->locals_offset], header->locals_capacity, header);
+}
+
+void symdb_load(struct SymDB *db, const char *filename) {
+	db->file = map_file(filename);
+	const struct SymDBHeader *header = (const struct SymDBHeader *)db->file.data;
+	if (db->file.size < sizeof(*header) || header->magic != SYMDB_MAGIC) {
+		error_exit("%s: not a symbol database\n", filename);
+	}
+	if (header->version != SYMDB_VERSION) {
+		error_exit("%s: unsupported symbol database version %" PRIu32 "\n", filename, header->version);
+	}
+	if (!symdb_part_fits(&db->file, header->symbols_offset, header->num_symbols, sizeof(struct SymDBSymbol))
+		|| !symdb_part_fits(&db->file, header->names_offset, header->names_capacity, sizeof(struct SymDBSlot))
+		|| !symdb_part_fits(&db->file, header->locals_offset, header->locals_capacity, sizeof(struct SymDBSlot))
+		|| !symdb_part_fits(&db->file, header->sections_offset, header->num_sections, sizeof(struct SymDBSection))
+		|| !symdb_part_fits(&db->file, header->strings_offset, header->strings_size, 1)) {
+		error_exit("%s: truncated symbol database\n", filename);
+	}
+	if (!is_power_of_two(header->names_capacity) || !is_power_of_two(header->locals_capacity)
+		|| !symdb_records_valid(&db->file, header)) {
+		error_exit("%s: corrupt symbol database\n", filename);
+	}
+	db->header = header;
+	db->symbols = (const struct SymDBSymbol *)&db->file.data[header->symbols_offset];
+	db->names = (const struct SymDBSlot *)&db->file.data[header->names_offset];
+	db->locals = (const struct SymDBSlot *)&db->file.data[header->locals_offset];
+	db->sections = (const struct SymDBSection *)&db->file.data[header->sections_offset];
+	db->strings = (const char *)&db->file.data[header->strings_offset];
+}
+
+void symdb_free(struct SymDB *db) {
+	unmap_file(&db->file);
+	db->header = NULL;
+}
+
+bool is_symdb_file(const char *filename) {
+	FILE *f = xfopen(filename, 'r');
+	uint32_t magic = 0;
+	bool result = fread(&magic, sizeof(magic), 1, f) == 1 && magic == SYMDB_MAGIC;
+	fclose(f);
+	return result;
+}
+
+const char *symdb_name(const struct SymDB *db, uint32_t name) {
+	return &db->strings[name];
+}
+
+// Returns the symbol named `name`, or NULL; a local label like ".foo" matches any "Parent.foo".
+// When several symbols match, the one defined last in the .sym file wins.
+const struct SymDBSymbol *symdb_find(const struct SymDB *db, const char *name) {
+	bool local = name[0] == '.';
+	const struct SymDBSlot *slots = local ? db->locals : db->names;
+	uint32_t mask = (local ? db->header->locals_capacity : db->header->names_capacity) - 1;
+	for (uint32_t i = symdb_hash(name) & mask; slots[i].symbol; i = (i + 1) & mask) {
+		if (!strcmp(symdb_name(db, slots[i].key), name)) {
+			return &db->symbols[slots[i].symbol - 1];
+		}
+	}
+	return NULL;
+}
+
+// Returns the index of the first symbol after bank:address, or num_symbols
+uint32_t symdb_upper_bound(const struct SymDB *db, int bank, int address) {
+	uint32_t lo = 0, hi = db->header->num_symbols;
+	while (lo < hi) {
+		uint32_t mid = lo + (hi - lo) / 2;
+		const struct SymDBSymbol *symbol = &db->symbols[mid];
+		if (symbol->bank < bank || (symbol->bank == bank && symbol->address <= address)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+// Returns the last symbol at or before bank:address in the same bank, or NULL
+const struct SymDBSymbol *symdb_find_address(const struct SymDB *db, int bank, int address) {
+	uint32_t i = symdb_upper_bound(db, bank, address);
+	return i && db->symbols[i - 1].bank == bank ? &db->symbols[i - 1] : NULL;
+}
+
+// Returns the section of the given type containing bank:address, or NULL
+const struct SymDBSection *symdb_find_section(const struct SymDB *db, int type, int bank, int address) {
+	uint32_t lo = 0, hi = db->header->num_sections;
+	while (lo < hi) {
+		uint32_t mid = lo + (hi - lo) / 2;
+		const struct SymDBSection *section = &db->sections[mid];
+		if (section->type < type || (section->type == type && (section->bank < bank
+			|| (section->bank == bank && section->address <= address)))) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	// Sections do not overlap, so only the last one starting at or before the address can contain it
+	if (lo) {
+		const struct SymDBSection *section = &db->sections[lo - 1];
+		if (section->type == type && section->bank == bank && address < section->address + section->length) {
+			return section;
+		}
+	}
+	return NULL;
+}
+
+#endif // GUARD_SYMDB_H
@@ -0,0 +1,78 @@
+#ifndef GUARD_TILEPNG_H
+#define GUARD_TILEPNG_H
+
+// Include common.h before this header, and link with lodepng/lodepng.c
+
+#include "lodepng/lodepng.h"
+
+#define TILE_SIZE 16 // 8x8-px 2bpp tile
+
+#define PNG_WIDTH_TILES 16
+
+// Reads 2bpp tiles from a grayscale .png, like "rgbgfx -c dmg=e4"
+uint8_t *read_png_tiles(const char *filename, int *num_tiles) {
+	unsigned char *image;
+	unsigned int width, height;
+	unsigned int error = lodepng_decode_file(&image, &width, &height, filename, LCT_GREY, 8);
+	if (error) {
+		error_exit("Could not read \"%s\": %s\n", filename, lodepng_error_text(error));
+	}
+	if (width % 8 || height % 8) {
+		error_exit("%s: not divisible into 8x8-px tiles\n", filename);
+	}
+	int cols = width / 8;
+	*num_tiles = cols * (height / 8);
+	uint8_t *tiles = xcalloc(*num_tiles * TILE_SIZE);
+	for (int t = 0; t < *num_tiles; t++) {
+		for (int y = 0; y < 8; y++) {
+			const unsigned char *row = &image[((t / cols) * 8 + y) * width + (t % cols) * 8];
+			for (int x = 0; x < 8; x++) {
+				int color = 3 - (row[x] >> 6);
+				tiles[t * TILE_SIZE + y * 2] |= (color & 1) << (7 - x);
+				tiles[t * TILE_SIZE + y * 2 + 1] |= (color >> 1) << (7 - x);
+			}
+		}
+	}
+	free(image);
+	return tiles;
+}
+
+void write_png_tiles(const char *filename, const uint8_t *tiles, int num_tiles) {
+	unsigned int width = PNG_WIDTH_TILES * 8;
+	unsigned int height = (num_tiles + PNG_WIDTH_TILES - 1) / PNG_WIDTH_TILES * 8;
+	unsigned char *image = xmalloc(width * height);
+	memset(image, 0xff, width * height); // pad with white
+	for (int t = 0; t < num_tiles; t++) {
+		for (int y = 0; y < 8; y++) {
+			unsigned char *row = &image[((t / PNG_WIDTH_TILES) * 8 + y) * width + (t % PNG_WIDTH_TILES) * 8];
+			uint8_t lo = tiles[t * TILE_SIZE + y * 2], hi = tiles[t * TILE_SIZE + y * 2 + 1];
+			for (int x = 0; x < 8; x++) {
+				int color = ((lo >> (7 - x)) & 1) | (((hi >> (7 - x)) & 1) << 1);
+				row[x] = (unsigned char)((3 - color) * 0x55);
+			}
+		}
+	}
+
+	LodePNGState state;
+	lodepng_state_init(&state);
+	state.encoder.auto_convert = 0;
+	state.info_raw.colortype = LCT_GREY;
+	state.info_raw.bitdepth = 8;
+	state.info_png.color.colortype = LCT_GREY;
+	state.info_png.color.bitdepth = 2;
+	unsigned char *buffer;
+	size_t buffer_size;
+	lodepng_encode(&buffer, &buffer_size, image, width, height, &state);
+	unsigned int error = state.error;
+	lodepng_state_cleanup(&state);
+	if (!error) {
+		error = lodepng_save_file(buffer, buffer_size, filename);
+	}
+	if (error) {
+		error_exit("Could not write to file \"%s\": %s\n", filename, lodepng_error_text(error));
+	}
+	free(buffer);
+	free(image);
+}
+
+#endif // GUARD_TILEPNG_H
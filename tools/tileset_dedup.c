@@ -0,0 +1,459 @@
+#define PROGRAM_NAME "tileset_dedup"
+#define USAGE_OPTS "[-h|--help] [-f|--flips] [-n|--min-owners n] [-o|--output shared.2bpp] [-t|--layout layout.txt]"
+
+#include "common.h"
+#include "mapdata.h"
+#include "tilepng.h"
+
+struct Options {
+	bool flips;
+	int min_owners;
+	const char *out_filename;
+	const char *layout_filename;
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"flips", no_argument, 0, 'f'},
+		{"min-owners", required_argument, 0, 'n'},
+		{"output", required_argument, 0, 'o'},
+		{"layout", required_argument, 0, 't'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "fn:o:t:h", long_options)) != -1;) {
+		switch (opt) {
+		case 'f':
+			options->flips = true;
+			break;
+		case 'n':
+			options->min_owners = (int)strtoul(optarg, NULL, 0);
+			if (options->min_owners < 2) {
+				error_exit("Shared content needs at least 2 owners: %s\n", optarg);
+			}
+			break;
+		case 'o':
+			options->out_filename = optarg;
+			break;
+		case 't':
+			options->layout_filename = optarg;
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+#define MAX_OWNERS 0x100
+#define OWNER_BYTES (MAX_OWNERS / 8)
+
+// One distinct tile or metatile; "owners" are the files that store a copy
+struct Entry {
+	uint64_t hash;
+	int key_offset; // into the table's key storage
+	int first_owner;
+	int first_index;
+	int copies;
+	int num_owners;
+	uint8_t owners[OWNER_BYTES];
+};
+
+// Open-addressed table of distinct keys, in order of first appearance
+struct Table {
+	int key_size;
+	uint8_t *keys;
+	struct Entry *entries;
+	int num_entries;
+	int *buckets; // entry index + 1, or 0 if empty
+	int num_buckets;
+};
+
+uint64_t hash_bytes(const uint8_t *data, size_t size) {
+	// FNV-1a
+	uint64_t hash = 0xcbf29ce484222325;
+	for (size_t i = 0; i < size; i++) {
+		hash = (hash ^ data[i]) * 0x100000001b3;
+	}
+	return hash;
+}
+
+void table_init(struct Table *table, int key_size) {
+	memset(table, 0, sizeof(*table));
+	table->key_size = key_size;
+	table->num_buckets = 0x400;
+	table->buckets = xcalloc(table->num_buckets * sizeof(*table->buckets));
+}
+
+void table_free(struct Table *table) {
+	free(table->keys);
+	free(table->entries);
+	free(table->buckets);
+}
+
+void table_grow(struct Table *table) {
+	free(table->buckets);
+	table->num_buckets *= 2;
+	table->buckets = xcalloc(table->num_buckets * sizeof(*table->buckets));
+	for (int i = 0; i < table->num_entries; i++) {
+		int b = (int)(table->entries[i].hash & (table->num_buckets - 1));
+		while (table->buckets[b]) {
+			b = (b + 1) & (table->num_buckets - 1);
+		}
+		table->buckets[b] = i + 1;
+	}
+}
+
+// Finds or adds the entry for key, and records that owner stores a copy of it
+int table_add(struct Table *table, const uint8_t *key, int owner, int index) {
+	uint64_t hash = hash_bytes(key, table->key_size);
+	int b = (int)(hash & (table->num_buckets - 1));
+	for (; table->buckets[b]; b = (b + 1) & (table->num_buckets - 1)) {
+		struct Entry *entry = &table->entries[table->buckets[b] - 1];
+		if (entry->hash == hash && !memcmp(&table->keys[entry->key_offset], key, table->key_size)) {
+			entry->copies++;
+			if (!BIT_TEST(entry->owners, owner)) {
+				BIT_SET(entry->owners, owner);
+				entry->num_owners++;
+			}
+			return table->buckets[b] - 1;
+		}
+	}
+
+	int i = table->num_entries++;
+	table->entries = xrealloc(table->entries, table->num_entries * sizeof(*table->entries));
+	table->keys = xrealloc(table->keys, (size_t)table->num_entries * table->key_size);
+	memcpy(&table->keys[(size_t)i * table->key_size], key, table->key_size);
+	struct Entry *entry = &table->entries[i];
+	memset(entry, 0, sizeof(*entry));
+	entry->hash = hash;
+	entry->key_offset = i * table->key_size;
+	entry->first_owner = owner;
+	entry->first_index = index;
+	entry->copies = 1;
+	entry->num_owners = 1;
+	BIT_SET(entry->owners, owner);
+	table->buckets[b] = i + 1;
+	// Keep the load factor under 1/2
+	if (table->num_entries * 2 > table->num_buckets) {
+		table_grow(table);
+	}
+	return i;
+}
+
+void flip_tile(const uint8_t *tile, uint8_t *flipped, bool xflip, bool yflip) {
+	for (int y = 0; y < 8; y++) {
+		int src = yflip ? 7 - y : y;
+		for (int plane = 0; plane < 2; plane++) {
+			uint8_t bits = tile[src * 2 + plane];
+			uint8_t reversed = 0;
+			for (int x = 0; x < 8; x++) {
+				reversed |= ((bits >> x) & 1) << (7 - x);
+			}
+			flipped[y * 2 + plane] = xflip ? reversed : bits;
+		}
+	}
+}
+
+// With --flips, a tile and its mirror images count as one, since attributes can flip them;
+// returns the flips that turn the tile into its key (bit 0 = x, bit 1 = y)
+int canonical_tile(const uint8_t *tile, uint8_t *key, bool flips) {
+	memcpy(key, tile, TILE_SIZE);
+	int orientation = 0;
+	for (int f = 1; flips && f < 4; f++) {
+		uint8_t flipped[TILE_SIZE];
+		flip_tile(tile, flipped, f & 1, f & 2);
+		if (memcmp(flipped, key, TILE_SIZE) < 0) {
+			memcpy(key, flipped, TILE_SIZE);
+			orientation = f;
+		}
+	}
+	return orientation;
+}
+
+struct Dedup {
+	struct MapData data;
+	struct Options options;
+	// Tile owners are graphics files
+	const char *gfx_files[MAX_OWNERS];
+	uint8_t *gfx_tiles[MAX_OWNERS];
+	int gfx_num_tiles[MAX_OWNERS];
+	int *gfx_entries[MAX_OWNERS]; // tile table entry of each tile
+	uint8_t *gfx_orientations[MAX_OWNERS]; // flips from each tile to its entry
+	int num_gfx_files;
+	// Metatile owners are metatiles files, named after their first tileset
+	const struct Tileset *meta_owners[MAX_OWNERS];
+	int num_meta_owners;
+	struct Table tiles;
+	struct Table metatiles;
+};
+
+int find_gfx_file(const struct Dedup *dedup, const char *filename) {
+	for (int i = 0; i < dedup->num_gfx_files; i++) {
+		if (!strcmp(dedup->gfx_files[i], filename)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void hash_tiles(struct Dedup *dedup) {
+	for (int t = 0; t < dedup->data.num_tilesets; t++) {
+		for (int g = 0; g < NUM_GFX; g++) {
+			const char *filename = dedup->data.tilesets[t].gfx[g].filename;
+			if (!filename || find_gfx_file(dedup, filename) != -1) {
+				continue;
+			}
+			if (dedup->num_gfx_files == MAX_OWNERS) {
+				error_exit("Too many tileset graphics files\n");
+			}
+			int f = dedup->num_gfx_files++;
+			dedup->gfx_files[f] = filename;
+			char *png_filename = replace_extension(filename, ".2bpp", ".png");
+			dedup->gfx_tiles[f] = read_png_tiles(png_filename, &dedup->gfx_num_tiles[f]);
+			free(png_filename);
+
+			dedup->gfx_entries[f] = xmalloc(dedup->gfx_num_tiles[f] * sizeof(int));
+			dedup->gfx_orientations[f] = xmalloc(dedup->gfx_num_tiles[f]);
+			for (int i = 0; i < dedup->gfx_num_tiles[f]; i++) {
+				uint8_t key[TILE_SIZE];
+				dedup->gfx_orientations[f][i] = (uint8_t)canonical_tile(&dedup->gfx_tiles[f][i * TILE_SIZE], key, dedup->options.flips);
+				dedup->gfx_entries[f][i] = table_add(&dedup->tiles, key, f, i);
+			}
+		}
+	}
+}
+
+// Metatiles are compared by content: which distinct tile each position shows, and its attributes
+struct MetatileKey {
+	int32_t tiles[METATILE_SIZE];
+	uint8_t attributes[METATILE_SIZE];
+};
+
+void hash_metatiles(struct Dedup *dedup) {
+	for (int t = 0; t < dedup->data.num_tilesets; t++) {
+		const struct Tileset *tileset = &dedup->data.tilesets[t];
+		bool seen = false;
+		for (int i = 0; i < dedup->num_meta_owners; i++) {
+			seen |= !strcmp(dedup->meta_owners[i]->metatiles_filename, tileset->metatiles_filename);
+		}
+		if (seen) {
+			continue;
+		}
+		if (dedup->num_meta_owners == MAX_OWNERS) {
+			error_exit("Too many tileset metatiles files\n");
+		}
+		int owner = dedup->num_meta_owners++;
+		dedup->meta_owners[owner] = tileset;
+
+		struct MappedFile metatiles = map_file(tileset->metatiles_filename);
+		struct MappedFile attributes = map_file(tileset->attributes_filename);
+		if (metatiles.size % METATILE_SIZE || metatiles.size != attributes.size) {
+			error_exit("%s: metatiles and attributes do not match\n", tileset->name);
+		}
+		for (int b = 0; b < (int)(metatiles.size / METATILE_SIZE); b++) {
+			struct MetatileKey key;
+			memset(&key, 0, sizeof(key));
+			for (int i = 0; i < METATILE_SIZE; i++) {
+				uint8_t attr = attributes.data[b * METATILE_SIZE + i];
+				int slot = VRAM_SLOT(metatiles.data[b * METATILE_SIZE + i], attr);
+				// Slots outside the tileset's graphics (such as roof tiles) are compared by number
+				key.tiles[i] = -1 - slot;
+				key.attributes[i] = attr & ~ATTR_BANK1;
+				for (int g = 0; g < NUM_GFX; g++) {
+					const struct TilesetGFX *gfx = &tileset->gfx[g];
+					int tile = gfx->first_tile + slot - gfx_group_slots[g];
+					if (gfx->filename && slot >= gfx_group_slots[g] && slot < gfx_group_slots[g] + GFX_GROUP_TILES) {
+						int f = find_gfx_file(dedup, gfx->filename);
+						if (tile < dedup->gfx_num_tiles[f]) {
+							key.tiles[i] = dedup->gfx_entries[f][tile];
+							int orientation = dedup->gfx_orientations[f][tile];
+							key.attributes[i] ^= (orientation & 1 ? ATTR_XFLIP : 0) | (orientation & 2 ? ATTR_YFLIP : 0);
+						}
+					}
+				}
+			}
+			table_add(&dedup->metatiles, (const uint8_t *)&key, owner, b);
+		}
+		unmap_file(&metatiles);
+		unmap_file(&attributes);
+	}
+}
+
+// A cluster is every entry with the same set of owners
+struct Cluster {
+	const uint8_t *owners;
+	int num_owners;
+	int num_entries;
+	long saved_bytes;
+};
+
+int compare_clusters(const void *a, const void *b) {
+	const struct Cluster *x = a, *y = b;
+	if (x->saved_bytes != y->saved_bytes) {
+		return x->saved_bytes < y->saved_bytes ? 1 : -1;
+	}
+	return memcmp(x->owners, y->owners, OWNER_BYTES);
+}
+
+// Prints clusters of shared entries, largest savings first; returns the total savings
+long print_clusters(const struct Dedup *dedup, const struct Table *table, const char *kind, int entry_bytes,
+	const char *(*owner_name)(const struct Dedup *, int)) {
+	struct Cluster *clusters = xmalloc((table->num_entries + 1) * sizeof(*clusters));
+	int num_clusters = 0;
+	long duplicate_bytes = 0, total_bytes = 0;
+	int shared_entries = 0;
+	for (int i = 0; i < table->num_entries; i++) {
+		const struct Entry *entry = &table->entries[i];
+		total_bytes += (long)entry->copies * entry_bytes;
+		duplicate_bytes += (long)(entry->copies - 1) * entry_bytes;
+		if (entry->num_owners < dedup->options.min_owners) {
+			continue;
+		}
+		shared_entries++;
+		int c = 0;
+		while (c < num_clusters && memcmp(clusters[c].owners, entry->owners, OWNER_BYTES)) {
+			c++;
+		}
+		if (c == num_clusters) {
+			clusters[num_clusters++] = (struct Cluster){.owners = entry->owners, .num_owners = entry->num_owners};
+		}
+		clusters[c].num_entries++;
+		clusters[c].saved_bytes += (long)(entry->num_owners - 1) * entry_bytes;
+	}
+	qsort(clusters, num_clusters, sizeof(*clusters), compare_clusters);
+
+	printf("%s: %ld bytes stored, %d distinct, %d shared by %d+ files, %ld duplicate bytes\n",
+		kind, total_bytes, table->num_entries, shared_entries, dedup->options.min_owners, duplicate_bytes);
+	long saved_bytes = 0;
+	for (int c = 0; c < num_clusters; c++) {
+		printf("\t%d %s, %ld bytes:", clusters[c].num_entries, kind, clusters[c].saved_bytes);
+		for (int i = 0; i < MAX_OWNERS; i++) {
+			if (BIT_TEST(clusters[c].owners, i)) {
+				printf(" %s", owner_name(dedup, i));
+			}
+		}
+		putchar('\n');
+		saved_bytes += clusters[c].saved_bytes;
+	}
+	printf("\tsharable = %ld bytes\n\n", saved_bytes);
+	free(clusters);
+	return saved_bytes;
+}
+
+const char *gfx_owner_name(const struct Dedup *dedup, int owner) {
+	const char *name = strrchr(dedup->gfx_files[owner], '/');
+	return name ? name + 1 : dedup->gfx_files[owner];
+}
+
+const char *meta_owner_name(const struct Dedup *dedup, int owner) {
+	return dedup->meta_owners[owner]->name;
+}
+
+int compare_shared_entries(const void *a, const void *b) {
+	const struct Entry *x = *(const struct Entry *const *)a, *y = *(const struct Entry *const *)b;
+	if (x->num_owners != y->num_owners) {
+		return y->num_owners - x->num_owners;
+	}
+	int owners = memcmp(x->owners, y->owners, OWNER_BYTES);
+	// Entries are stored in order of first appearance
+	return owners ? owners : (x > y) - (x < y);
+}
+
+// Writes the shared tiles as one file, grouped by owner set, and where each file's copies now live
+void write_shared_layout(const struct Dedup *dedup) {
+	const struct Table *table = &dedup->tiles;
+	const struct Entry **shared = xmalloc((table->num_entries + 1) * sizeof(*shared));
+	int num_shared = 0;
+	for (int i = 0; i < table->num_entries; i++) {
+		if (table->entries[i].num_owners >= dedup->options.min_owners) {
+			shared[num_shared++] = &table->entries[i];
+		}
+	}
+	// Tiles with the most owners go first, and each cluster is one contiguous run
+	qsort(shared, num_shared, sizeof(*shared), compare_shared_entries);
+
+	int *shared_index = xmalloc((table->num_entries + 1) * sizeof(int));
+	for (int i = 0; i < table->num_entries; i++) {
+		shared_index[i] = -1;
+	}
+	uint8_t *data = xmalloc((num_shared + 1) * TILE_SIZE);
+	for (int i = 0; i < num_shared; i++) {
+		const struct Entry *entry = shared[i];
+		memcpy(&data[i * TILE_SIZE], &dedup->gfx_tiles[entry->first_owner][entry->first_index * TILE_SIZE], TILE_SIZE);
+		shared_index[entry - table->entries] = i;
+	}
+	if (dedup->options.out_filename) {
+		write_u8(dedup->options.out_filename, data, num_shared * TILE_SIZE);
+	}
+
+	if (dedup->options.layout_filename) {
+		FILE *f = xfopen(dedup->options.layout_filename, 'w');
+		fprintf(f, "; %d shared tiles\n", num_shared);
+		for (int g = 0; g < dedup->num_gfx_files; g++) {
+			fprintf(f, "\n%s:\n", dedup->gfx_files[g]);
+			for (int i = 0; i < dedup->gfx_num_tiles[g];) {
+				// Runs of tiles that map to consecutive shared tiles are printed as ranges
+				int entry = dedup->gfx_entries[g][i];
+				int first = shared_index[entry];
+				int length = 1;
+				while (first != -1 && i + length < dedup->gfx_num_tiles[g]
+					&& shared_index[dedup->gfx_entries[g][i + length]] == first + length) {
+					length++;
+				}
+				if (first == -1) {
+					i++;
+					continue;
+				}
+				if (length == 1) {
+					fprintf(f, "\ttile $%02x -> shared $%03x\n", i, first);
+				} else {
+					fprintf(f, "\ttiles $%02x-$%02x -> shared $%03x-$%03x\n", i, i + length - 1, first, first + length - 1);
+				}
+				i += length;
+			}
+		}
+		fclose(f);
+	}
+
+	free(data);
+	free(shared_index);
+	free((void *)shared);
+}
+
+int main(int argc, char *argv[]) {
+	struct Dedup dedup = {.options = {.min_owners = 2}};
+	parse_args(argc, argv, &dedup.options);
+
+	argc -= optind;
+	argv += optind;
+	if (argc) {
+		usage_exit(1);
+	}
+
+	load_map_data(&dedup.data);
+	table_init(&dedup.tiles, TILE_SIZE);
+	table_init(&dedup.metatiles, sizeof(struct MetatileKey));
+	hash_tiles(&dedup);
+	hash_metatiles(&dedup);
+
+	long saved_bytes = print_clusters(&dedup, &dedup.tiles, "tiles", TILE_SIZE, gfx_owner_name);
+	// Each metatile costs its tile IDs plus its attributes
+	saved_bytes += print_clusters(&dedup, &dedup.metatiles, "metatiles", METATILE_SIZE * 2, meta_owner_name);
+	printf("total sharable = %ld bytes (before compression)\n", saved_bytes);
+
+	if (dedup.options.out_filename || dedup.options.layout_filename) {
+		write_shared_layout(&dedup);
+	}
+
+	for (int i = 0; i < dedup.num_gfx_files; i++) {
+		free(dedup.gfx_tiles[i]);
+		free(dedup.gfx_entries[i]);
+		free(dedup.gfx_orientations[i]);
+	}
+	table_free(&dedup.tiles);
+	table_free(&dedup.metatiles);
+	return 0;
+}
@@ -0,0 +1,224 @@
+#define PROGRAM_NAME "tileset_usage"
+#define USAGE_OPTS "[-h|--help] [-j|--jobs n] [-o|--output usage.bin] [-q|--quiet]"
+
+#include "common.h"
+#include "mapdata.h"
+#include "parallel.h"
+
+struct Options {
+	int jobs;
+	const char *out_filename;
+	bool quiet;
+};
+
+void parse_args(int argc, char *argv[], struct Options *options) {
+	struct option long_options[] = {
+		{"jobs", required_argument, 0, 'j'},
+		{"output", required_argument, 0, 'o'},
+		{"quiet", no_argument, 0, 'q'},
+		{"help", no_argument, 0, 'h'},
+		{0}
+	};
+	for (int opt; (opt = getopt_long(argc, argv, "j:o:qh", long_options)) != -1;) {
+		switch (opt) {
+		case 'j':
+			options->jobs = (int)strtoul(optarg, NULL, 0);
+			break;
+		case 'o':
+			options->out_filename = optarg;
+			break;
+		case 'q':
+			options->quiet = true;
+			break;
+		case 'h':
+			usage_exit(0);
+			break;
+		default:
+			usage_exit(1);
+		}
+	}
+}
+
+struct UsageJob {
+	const struct MapData *data;
+	// One array of per-tileset usage for each thread, merged afterwards
+	struct TilesetUsage *thread_usage[MAX_THREADS];
+	struct TilesetUsage *usage;
+	int *num_blocks;
+	int *missing_blocks;
+};
+
+void mark_map_blocks(int index, int thread, void *arg) {
+	struct UsageJob *job = arg;
+	const struct Map *map = &job->data->maps[index];
+	uint8_t *blocks = job->thread_usage[thread][map->tileset].blocks;
+
+	BIT_SET(blocks, map->border_block);
+	mark_script_blocks(map->name, blocks);
+	if (map->block_data == -1) {
+		return;
+	}
+	struct MappedFile file = map_file(job->data->block_data[map->block_data].filename);
+	for (size_t i = 0; i < file.size; i++) {
+		BIT_SET(blocks, file.data[i]);
+	}
+	unmap_file(&file);
+}
+
+// Alternate block data, such as "AzaleaTownRaining", is used by the same tileset as its map
+void mark_alternate_blocks(int index, int thread, void *arg) {
+	struct UsageJob *job = arg;
+	const struct BlockData *block_data = &job->data->block_data[index];
+	if (block_data->map == -1 || job->data->maps[block_data->map].block_data == index) {
+		return;
+	}
+	int tileset = job->data->maps[block_data->map].tileset;
+	uint8_t *blocks = job->thread_usage[thread][tileset].blocks;
+	struct MappedFile file = map_file(block_data->filename);
+	for (size_t i = 0; i < file.size; i++) {
+		BIT_SET(blocks, file.data[i]);
+	}
+	unmap_file(&file);
+}
+
+void mark_tileset_tiles(int index, int thread, void *arg) {
+	(void)thread;
+	struct UsageJob *job = arg;
+	const struct Tileset *tileset = &job->data->tilesets[index];
+	struct TilesetUsage *usage = &job->usage[index];
+
+	struct MappedFile metatiles = map_file(tileset->metatiles_filename);
+	struct MappedFile attributes = map_file(tileset->attributes_filename);
+	if (metatiles.size % METATILE_SIZE || metatiles.size != attributes.size) {
+		error_exit("%s: metatiles and attributes do not match\n", tileset->name);
+	}
+	int num_blocks = (int)(metatiles.size / METATILE_SIZE);
+	job->num_blocks[index] = num_blocks;
+
+	for (int block = 0; block < MAX_BLOCKS; block++) {
+		if (!BIT_TEST(usage->blocks, block)) {
+			continue;
+		}
+		if (block >= num_blocks) {
+			job->missing_blocks[index]++;
+			continue;
+		}
+		for (int i = block * METATILE_SIZE; i < (block + 1) * METATILE_SIZE; i++) {
+			int slot = VRAM_SLOT(metatiles.data[i], attributes.data[i]);
+			BIT_SET(usage->slots, slot);
+		}
+	}
+
+	unmap_file(&metatiles);
+	unmap_file(&attributes);
+}
+
+// Prints unused IDs like find-unused-tiles.py: "00 02-05 09 0a"
+void print_unused(const char *title, const uint8_t *bits, int offset, int limit, const bool *domain) {
+	printf("\t%s =", title);
+	bool any = false;
+	for (int i = 0; i < limit;) {
+		if (BIT_TEST(bits, offset + i) || (domain && !domain[offset + i])) {
+			i++;
+			continue;
+		}
+		int first = i;
+		while (i < limit && !BIT_TEST(bits, offset + i) && (!domain || domain[offset + i])) {
+			i++;
+		}
+		int last = i - 1;
+		if (last - first < 2) {
+			for (int j = first; j <= last; j++) {
+				printf(" %02x", j);
+			}
+		} else {
+			printf(" %02x-%02x", first, last);
+		}
+		any = true;
+	}
+	puts(any ? "" : " none!");
+}
+
+void print_report(const struct MapData *data, const struct UsageJob *job) {
+	for (int t = 0; t < data->num_tilesets; t++) {
+		const struct Tileset *tileset = &data->tilesets[t];
+		const struct TilesetUsage *usage = &job->usage[t];
+		printf("tileset %s:\n", tileset->name);
+
+		printf("\tmaps =");
+		bool any = false;
+		for (int i = 0; i < data->num_maps; i++) {
+			if (data->maps[i].tileset == t) {
+				printf("%s %s", any ? "," : "", data->maps[i].name);
+				any = true;
+			}
+		}
+		puts(any ? "" : " none!");
+
+		// Only tiles that the tileset actually loads can be unused
+		bool loaded[NUM_VRAM_SLOTS] = {0};
+		for (int g = 0; g < NUM_GFX; g++) {
+			int num_tiles = count_gfx_group_tiles(&tileset->gfx[g]);
+			for (int i = 0; i < num_tiles; i++) {
+				loaded[gfx_group_slots[g] + i] = true;
+			}
+		}
+		print_unused("unused vram0 tiles", usage->slots, 0x000, 0x100, loaded);
+		print_unused("unused vram1 tiles", usage->slots, 0x100, 0x100, loaded);
+		print_unused("unused blocks", usage->blocks, 0, job->num_blocks[t], NULL);
+		if (job->missing_blocks[t]) {
+			printf("\tmissing blocks = %d\n", job->missing_blocks[t]);
+		}
+		putchar('\n');
+	}
+}
+
+int main(int argc, char *argv[]) {
+	struct Options options = {0};
+	parse_args(argc, argv, &options);
+
+	argc -= optind;
+	argv += optind;
+	if (argc) {
+		usage_exit(1);
+	}
+
+	struct MapData data;
+	load_map_data(&data);
+
+	int num_threads = parallel_num_threads(options.jobs);
+	struct UsageJob job = {
+		.data = &data,
+		.num_blocks = xcalloc(data.num_tilesets * sizeof(int)),
+		.missing_blocks = xcalloc(data.num_tilesets * sizeof(int)),
+	};
+	for (int i = 0; i < num_threads; i++) {
+		job.thread_usage[i] = xcalloc(data.num_tilesets * sizeof(struct TilesetUsage));
+	}
+	parallel_for(data.num_maps, num_threads, mark_map_blocks, &job);
+	parallel_for(data.num_block_data, num_threads, mark_alternate_blocks, &job);
+
+	job.usage = job.thread_usage[0];
+	for (int i = 1; i < num_threads; i++) {
+		for (int t = 0; t < data.num_tilesets; t++) {
+			for (int j = 0; j < MAX_BLOCKS / 8; j++) {
+				job.usage[t].blocks[j] |= job.thread_usage[i][t].blocks[j];
+			}
+		}
+		free(job.thread_usage[i]);
+	}
+	mark_field_move_blocks(&data, job.usage);
+	parallel_for(data.num_tilesets, num_threads, mark_tileset_tiles, &job);
+
+	if (options.out_filename) {
+		write_u8(options.out_filename, (uint8_t *)job.usage, data.num_tilesets * sizeof(struct TilesetUsage));
+	}
+	if (!options.quiet) {
+		print_report(&data, &job);
+	}
+
+	free(job.usage);
+	free(job.num_blocks);
+	free(job.missing_blocks);
+	return 0;
+}
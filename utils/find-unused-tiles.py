@@ -4,6 +4,8 @@
 """
 Find unused tiles and blocks.
 Usage: utils/find-unused-tiles.py > unused-tiles.txt
+
+For the native analyzer, see "make unusedtiles".
 """
 
 from __future__ import print_function
@@ -19,25 +19,24 @@ for front_name in iglob('gfx/pokemon/*/front.2bpp'):
 
 	# Get associated file names
 
-	bitmask_name = 'gfx/pokemon/%s/bitmask.asm' % mon_name
-	assert isfile(bitmask_name), 'no bitmask.asm for %s' % mon_name
+	bitmask_name = 'gfx/pokemon/%s/bitmask.bin' % mon_name
+	assert isfile(bitmask_name), 'no bitmask.bin for %s' % mon_name
 
 	frames_name = 'gfx/pokemon/%s/frames.asm' % mon_name
 	assert isfile(frames_name), 'no frames.asm for %s' % mon_name
 
-	base_name = 'data/pokemon/base_stats/%s.asm' % mon_name
-	if not isfile(base_name):
-		base_name = 'data/pokemon/base_stats/%s.asm' % mon_name.split('_', 1)[0]
-	assert isfile(base_name), 'no base data for %s' % mon_name
+	frames_bin_name = 'gfx/pokemon/%s/frames.bin' % mon_name
+	assert isfile(frames_bin_name), 'no frames.bin for %s' % mon_name
 
-	# Read dimensions from base data
+	dimensions_name = 'gfx/pokemon/%s/front.dimensions' % mon_name
+	assert isfile(dimensions_name), 'no front.dimensions for %s' % mon_name
 
-	dimensions = None
-	with open(base_name, 'r', encoding='utf8') as file:
-		for line in file:
-			if line.startswith('\tdn ') and line.endswith(' ; frontpic dimensions\n'):
-				dimensions = eval(line[len('\tdn '):-len(' ; frontpic dimensions\n')])
-	assert dimensions, 'no dimensions for %s' % mon_name
+	# Read dimensions from front.dimensions
+
+	with open(dimensions_name, 'rb') as file:
+		dimensions_bytes = file.read()
+	assert len(dimensions_bytes) == 1, 'odd front.dimensions bytes for %s: %d' % (mon_name, len(dimensions_bytes))
+	dimensions = (dimensions_bytes[0] >> 4, dimensions_bytes[0] & 0xf)
 	assert dimensions in {(5,5),(6,6),(7,7)}, 'invalid dimensions for %s: %s' % (mon_name, dimensions)
 	dimension = dimensions[0]
 
@@ -50,56 +49,39 @@ for front_name in iglob('gfx/pokemon/*/front.2bpp'):
 	tiles = chunk(tile_bytes, 16)
 	assert len(tiles) >= dimension**2, 'insufficient tiles for %s: %d < %dx%d' % (mon_name, len(tiles), dimension, dimension)
 
-	# Read bitmask bits from bitmasks.asm
+	# Read bitmask bits from bitmask.bin
 
 	bitmask_stride = dimension**2 // 8 + bool(dimension**2 % 8)
 	bitmasks = []
-	with open(bitmask_name, 'r', encoding='utf8') as file:
-		bitmask_bytes = []
-		for line in file:
-			if line.startswith('\tdb %'):
-				bitmask_bits = line[len('\tdb %'):].strip()
-				assert len(bitmask_bits) == 8, 'odd bitmask for %s: %%%s' % (mon_name, bitmask_bits)
-				assert all(c in '01' for c in bitmask_bits), 'nonbinary bitmask for %s: %%%s' % (mon_name, bitmask_bits)
-				bitmask_bytes.append(bitmask_bits)
-				if len(bitmask_bytes) == bitmask_stride:
-					whole_bits = ''.join(reversed(''.join(reversed(bitmask_bytes))))
-					used_bits, extra_bits = whole_bits[:dimension**2], whole_bits[dimension**2:]
-					assert all(b == '0' for b in extra_bits), 'out-of-range 1 bit for %s bitmask %d' % (mon_name, len(bitmasks))
-					bitmask = tuple(tuple(b == '1' for b in row) for row in zip(*chunk(used_bits, dimension)))
-					bitmasks.append(bitmask)
-					bitmask_bytes = []
-		assert not bitmask_bytes, 'leftover bitmask bytes for %s: %d' % (mon_name, len(bitmask_bytes))
-
-	# Read frames' bitmask indexes and tile offsets from frames.asm
-
-	frames = []
+	with open(bitmask_name, 'rb') as file:
+		bitmask_bytes = file.read()
+	assert len(bitmask_bytes) % bitmask_stride == 0, 'leftover bitmask bytes for %s: %d' % (mon_name, len(bitmask_bytes) % bitmask_stride)
+	for bitmask_chunk in chunk(bitmask_bytes, bitmask_stride):
+		whole_bits = ''.join('{:08b}'.format(b)[::-1] for b in bitmask_chunk)
+		used_bits, extra_bits = whole_bits[:dimension**2], whole_bits[dimension**2:]
+		assert all(b == '0' for b in extra_bits), 'out-of-range 1 bit for %s bitmask %d' % (mon_name, len(bitmasks))
+		bitmask = tuple(tuple(b == '1' for b in row) for row in zip(*chunk(used_bits, dimension)))
+		bitmasks.append(bitmask)
+
+	# Read frames' bitmask indexes and tile offsets from frames.bin,
+	# at the offsets in the frames.asm pointer table
+
+	frame_starts = []
 	with open(frames_name, 'r', encoding='utf8') as file:
-		frame_labels = []
-		context_label = None
-		bitmask_index = None
 		for line in file:
 			if line.startswith('\tdw '):
 				label = line[len('\tdw '):].strip()
-				assert label.startswith('.'), 'nonlocal frame label for %s: %s' % (mon_name, label)
-				frame_labels.append(label)
-			elif line.startswith('.'):
-				label = line.strip()
-				assert label in frame_labels, 'nonexistent frame label for %s: %s' % (mon_name, label)
-				context_label = frame_labels.index(label)
-				bitmask_index = None
-			elif line.startswith('\tdb '):
-				assert context_label is not None, 'no context for frame db for %s: %s' % (mon_name, line)
-				line = line[len('\tdb '):].split(';', 1)[0].strip()
-				values = [int(v.strip().lstrip('$'), 16) for v in line.split(',')]
-				if bitmask_index is None:
-					assert len(values) == 1, 'excess data for frame bitmask for %s' % mon_name
-					bitmask_index = values[0]
-					assert 0 <= bitmask_index < len(bitmasks), 'invalid bitmask index for %s: $%02x' % (mon_name, bitmask_index)
-					bitmask = bitmasks[bitmask_index]
-					frames.append(Frame(bitmask, []))
-				else:
-					frames[-1].offsets.extend(values)
+				assert label.startswith('.frames + '), 'unexpected frame pointer for %s: %s' % (mon_name, label)
+				frame_starts.append(int(label[len('.frames + '):]))
+	with open(frames_bin_name, 'rb') as file:
+		frame_bytes = file.read()
+
+	frames = []
+	for start, end in zip(frame_starts, frame_starts[1:] + [len(frame_bytes)]):
+		assert start < end <= len(frame_bytes), 'invalid frame offset for %s: %d' % (mon_name, start)
+		bitmask_index = frame_bytes[start]
+		assert 0 <= bitmask_index < len(bitmasks), 'invalid bitmask index for %s: $%02x' % (mon_name, bitmask_index)
+		frames.append(Frame(bitmasks[bitmask_index], list(frame_bytes[start+1:end])))
 
 	# Verify frames' bitmasks against their tile offsets
 